@@ -0,0 +1,315 @@
+// Concurrent solves of a batch of scenarios in one process (target 'hiop_batch_solves')
+//
+// Each scenario is an instance of the MDS problem of nlpMDS_ex4 with n_sp+4*k sparse and n_de+k
+// dense variables (k is the index of the scenario). The scenarios are solved by a small pool of
+// worker threads, each worker repeatedly taking the next unsolved scenario and creating, solving,
+// and destroying its own NLP formulation and solver. The solvers do not share any state:
+//  - the options are set programmatically and no options file is read;
+//  - each solver logs to its own file (in the directory given by '-log_dir', or to a temporary
+//    file that is written on screen only if the solve fails); with '-log_dir', each solver also
+//    writes its iterations trace to its own file (option 'trace_iter_file');
+//  - in MPI builds, each scenario has its own duplicate of MPI_COMM_SELF, since collectives on
+//    the same communicator cannot be issued concurrently by different threads.
+// With '-selfcheck', each scenario is also solved on the main thread after the batch, and the
+// driver returns a nonzero exit code if the objectives or the iteration counts differ.
+
+#include "nlpMDSForm_ex4.hpp"
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+#include "hiopTimer.hpp"
+
+#ifdef HIOP_USE_MAGMA
+#include "magma_v2.h"
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace hiop;
+
+/* Ex4 with a communicator owned by the scenario */
+class Ex4Scenario : public Ex4
+{
+public:
+  Ex4Scenario(int ns_, int nd_, MPI_Comm comm)
+    : Ex4(ns_, nd_), comm_(comm)
+  {
+  }
+  virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=comm_; return true; }
+private:
+  MPI_Comm comm_;
+};
+
+struct Scenario
+{
+  int id;
+  long long n_sp, n_de;
+  MPI_Comm comm;
+  //results
+  int status, iters, worker;
+  double objective;
+  double tm;
+};
+
+struct BatchSettings
+{
+  int num_scenarios;
+  int num_threads;
+  int omp_threads;
+  long long n_sp, n_de;
+  int verbosity;
+  std::string log_dir;
+};
+
+/* Creates, solves, and destroys the NLP and the solver of the scenario 's' on the calling thread;
+ * the output of the solver goes to 'log_file'
+ */
+static void solve_scenario(Scenario& s, const BatchSettings& settings, FILE* log_file)
+{
+  hiopTimer t;
+  t.start();
+
+  Ex4Scenario problem((int)s.n_sp, (int)s.n_de, s.comm);
+  {
+    //no options file: concurrent solvers would all read the same 'hiop.options'
+    hiopNlpMDS nlp(problem, "");
+    nlp.log->set_output_file(log_file);
+
+    nlp.options->SetStringValue("dualsUpdateType", "linear");
+    nlp.options->SetStringValue("dualsInitialization", "zero");
+    nlp.options->SetStringValue("Hessian", "analytical_exact");
+    nlp.options->SetStringValue("KKTLinsys", "xdycyd");
+    nlp.options->SetStringValue("compute_mode", "hybrid");
+    nlp.options->SetIntegerValue("verbosity_level", settings.verbosity);
+    nlp.options->SetNumericValue("mu0", 1e-1);
+    nlp.options->SetNumericValue("tolerance", 1e-5);
+    if(!settings.log_dir.empty()) {
+      std::string trace_file = settings.log_dir + "/scenario_" + std::to_string(s.id) + "_trace";
+      nlp.options->SetStringValue("trace_iter", "csv");
+      nlp.options->SetStringValue("trace_iter_file", trace_file.c_str());
+    }
+
+    hiopAlgFilterIPMNewton solver(&nlp);
+    s.status = solver.run();
+    s.objective = solver.getObjective();
+    s.iters = solver.getNumIterations();
+    nlp.log->flush();
+  }
+  t.stop();
+  s.tm = t.getElapsedTime();
+}
+
+/* Opens the log file of the scenario 'id': in 'log_dir' if not empty, otherwise a temporary file */
+static FILE* open_log(const BatchSettings& settings, int id)
+{
+  if(settings.log_dir.empty()) return tmpfile();
+  std::string name = settings.log_dir + "/scenario_" + std::to_string(id) + ".log";
+  return fopen(name.c_str(), "w+");
+}
+
+/* Writes on screen the log of a failed scenario */
+static void dump_log(FILE* f, int id)
+{
+  printf("---- log of scenario %d ----\n", id);
+  rewind(f);
+  char buf[4096];
+  size_t len;
+  while((len=fread(buf, 1, sizeof(buf), f))>0) fwrite(buf, 1, len, stdout);
+  printf("---- end of log of scenario %d ----\n", id);
+}
+
+/* Solves all the scenarios on 'settings.num_threads' worker threads; returns the wall time */
+static double solve_batch(std::vector<Scenario>& scenarios, const BatchSettings& settings)
+{
+  std::atomic<int> next(0);
+  auto worker = [&](int w)
+  {
+#ifdef _OPENMP
+    //the OpenMP threads of the worker; the default would oversubscribe the cores
+    omp_set_num_threads(settings.omp_threads);
+#endif
+    int k;
+    while((k=next++) < (int)scenarios.size()) {
+      Scenario& s = scenarios[k];
+      s.worker = w;
+      FILE* log_file = open_log(settings, s.id);
+      if(NULL==log_file) {
+	s.status = UnknownNLPSolveStatus;
+	continue;
+      }
+      solve_scenario(s, settings, log_file);
+      if(s.status<0) dump_log(log_file, s.id);
+      fclose(log_file);
+    }
+  };
+
+  hiopTimer t;
+  t.start();
+  std::vector<std::thread> workers;
+  for(int w=0; w<settings.num_threads; w++) workers.push_back(std::thread(worker, w));
+  for(std::thread& th : workers) th.join();
+  t.stop();
+  return t.getElapsedTime();
+}
+
+static void usage(const char* exe)
+{
+  printf("HiOp driver %s that solves a batch of scenarios (instances of the MDS problem of "
+	 "nlpMDS_ex4) concurrently on a pool of threads.\n", exe);
+  printf("Usage: \n");
+  printf("  '$ %s [-scenarios N] [-threads T] [-omp_threads P] [-n_sp S] [-n_de D] "
+	 "[-verbosity V] [-log_dir DIR] [-selfcheck]'\n", exe);
+  printf("  '-scenarios': number of scenarios [default 8]\n");
+  printf("  '-threads': number of worker threads [default: number of cores, at most N]\n");
+  printf("  '-omp_threads': OpenMP threads of each worker [default 1]\n");
+  printf("  '-n_sp', '-n_de': sizes of the first scenario; scenario k has n_sp+4*k sparse and "
+	 "n_de+k dense variables [default 400 and 100]\n");
+  printf("  '-verbosity': HiOp's 'verbosity_level' of each solve [default 3]\n");
+  printf("  '-log_dir': directory of the logs and of the iterations traces (CSV) of the solves, "
+	 "one of each per scenario [default: the logs are written on screen only for the failed "
+	 "solves and no traces are written]\n");
+  printf("  '-selfcheck': also solves each scenario on the main thread and checks that the "
+	 "results match those of the concurrent solves\n");
+}
+
+int main(int argc, char** argv)
+{
+  BatchSettings settings;
+  settings.num_scenarios = 8;
+  settings.num_threads = -1;
+  settings.omp_threads = 1;
+  settings.n_sp = 400;
+  settings.n_de = 100;
+  settings.verbosity = 3;
+  bool self_check = false;
+  for(int i=1; i<argc; i++) {
+    if(0==strcmp(argv[i], "-scenarios") && i+1<argc) settings.num_scenarios = atoi(argv[++i]);
+    else if(0==strcmp(argv[i], "-threads") && i+1<argc) settings.num_threads = atoi(argv[++i]);
+    else if(0==strcmp(argv[i], "-omp_threads") && i+1<argc) settings.omp_threads = atoi(argv[++i]);
+    else if(0==strcmp(argv[i], "-n_sp") && i+1<argc) settings.n_sp = atoll(argv[++i]);
+    else if(0==strcmp(argv[i], "-n_de") && i+1<argc) settings.n_de = atoll(argv[++i]);
+    else if(0==strcmp(argv[i], "-verbosity") && i+1<argc) settings.verbosity = atoi(argv[++i]);
+    else if(0==strcmp(argv[i], "-log_dir") && i+1<argc) settings.log_dir = argv[++i];
+    else if(0==strcmp(argv[i], "-selfcheck")) self_check = true;
+    else {
+      usage(argv[0]);
+      return strcmp(argv[i], "-help") ? 1 : 0;
+    }
+  }
+  if(settings.num_scenarios<1 || settings.omp_threads<1 || settings.n_sp<4 || settings.n_de<1) {
+    usage(argv[0]);
+    return 1;
+  }
+  if(settings.num_threads<1) {
+    settings.num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+  }
+  settings.num_threads = std::min(settings.num_threads, settings.num_scenarios);
+
+#ifdef HIOP_USE_MPI
+  //the solves issue MPI calls (on their own communicators) from the worker threads
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr); (void)ierr;
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+  if(provided < MPI_THREAD_MULTIPLE && settings.num_threads>1) {
+    printf("[warning] MPI does not support MPI_THREAD_MULTIPLE; the scenarios will be solved "
+	   "on one thread\n");
+    settings.num_threads = 1;
+  }
+#endif
+
+#ifdef HIOP_USE_MAGMA
+  magma_init();
+#endif
+
+  std::vector<Scenario> scenarios(settings.num_scenarios);
+  for(int k=0; k<settings.num_scenarios; k++) {
+    Scenario& s = scenarios[k];
+    s.id = k;
+    s.n_sp = settings.n_sp + 4*k;
+    s.n_de = settings.n_de + k;
+    s.status = UnknownNLPSolveStatus;
+    s.iters = 0;
+    s.worker = -1;
+    s.objective = 0.;
+    s.tm = 0.;
+#ifdef HIOP_USE_MPI
+    //created on the main thread since MPI_Comm_dup is collective
+    ierr = MPI_Comm_dup(MPI_COMM_SELF, &s.comm); assert(MPI_SUCCESS==ierr);
+#else
+    s.comm = MPI_COMM_SELF;
+#endif
+  }
+
+  printf("Solving %d scenarios on %d threads (%d OpenMP threads each)\n",
+	 settings.num_scenarios, settings.num_threads, settings.omp_threads);
+  const double tm_batch = solve_batch(scenarios, settings);
+
+  printf("%8s %8s %8s %7s %7s %6s %22s %10s\n",
+	 "scenario", "n_sp", "n_de", "worker", "status", "iters", "objective", "time");
+  double tm_solves = 0.;
+  int num_failed = 0;
+  for(const Scenario& s : scenarios) {
+    printf("%8d %8lld %8lld %7d %7d %6d %22.14e %10.3f\n",
+	   s.id, s.n_sp, s.n_de, s.worker, s.status, s.iters, s.objective, s.tm);
+    tm_solves += s.tm;
+    if(s.status<0) num_failed++;
+  }
+  printf("Batch solved in %.3f sec; the solves took %.3f sec in total (%.2fx)\n",
+	 tm_batch, tm_solves, tm_batch>0 ? tm_solves/tm_batch : 0.);
+
+  int ret = num_failed>0 ? 1 : 0;
+  if(num_failed>0) printf("[error] %d scenarios failed\n", num_failed);
+
+  if(self_check) {
+    //the concurrent solves must give the results of the solves done one at a time
+#ifdef _OPENMP
+    omp_set_num_threads(settings.omp_threads);
+#endif
+    for(const Scenario& s : scenarios) {
+      Scenario ref = s;
+      FILE* log_file = tmpfile();
+      if(NULL==log_file) {
+	printf("[error] could not create the log of scenario %d\n", s.id);
+	ret = 1;
+	continue;
+      }
+      solve_scenario(ref, settings, log_file);
+      fclose(log_file);
+      if(ref.status!=s.status || ref.iters!=s.iters ||
+	 fabs(ref.objective-s.objective) > 1e-10*(1.+fabs(ref.objective))) {
+	printf("[error] scenario %d: concurrent solve (status %d, %d iterations, objective "
+	       "%.14e) does not match the serial solve (status %d, %d iterations, objective %.14e)\n",
+	       s.id, s.status, s.iters, s.objective, ref.status, ref.iters, ref.objective);
+	ret = 1;
+      }
+    }
+    if(0==ret) printf("Self-check passed: the concurrent solves match the serial solves\n");
+  }
+
+#ifdef HIOP_USE_MPI
+  for(Scenario& s : scenarios) MPI_Comm_free(&s.comm);
+  MPI_Finalize();
+#endif
+  return ret;
+}
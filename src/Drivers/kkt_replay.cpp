@@ -0,0 +1,238 @@
+// Offline replay of captured KKT linear systems (target 'hiop_kkt_replay')
+//
+// Reads the systems written by a HiOp run with the option 'write_kkt binary' (see
+// hiopKKTCapture.hpp) and factorizes and solves each of them with a dense indefinite linear
+// solver selected by name. For each system, the driver reports the time of the factorization,
+// the inertia computed by the solver next to the one obtained during the capture run, the time
+// of the solves, the relative residual of the solutions, and the relative difference from the
+// solutions computed during the capture run.
+//
+// Usage: hiop_kkt_replay [-solver name] [-storage full|packed] [-reps r] [file.hkkt]
+
+#include "nlpDenseCons_ex1.hpp"
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopKKTCapture.hpp"
+#include "hiopLinSolverIndefDenseLapack.hpp"
+#include "hiopTimer.hpp"
+
+#ifdef HIOP_USE_MAGMA
+#include "hiopLinSolverIndefDenseMagma.hpp"
+#include "magma_v2.h"
+#endif
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace hiop;
+
+/* Creates the dense indefinite linear solver named 'name' for systems of size 'n' */
+static hiopLinSolverIndefDense* create_linsolver(const std::string& name, int n,
+						 hiopNlpFormulation* nlp)
+{
+  if(name=="lapack") return new hiopLinSolverIndefDenseLapack(n, nlp);
+#ifdef HIOP_USE_MAGMA
+  if(name=="magma_buka") return new hiopLinSolverIndefDenseMagmaBuKa(n, nlp);
+  if(name=="magma_nopiv") return new hiopLinSolverIndefDenseMagmaNopiv(n, nlp);
+#endif
+  return NULL;
+}
+
+static const char* registered_linsolvers()
+{
+#ifdef HIOP_USE_MAGMA
+  return "lapack, magma_buka, magma_nopiv";
+#else
+  return "lapack";
+#endif
+}
+
+static double norm_inf(const double* x, long long n)
+{
+  double nrm = 0.;
+  for(long long i=0; i<n; i++) nrm = std::max(nrm, fabs(x[i]));
+  return nrm;
+}
+
+static void usage(const char* exe)
+{
+  printf("Usage: %s [-solver name] [-storage full|packed] [-reps r] [-check tol] [file.hkkt]\n",
+	 exe);
+  printf("  -solver  dense linear solver used for the replay: %s (default lapack)\n",
+	 registered_linsolvers());
+  printf("  -storage storage of the system matrix for the lapack solver, see the option "
+	 "'kkt_dense_storage' (default full)\n");
+  printf("  -reps    number of factorizations and solves of each system; the minimum time is "
+	 "reported (default 1)\n");
+  printf("  -check   exit with an error if a system has an inertia different from the capture "
+	 "run, a failed solve, or a relative residual over 'tol' [optional]\n");
+  printf("  file     file written with the option 'write_kkt binary' (default kkt_capture.hkkt)\n");
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr); (void)ierr;
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+#ifdef HIOP_USE_MAGMA
+  magma_init();
+#endif
+
+  std::string solver_name("lapack"), filename("kkt_capture.hkkt"), storage("full");
+  int reps = 1;
+  double check_tol = -1.;
+
+  bool args_ok = true;
+  for(int i=1; i<argc && args_ok; i++) {
+    if(0==strcmp(argv[i], "-solver") && i+1<argc) solver_name = argv[++i];
+    else if(0==strcmp(argv[i], "-storage") && i+1<argc) storage = argv[++i];
+    else if(0==strcmp(argv[i], "-reps") && i+1<argc) reps = std::max(1, atoi(argv[++i]));
+    else if(0==strcmp(argv[i], "-check") && i+1<argc) check_tol = atof(argv[++i]);
+    else if(argv[i][0]!='-') filename = argv[i];
+    else args_ok = false;
+  }
+
+  //the linear solvers need a NLP formulation for the options, the logger, and the run statistics
+  Ex1Interface dummy_interface(10, 1.0);
+  hiopNlpDenseConstraints nlp(dummy_interface);
+  nlp.options->SetIntegerValue("verbosity_level", 1);
+  if(storage!="full" && storage!="packed") args_ok = false;
+  else nlp.options->SetStringValue("kkt_dense_storage", storage.c_str());
+
+  hiopLinSolverIndefDense* test_solver = args_ok ? create_linsolver(solver_name, 1, &nlp) : NULL;
+  if(NULL==test_solver) {
+    if(args_ok) printf("unknown linear solver '%s'\n", solver_name.c_str());
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+  const bool packed = test_solver->packed_storage();
+  delete test_solver;
+
+  hiopKKTCaptureReader reader;
+  if(!reader.open(filename.c_str())) {
+    printf("could not open '%s' or it is not a KKT capture file\n", filename.c_str());
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  printf("replaying '%s' with the '%s' linear solver (%s storage)\n", filename.c_str(),
+	 solver_name.c_str(), packed ? "packed" : "full");
+  printf("%5s %5s %7s %10s %10s %6s %6s %6s %5s %11s %11s %10s %10s\n", "sys", "iter", "m",
+	 "delta_wx", "delta_cc", "neg", "capt", "expct", "nrhs", "t_fact", "t_solve",
+	 "max_resid", "max_diff");
+
+  hiopKKTCapturedSystem sys;
+  hiopLinSolverIndefDense* linsolver = NULL;
+  long long linsolver_size = -1;
+  int n_sys = 0, n_inertia_mismatch = 0, n_failed_solves = 0;
+  double t_fact_total = 0., t_solve_total = 0., max_resid_total = 0.;
+
+  while(reader.read_next(sys)) {
+    if(sys.m != linsolver_size) {
+      delete linsolver;
+      linsolver = create_linsolver(solver_name, (int)sys.m, &nlp);
+      linsolver_size = sys.m;
+    }
+    const long long m = sys.m;
+    hiopMatrixDense& Msys = linsolver->sysMatrix();
+    hiopVector* x = LinearAlgebraFactory::createVector(m);
+    std::vector<double> Mx(m);
+
+    double t_fact = 1e+20, t_solve = 1e+20, max_resid = 0., max_diff = 0.;
+    int n_neg_eig = -1;
+    for(int r=0; r<reps; r++) {
+      //the factorization is done in place, so the matrix is copied in at each repetition
+      sys.copy_to(Msys);
+      hiopTimer tm;
+      tm.start();
+      n_neg_eig = linsolver->matrixChanged();
+      tm.stop();
+      t_fact = std::min(t_fact, tm.getElapsedTime());
+
+      tm.reset();
+      for(size_t k=0; k<sys.rhs.size() && n_neg_eig>=0; k++) {
+	memcpy(x->local_data(), sys.rhs[k].data(), m*sizeof(double));
+	tm.start();
+	bool sol_ok = linsolver->solve(*x);
+	tm.stop();
+	if(r>0) continue;
+	if(!sol_ok) {
+	  n_failed_solves++;
+	  continue;
+	}
+
+	//relative residual ||M*x-rhs||/(||M||*||x||+||rhs||), with ||M|| estimated by the max entry
+	const double* xarr = x->local_data_const();
+	sys.times_vec(xarr, Mx.data());
+	for(long long i=0; i<m; i++) Mx[i] -= sys.rhs[k][i];
+	const double nrmM = norm_inf(sys.upper.data(), (long long)sys.upper.size());
+	const double denom = nrmM*norm_inf(xarr, m) + norm_inf(sys.rhs[k].data(), m);
+	max_resid = std::max(max_resid, norm_inf(Mx.data(), m)/std::max(denom, 1e-300));
+
+	if(k<sys.sol.size()) {
+	  double diff = 0.;
+	  for(long long i=0; i<m; i++) diff = std::max(diff, fabs(xarr[i]-sys.sol[k][i]));
+	  max_diff = std::max(max_diff, diff/std::max(norm_inf(sys.sol[k].data(), m), 1e-300));
+	}
+      }
+      if(!sys.rhs.empty()) t_solve = std::min(t_solve, tm.getElapsedTime());
+    }
+    if(sys.rhs.empty() || n_neg_eig<0) t_solve = 0.;
+    delete x;
+
+    if(n_neg_eig != sys.n_neg_eig) n_inertia_mismatch++;
+    t_fact_total += t_fact;
+    t_solve_total += t_solve;
+    max_resid_total = std::max(max_resid_total, max_resid);
+
+    printf("%5d %5d %7lld %10.3e %10.3e %6d %6d %6d %5d %11.4e %11.4e %10.3e %10.3e%s\n", n_sys,
+	   sys.iter, m, sys.delta_wx, sys.delta_cc, n_neg_eig, sys.n_neg_eig,
+	   sys.n_neg_eig_expected, (int)sys.rhs.size(), t_fact, t_solve, max_resid, max_diff,
+	   n_neg_eig != sys.n_neg_eig ? " inertia differs" : "");
+    n_sys++;
+  }
+  delete linsolver;
+
+  printf("%d system(s) replayed: total factorization time %.4e sec, total solve time %.4e sec\n",
+	 n_sys, t_fact_total, t_solve_total);
+  printf("%d system(s) with inertia different from the capture run, %d failed solve(s)\n",
+	 n_inertia_mismatch, n_failed_solves);
+  const bool corrupted = reader.corrupted();
+  if(corrupted) printf("[warning] '%s' is truncated or corrupted after %d system(s)\n",
+		       filename.c_str(), n_sys);
+  bool check_failed = false;
+  if(check_tol>=0.) {
+    check_failed = 0==n_sys || n_inertia_mismatch>0 || n_failed_solves>0 ||
+      max_resid_total>check_tol;
+    printf("check %s: max relative residual %.3e (tolerance %.3e)\n",
+	   check_failed ? "failed" : "passed", max_resid_total, check_tol);
+  }
+
+#ifdef HIOP_USE_MAGMA
+  magma_finalize();
+#endif
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return (corrupted || check_failed) ? 1 : 0;
+}
@@ -0,0 +1,363 @@
+// Microbenchmarks for the HiOp linear algebra kernels (target 'hiop_bench')
+//
+// Times hiopVectorPar operations, hiopMatrixDenseRowMajor products and symmetric upper-triangle
+// updates, and the hiopMatrixSparseTriplet/hiopMatrixSymSparseTriplet kernels used in the MDS
+// KKT linear systems, over a sweep of problem sizes and (OpenMP) thread counts. The results are
+// printed on screen and written in JSON format.
+//
+// For a size 'n' the operands are
+//  - vectors of length n
+//  - dense d x d matrices, with d = sqrt(n), so that a dense matrix has about n entries
+//  - a sparse d x n matrix with about n nonzeros for the matrix-vector products
+//  - sparse d x n and 2d x n matrices with 16 nonzeros per row and a diagonal scaling of length n
+//    for the M*D^{-1}*N^T updates of the dense symmetric matrices (as in the MDS KKT systems)
+//  - sparse d x d general and symmetric (upper triangular) matrices with about n/8 nonzeros for the
+//    other updates of the dense symmetric matrices.
+
+#include "hiop_defs.hpp"
+
+#include "hiopVectorPar.hpp"
+#include "hiopMatrixDenseRowMajor.hpp"
+#include "hiopMatrixSparseTriplet.hpp"
+
+#ifdef HIOP_USE_MPI
+#include "mpi.h"
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <cmath>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+using namespace hiop;
+
+struct BenchKernel
+{
+  std::string name;
+  std::function<void()> run;
+  double flops; //estimated floating-point operations per call
+  double bytes; //estimated memory traffic per call
+};
+
+struct BenchResult
+{
+  std::string name;
+  long long size;
+  int threads;
+  long long reps;
+  double t_min, t_median, t_mean;
+  double flops, bytes;
+};
+
+/* Fills a sparse triplet matrix with 'nnz_per_row' nonzeros per row, with ordered (row, col)
+ * indexes. When 'upper' is true, only entries with col>=row are generated (symmetric matrices).
+ */
+static void fill_triplet(hiopMatrixSparseTriplet& A, int nnz_per_row, bool upper)
+{
+  int* irow = A.i_row();
+  int* jcol = A.j_col();
+  double* vals = A.M();
+  const int m = A.m(), n = A.n();
+  long long it = 0;
+  for(int i=0; i<m; i++) {
+    const int col_start = upper ? i : 0;
+    const int ncols = n - col_start;
+    const int nnz_row = std::min(nnz_per_row, ncols);
+    const int stride = std::max(1, ncols/std::max(1, nnz_row));
+    for(int k=0; k<nnz_row; k++) {
+      irow[it] = i;
+      jcol[it] = col_start + k*stride + (upper ? 0 : i%stride);
+      vals[it] = 1. + 1e-3*((i+k)%7);
+      it++;
+    }
+  }
+  assert(it==A.numberOfNonzeros());
+}
+
+static long long nnz_triplet(int m, int n, int nnz_per_row, bool upper)
+{
+  long long nnz = 0;
+  for(int i=0; i<m; i++) nnz += std::min(nnz_per_row, upper ? n-i : n);
+  return nnz;
+}
+
+static void fill_vector(hiopVectorPar& v, double base)
+{
+  double* data = v.local_data();
+  const long long n = v.get_local_size();
+  for(long long i=0; i<n; i++) data[i] = base + 1e-3*(i%11);
+}
+
+static void fill_dense(hiopMatrixDense& A, double base)
+{
+  double** M = A.get_M();
+  for(int i=0; i<A.m(); i++)
+    for(int j=0; j<A.n(); j++)
+      M[i][j] = base + 1e-3*((i+j)%13);
+}
+
+/* Vector kernels; all the operands have length n */
+static void vector_kernels(long long n, std::vector<BenchKernel>& kernels)
+{
+  std::shared_ptr<hiopVectorPar> x(new hiopVectorPar(n)), y(new hiopVectorPar(n)),
+    z(new hiopVectorPar(n)), ones(new hiopVectorPar(n));
+  fill_vector(*x, 1.); fill_vector(*y, 2.); fill_vector(*z, 1.);
+  ones->setToConstant(1.);
+  const double dn = (double)n, db = 8.*n;
+  //results of the reductions are stored so that the calls are not optimized away
+  std::shared_ptr<double> sink(new double(0.));
+
+  kernels.push_back({"vec.setToConstant", [=]{ y->setToConstant(2.); }, 0., db});
+  kernels.push_back({"vec.copyFrom", [=]{ y->copyFrom(*x); }, 0., 2*db});
+  kernels.push_back({"vec.scale", [=]{ y->scale(1.-1e-12); }, dn, 2*db});
+  kernels.push_back({"vec.axpy", [=]{ y->axpy(1e-8, *x); }, 2*dn, 3*db});
+  kernels.push_back({"vec.axzpy", [=]{ y->axzpy(1e-8, *x, *z); }, 3*dn, 4*db});
+  kernels.push_back({"vec.axdzpy", [=]{ y->axdzpy(1e-8, *x, *z); }, 3*dn, 4*db});
+  kernels.push_back({"vec.componentMult", [=]{ y->componentMult(*ones); }, dn, 3*db});
+  kernels.push_back({"vec.componentDiv", [=]{ y->componentDiv(*ones); }, dn, 3*db});
+  kernels.push_back({"vec.dotProductWith", [=]{ *sink = y->dotProductWith(*x); }, 2*dn, 2*db});
+  kernels.push_back({"vec.twonorm", [=]{ *sink = y->twonorm(); }, 2*dn, db});
+  kernels.push_back({"vec.infnorm", [=]{ *sink = y->infnorm(); }, dn, db});
+  kernels.push_back({"vec.onenorm", [=]{ *sink = y->onenorm(); }, dn, db});
+  kernels.push_back({"vec.logBarrier_local", [=]{ *sink = x->logBarrier_local(*ones); }, 2*dn, 2*db});
+  kernels.push_back({"vec.addLogBarrierGrad", [=]{ y->addLogBarrierGrad(1e-8, *x, *ones); }, 3*dn, 4*db});
+  kernels.push_back({"vec.fractionToTheBdry_local",
+	[=]{ *sink = x->fractionToTheBdry_local(*z, 0.99); }, 3*dn, 2*db});
+}
+
+/* Dense kernels on d x d matrices */
+static void dense_kernels(long long n, std::vector<BenchKernel>& kernels)
+{
+  const int d = std::max(2, (int)std::sqrt((double)n));
+  std::shared_ptr<hiopMatrixDenseRowMajor> A(new hiopMatrixDenseRowMajor(d, d)),
+    X(new hiopMatrixDenseRowMajor(d, d)), W(new hiopMatrixDenseRowMajor(d, d)),
+    W2(new hiopMatrixDenseRowMajor(2*d, 2*d));
+  std::shared_ptr<hiopVectorPar> x(new hiopVectorPar(d)), y(new hiopVectorPar(d));
+  fill_dense(*A, 1.); fill_dense(*X, 1e-2);
+  fill_vector(*x, 1.); fill_vector(*y, 1.);
+  const double dd = (double)d*d, d3 = (double)d*d*d;
+
+  kernels.push_back({"dense.timesVec", [=]{ A->timesVec(0., *y, 1., *x); }, 2*dd, 8*dd});
+  kernels.push_back({"dense.transTimesVec", [=]{ A->transTimesVec(0., *y, 1., *x); }, 2*dd, 8*dd});
+  kernels.push_back({"dense.timesMat", [=]{ A->timesMat(0., *W, 1., *X); }, 2*d3, 24*dd});
+  kernels.push_back({"dense.transTimesMat", [=]{ A->transTimesMat(0., *W, 1., *X); }, 2*d3, 24*dd});
+  kernels.push_back({"dense.timesMatTrans", [=]{ A->timesMatTrans(0., *W, 1., *X); }, 2*d3, 24*dd});
+  kernels.push_back({"dense.addMatrix", [=]{ W->addMatrix(1e-8, *A); }, 2*dd, 24*dd});
+  kernels.push_back({"dense.addToSymDenseMatrixUpperTriangle",
+	[=]{ A->addToSymDenseMatrixUpperTriangle(0, d, 1e-8, *W2); }, 2*dd, 24*dd});
+  kernels.push_back({"dense.transAddToSymDenseMatrixUpperTriangle",
+	[=]{ A->transAddToSymDenseMatrixUpperTriangle(0, d, 1e-8, *W2); }, 2*dd, 24*dd});
+  kernels.push_back({"dense.addUpperTriangleToSymDenseMatrixUpperTriangle",
+	[=]{ A->addUpperTriangleToSymDenseMatrixUpperTriangle(d, 1e-8, *W2); }, dd, 12*dd});
+}
+
+/* Sparse triplet kernels; see the top of the file for the operands */
+static void sparse_kernels(long long n, std::vector<BenchKernel>& kernels)
+{
+  const int d = std::max(2, (int)std::sqrt((double)n));
+  const int ncols = (int)std::max(n, (long long)d);
+  const int nnz_row = std::max(1, ncols/d);
+  const int nnz_row_sq = std::max(1, d/8);
+  const int nnz_row_jac = 16;
+
+  std::shared_ptr<hiopMatrixSparseTriplet>
+    A(new hiopMatrixSparseTriplet(d, ncols, nnz_triplet(d, ncols, nnz_row, false))),
+    J(new hiopMatrixSparseTriplet(d, ncols, nnz_triplet(d, ncols, nnz_row_jac, false))),
+    N(new hiopMatrixSparseTriplet(2*d, ncols, nnz_triplet(2*d, ncols, nnz_row_jac, false))),
+    B(new hiopMatrixSparseTriplet(d, d, nnz_triplet(d, d, nnz_row_sq, false)));
+  std::shared_ptr<hiopMatrixSymSparseTriplet>
+    S(new hiopMatrixSymSparseTriplet(d, nnz_triplet(d, d, nnz_row_sq, true)));
+  fill_triplet(*A, nnz_row, false);
+  fill_triplet(*J, nnz_row_jac, false);
+  fill_triplet(*N, nnz_row_jac, false);
+  fill_triplet(*B, nnz_row_sq, false);
+  fill_triplet(*S, nnz_row_sq, true);
+
+  std::shared_ptr<hiopMatrixDenseRowMajor> W(new hiopMatrixDenseRowMajor(3*d, 3*d));
+  std::shared_ptr<hiopVectorPar> xn(new hiopVectorPar(ncols)), yd(new hiopVectorPar(d)),
+    xd(new hiopVectorPar(d)), D(new hiopVectorPar(ncols));
+  fill_vector(*xn, 1.); fill_vector(*yd, 1.); fill_vector(*xd, 1.); fill_vector(*D, 2.);
+
+  const double nzA = A->numberOfNonzeros(), nzB = B->numberOfNonzeros(), nzS = S->numberOfNonzeros();
+  //each pair of rows of M (and N) is merged in the products M*D^{-1}*M^T and M*D^{-1}*N^T
+  const double mdm = 0.5*d*(d+1.)*2.*nnz_row_jac, mdn = (double)d*2*d*2.*nnz_row_jac;
+
+  kernels.push_back({"sparse.timesVec", [=]{ A->timesVec(0., *yd, 1., *xn); }, 2*nzA, 16*nzA});
+  kernels.push_back({"sparse.transTimesVec", [=]{ A->transTimesVec(0., *xn, 1., *yd); }, 2*nzA, 16*nzA});
+  kernels.push_back({"sparse.addToSymDenseMatrixUpperTriangle",
+	[=]{ B->addToSymDenseMatrixUpperTriangle(0, d, 1e-8, *W); }, 2*nzB, 28*nzB});
+  kernels.push_back({"sparse.transAddToSymDenseMatrixUpperTriangle",
+	[=]{ B->transAddToSymDenseMatrixUpperTriangle(0, d, 1e-8, *W); }, 2*nzB, 28*nzB});
+  kernels.push_back({"sparse.addMDinvMtransToDiagBlockOfSymDeMatUTri",
+	[=]{ J->addMDinvMtransToDiagBlockOfSymDeMatUTri(0, 1e-8, *D, *W); }, 2*mdm, 16*mdm});
+  kernels.push_back({"sparse.addMDinvNtransToSymDeMatUTri",
+	[=]{ J->addMDinvNtransToSymDeMatUTri(0, d, 1e-8, *D, *N, *W); }, 2*mdn, 16*mdn});
+  kernels.push_back({"sparse_sym.timesVec", [=]{ S->timesVec(0., *yd, 1., *xd); }, 4*nzS, 32*nzS});
+  kernels.push_back({"sparse_sym.addUpperTriangleToSymDenseMatrixUpperTriangle",
+	[=]{ S->addUpperTriangleToSymDenseMatrixUpperTriangle(d, 1e-8, *W); }, 2*nzS, 28*nzS});
+}
+
+/* Runs 'k' once as warm-up and then repeatedly for at least 'min_time' seconds and 'min_reps'
+ * repetitions. Each call is timed separately.
+ */
+static BenchResult time_kernel(const BenchKernel& k, long long size, int threads,
+			       double min_time, long long min_reps)
+{
+  typedef std::chrono::steady_clock clock;
+  k.run();
+
+  std::vector<double> times;
+  double total = 0.;
+  while(total<min_time || (long long)times.size()<min_reps) {
+    clock::time_point start = clock::now();
+    k.run();
+    const double t = std::chrono::duration<double>(clock::now()-start).count();
+    times.push_back(t);
+    total += t;
+    if(times.size()>=10000000) break;
+  }
+  std::sort(times.begin(), times.end());
+
+  BenchResult r;
+  r.name = k.name; r.size = size; r.threads = threads; r.reps = times.size();
+  r.t_min = times.front();
+  r.t_median = times[times.size()/2];
+  r.t_mean = total/times.size();
+  r.flops = k.flops; r.bytes = k.bytes;
+  return r;
+}
+
+static bool write_json(const char* filename, const std::vector<BenchResult>& results,
+		       double min_time)
+{
+  FILE* f = fopen(filename, "w");
+  if(NULL==f) return false;
+  fprintf(f, "{\n  \"benchmark\": \"hiop_bench\",\n");
+#ifdef HIOP_DEEPCHECKS
+  fprintf(f, "  \"deepchecks\": true,\n");
+#else
+  fprintf(f, "  \"deepchecks\": false,\n");
+#endif
+  fprintf(f, "  \"min_time\": %.6e,\n  \"results\": [", min_time);
+  for(size_t i=0; i<results.size(); i++) {
+    const BenchResult& r = results[i];
+    fprintf(f, "%s\n    {\"kernel\": \"%s\", \"size\": %lld, \"threads\": %d, \"reps\": %lld, "
+	    "\"t_min\": %.6e, \"t_median\": %.6e, \"t_mean\": %.6e, \"flops\": %.6e, \"bytes\": %.6e, "
+	    "\"gflops\": %.6e, \"gbytes_per_sec\": %.6e}",
+	    i==0 ? "" : ",", r.name.c_str(), r.size, r.threads, r.reps, r.t_min, r.t_median, r.t_mean,
+	    r.flops, r.bytes, 1e-9*r.flops/r.t_median, 1e-9*r.bytes/r.t_median);
+  }
+  fprintf(f, "\n  ]\n}\n");
+  fclose(f);
+  return true;
+}
+
+static std::vector<long long> parse_list(const char* str)
+{
+  std::vector<long long> vals;
+  std::string s(str);
+  size_t pos = 0;
+  while(pos<s.size()) {
+    size_t next = s.find(',', pos);
+    if(next==std::string::npos) next = s.size();
+    long long v = atoll(s.substr(pos, next-pos).c_str());
+    if(v>0) vals.push_back(v);
+    pos = next+1;
+  }
+  return vals;
+}
+
+static void usage(const char* exe)
+{
+  printf("Usage: %s [-sizes n1,n2,...] [-threads t1,t2,...] [-min_time sec] [-filter substr] "
+	 "[-out file.json]\n", exe);
+  printf("  -sizes    problem sizes n (default 10000,100000,1000000); see the top of "
+	 "linalg_benchmark.cpp\n            for how n determines the operands of each kernel\n");
+  printf("  -threads  OpenMP thread counts (default 1 and the maximum number of threads)\n");
+  printf("  -min_time minimum time in seconds spent timing each kernel (default 0.1)\n");
+  printf("  -filter   benchmark only the kernels whose name contains 'substr' (e.g., 'sparse.')\n");
+  printf("  -out      name of the JSON output file (default hiop_bench.json)\n");
+}
+
+int main(int argc, char** argv)
+{
+  int rank=0;
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr); (void)ierr;
+#endif
+  std::vector<long long> sizes = {10000, 100000, 1000000};
+  std::vector<long long> threads;
+  double min_time = 0.1;
+  std::string filter, out_file("hiop_bench.json");
+
+  for(int i=1; i<argc; i++) {
+    if(0==strcmp(argv[i], "-sizes") && i+1<argc) sizes = parse_list(argv[++i]);
+    else if(0==strcmp(argv[i], "-threads") && i+1<argc) threads = parse_list(argv[++i]);
+    else if(0==strcmp(argv[i], "-min_time") && i+1<argc) min_time = atof(argv[++i]);
+    else if(0==strcmp(argv[i], "-filter") && i+1<argc) filter = argv[++i];
+    else if(0==strcmp(argv[i], "-out") && i+1<argc) out_file = argv[++i];
+    else {
+      if(0==rank) usage(argv[0]);
+#ifdef HIOP_USE_MPI
+      MPI_Finalize();
+#endif
+      return strcmp(argv[i], "-help") ? 1 : 0;
+    }
+  }
+  if(threads.empty()) {
+    threads.push_back(1);
+#ifdef _OPENMP
+    if(omp_get_max_threads()>1) threads.push_back(omp_get_max_threads());
+#endif
+  }
+
+  std::vector<BenchResult> results;
+  //only the master rank benchmarks; the kernels are local (no MPI communication)
+  if(0==rank) {
+    printf("%-58s %10s %4s %9s %12s %12s %9s\n",
+	   "kernel", "size", "thr", "reps", "t_min", "t_median", "GB/s");
+    for(long long n : sizes) {
+      std::vector<BenchKernel> kernels;
+      vector_kernels(n, kernels);
+      dense_kernels(n, kernels);
+      sparse_kernels(n, kernels);
+
+      for(long long nthreads : threads) {
+#ifdef _OPENMP
+	omp_set_num_threads((int)nthreads);
+#else
+	if(nthreads>1) continue;
+#endif
+	for(const BenchKernel& k : kernels) {
+	  if(!filter.empty() && std::string::npos==k.name.find(filter)) continue;
+	  BenchResult r = time_kernel(k, n, (int)nthreads, min_time, 3);
+	  printf("%-58s %10lld %4d %9lld %12.5e %12.5e %9.3f\n", r.name.c_str(), r.size, r.threads,
+		 r.reps, r.t_min, r.t_median, 1e-9*r.bytes/r.t_median);
+	  results.push_back(r);
+	}
+      }
+    }
+    if(!write_json(out_file.c_str(), results, min_time)) {
+      printf("could not write '%s'\n", out_file.c_str());
+    } else {
+      printf("results written to '%s'\n", out_file.c_str());
+    }
+  }
+
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -0,0 +1,149 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "hiopInterface.h"
+#include <math.h>
+
+/* Example 2 (see nlpDenseCons_ex2.hpp) through the C interface, in serial
+ *  min   sum 1/4* { (x_{i}-1)^4 : i=1,...,n}
+ *  s.t.
+ *        sum x_i = n+1
+ *        5<= 2*x_1 + sum {x_i : i=2,...,n}
+ *        1<= 2*x_1 + 0.5*x_2 + sum{x_i : i=3,...,n} <= 2*n
+ *            4*x_1 + 2  *x_2 + 2*x_3 + sum{x_i : i=4,...,n} <=4*n
+ *        x_1 free
+ *        0.0 <= x_2
+ *        1.5 <= x_3 <= 10
+ *        x_i >=0.5, i=4,...,n
+ */
+typedef struct settings {
+  long long n; long long m;
+} settings;
+
+int get_starting_point(long long n, double* x0, void* user_data_) {
+  (void)user_data_;
+  long long i = 0;
+  for(i=0; i<n; i=i+1) x0[i]=0.;
+  return 0;
+}
+
+int get_prob_sizes(long long* n_, long long* m_, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  *n_ = user_data->n;
+  *m_ = user_data->m;
+  return 0;
+}
+
+int get_vars_info(long long n, double *xlow_, double* xupp_, void* user_data_) {
+  (void)user_data_;
+  long long i = 0;
+  xlow_[0] = -1e20; xupp_[0] = 1e20;
+  xlow_[1] =  0.0;  xupp_[1] = 1e20;
+  xlow_[2] =  1.5;  xupp_[2] = 10.0;
+  for(i=3; i<n; i=i+1) { xlow_[i] = 0.5; xupp_[i] = 1e20; }
+  return 0;
+}
+
+int get_cons_info(long long m, double *clow_, double* cupp_, void* user_data_) {
+  settings* user_data = (settings*) user_data_;
+  assert(m==4); (void)m;
+  clow_[0] = user_data->n+1; cupp_[0] = user_data->n+1;
+  clow_[1] = 5.0;            cupp_[1] = 1e20;
+  clow_[2] = 1.0;            cupp_[2] = 2*user_data->n;
+  clow_[3] = -1e20;          cupp_[3] = 4*user_data->n;
+  return 0;
+}
+
+int eval_f(int n, double* x, int new_x, double* obj, void* user_data_) {
+  (void)new_x; (void)user_data_;
+  int i = 0;
+  *obj = 0.;
+  for(i=0; i<n; i=i+1) *obj += 0.25*pow(x[i]-1., 4);
+  return 0;
+}
+
+int eval_grad_f(long long n, double* x, int new_x, double* gradf, void* user_data_) {
+  (void)new_x; (void)user_data_;
+  long long i = 0;
+  for(i=0; i<n; i=i+1) gradf[i] = pow(x[i]-1., 3);
+  return 0;
+}
+
+int eval_cons(long long n, long long m, double* x, int new_x, double* cons, void* user_data_) {
+  (void)m; (void)new_x; (void)user_data_;
+  long long i = 0;
+  double sum = 0.;
+  for(i=3; i<n; i=i+1) sum += x[i];
+
+  cons[0] = x[0] + x[1] + x[2] + sum;
+  cons[1] = 2*x[0] + x[1] + x[2] + sum;
+  cons[2] = 2*x[0] + 0.5*x[1] + x[2] + sum;
+  cons[3] = 4*x[0] + 2*x[1] + 2*x[2] + sum;
+  return 0;
+}
+
+/* the m x n Jacobian is stored by rows in JacD */
+int eval_Jac_cons(long long n, long long m, double* x, int new_x, double* JacD, void* user_data_) {
+  (void)x; (void)new_x; (void)user_data_;
+  long long i = 0;
+  for(i=0; i<m*n; i=i+1) JacD[i] = 1.0;
+  JacD[n+0] = 2.;
+  JacD[2*n+0] = 2.; JacD[2*n+1] = 0.5;
+  JacD[3*n+0] = 4.; JacD[3*n+1] = 2.;  JacD[3*n+2] = 2.;
+  return 0;
+}
+
+int main(int argc, char **argv) {
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr); (void)ierr;
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#else
+  (void)argc; (void)argv;
+#endif
+
+  long long n = 500;
+  settings user_data = {n, 4};
+
+  cHiopProblem problem;
+  memset(&problem, 0, sizeof(cHiopProblem));
+  problem.user_data = &user_data;
+  problem.get_starting_point = get_starting_point;
+  problem.get_prob_sizes = get_prob_sizes;
+  problem.get_vars_info = get_vars_info;
+  problem.get_cons_info = get_cons_info;
+  problem.eval_f = eval_f;
+  problem.eval_grad_f = eval_grad_f;
+  problem.eval_cons = eval_cons;
+  problem.solution = malloc(n * sizeof(double));
+
+  hiop_createDenseConsProblem(&problem, eval_Jac_cons);
+  hiop_setIntegerOption(&problem, "verbosity_level", 3);
+  int status = hiop_solveProblem(&problem);
+  if(status<0 || fabs((problem.obj_value-1.56251020819349e-02)/(1+1.56251020819349e-02))>1e-6) {
+    printf("objective mismatch or solve failure (status %d) for Ex2 dense constraints C interface "
+      "problem with 500 variables. BTW, obj=%18.12e was returned by HiOp.\n", status, problem.obj_value);
+    return -1;
+  }
+
+  // the solution is also available in caller-owned buffers
+  double* x = malloc(n*sizeof(double));
+  hiop_getSolution(&problem, x);
+  assert(0==memcmp(x, problem.solution, n*sizeof(double)));
+
+  hiop_destroyProblem(&problem);
+  free(x);
+  free(problem.solution);
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return 0;
+}
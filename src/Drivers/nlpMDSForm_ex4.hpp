@@ -646,4 +646,58 @@ public:
   }
 };
 
+/* Same NLP as in Ex4OneCallCons, providing additionally the combined callbacks: the objective 
+ * and its gradient share the product Q*y, while the constraints and the Jacobian are evaluated in
+ * the same call to the user code. */
+class Ex4CombinedCallbacks : public Ex4OneCallCons
+{
+public:
+  Ex4CombinedCallbacks(int ns_in, int nd_in)
+    : Ex4OneCallCons(ns_in, nd_in)
+  {
+  }
+  
+  virtual ~Ex4CombinedCallbacks()
+  {
+  }
+
+  bool eval_f_grad_f(const long long& n, const double* x, bool new_x, 
+		     double& obj_value, double* gradf)
+  {
+    assert(Q->n()==nd); assert(Q->m()==nd);
+    const double* s = x+ns;
+    const double* y = x+2*ns;
+    double* gradf_y = gradf+2*ns;
+
+    obj_value=0.;
+    for(int i=0; i<ns; i++) obj_value += x[i]*(x[i]-1.);
+    obj_value *= 0.5;
+    for(int i=0; i<ns; i++) gradf[i] = x[i]-0.5;
+
+    //Qd*y is computed once, in the gradient, and reused for the term 0.5 y'*Qd*y
+    Q->timesVec(0.0, gradf_y, 1., y);
+    double term2=0.;
+    for(int i=0; i<nd; i++) term2 += gradf_y[i] * y[i];
+    obj_value += 0.5*term2;
+
+    double term3=0.;
+    for(int i=0; i<ns; i++) term3 += s[i]*s[i];
+    obj_value += 0.5*term3;
+    for(int i=0; i<ns; i++) gradf[ns+i] = s[i];
+
+    return true;
+  }
+
+  bool eval_cons_Jac_cons(const long long& n, const long long& m, 
+			  const double* x, bool new_x,
+			  double* cons,
+			  const long long& nsparse, const long long& ndense, 
+			  const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+			  double** JacD)
+  {
+    return Ex4OneCallCons::eval_cons(n, m, x, new_x, cons) &&
+      Ex4OneCallCons::eval_Jac_cons(n, m, x, false, nsparse, ndense, 
+				    nnzJacS, iJacS, jJacS, MJacS, JacD);
+  }
+};
 #endif
@@ -13,6 +13,7 @@ typedef struct settings {
   int nnz_sparse_Hess_Lagr_SS; int nnz_sparse_Hess_Lagr_SD;
   double* xlow; double* xupp; double* clow; double* cupp;
   double* Q; double* Md; double* buf_y;
+  int n_iter_callback;
 } settings;
 
 // y := alpha*A*x + beta*y
@@ -84,7 +85,7 @@ int eval_grad_f(long long n, double* x, int new_x, double* gradf, void* user_dat
   settings* user_data = (settings*) user_data_;
   int i = 0;
   //x_i - 0.5 
-  for(long long  i=0; i<n; ++i) gradf[i]=0.0;
+  for(i=0; i<n; ++i) gradf[i]=0.0;
   for(i=0; i<user_data->ns; i=i+1) gradf[i] = x[i]-0.5;
 
   //Qd*y
@@ -279,24 +280,37 @@ int eval_Hess_Lagr(long long n, long long m,
 }
 
 
+int iterate_callback(int iter, double obj_value,
+    long long n, const double* x,
+    const double* z_L, const double* z_U,
+    long long m, const double* g, const double* lambda,
+    double inf_pr, double inf_du, double mu,
+    void* user_data_) {
+  (void)iter; (void)obj_value; (void)n; (void)x; (void)z_L; (void)z_U;
+  (void)m; (void)g; (void)lambda; (void)inf_pr; (void)inf_du; (void)mu;
+  settings* user_data = (settings*) user_data_;
+  user_data->n_iter_callback = user_data->n_iter_callback + 1;
+  return 0;
+}
+
 int main(int argc, char **argv) {
-  int rank=0;
 #ifdef HIOP_USE_MPI
   MPI_Init(&argc, &argv);
   int comm_size;
-  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr);
-  //int ierr = MPI_Comm_rank(MPI_COMM_WORLD, &rank); assert(MPI_SUCCESS==ierr);
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr); (void)ierr;
   if(comm_size != 1) {
     printf("[error] driver detected more than one rank but the driver should be run "
 	   "in serial only; will exit\n");
     MPI_Finalize();
     return 1;
   }
+#else
+  (void)argc; (void)argv;
 #endif
 
   int ns = 400;
   int nd = 100;
-  int i,j;
+  int i;
 
   // println("ns: $ns, nd: $nd")
 
@@ -348,7 +362,7 @@ int main(int argc, char **argv) {
   settings user_data = {n, m, ns, nd, nx_sparse, nx_dense, nnz_sparse_Jaceq, nnz_sparse_Jacineq,
                         nnz_sparse_Hess_Lagr_SS, nnz_sparse_Hess_Lagr_SD,
                         xlow, xupp, clow, cupp,
-                        Q,  Md, buf_y};
+                        Q,  Md, buf_y, 0};
                         
   cHiopProblem problem;
   problem.user_data = &user_data;
@@ -363,7 +377,7 @@ int main(int argc, char **argv) {
   problem.eval_Jac_cons = eval_Jac_cons;
   problem.eval_Hess_Lagr = eval_Hess_Lagr;
   problem.solution = malloc(n * sizeof(double));
-  for(int i=0; i<n; i++) problem.solution[i] = 0.0;
+  for(i=0; i<n; i++) problem.solution[i] = 0.0;
   
   hiop_createProblem(&problem);
   hiop_solveProblem(&problem);
@@ -372,8 +386,34 @@ int main(int argc, char **argv) {
       "dense variables did. BTW, obj=%18.12e was returned by HiOp.\n", problem.obj_value);
       return -1;
   }
+
+  // Reoptimize on the same problem handle from the primal-dual solution of the first solve
+  double* zl = malloc(n*sizeof(double));
+  double* zu = malloc(n*sizeof(double));
+  double* lambda = malloc(m*sizeof(double));
+  hiop_getDualSolutions(&problem, zl, zu, lambda);
+  hiop_setStartingPoint(&problem, problem.solution, zl, zu, lambda);
+
+  //less agressive log-barrier parameter is always a safe bet
+  hiop_setNumericOption(&problem, "mu0", 1e-6);
+  hiop_setNumericOption(&problem, "tolerance", 1e-8);
+  hiop_setIterateCallback(&problem, iterate_callback);
+
+  user_data.n_iter_callback = 0;
+  int status = hiop_solveProblem(&problem);
+  if(status<0 || fabs(problem.obj_value-(-4.999509728895e+01))>1e-6) {
+    printf("objective mismatch or solve failure (status %d) for the reoptimization of the Ex4 MDS C "
+      "interface problem. BTW, obj=%18.12e was returned by HiOp.\n", status, problem.obj_value);
+      return -1;
+  }
+  if(user_data.n_iter_callback != hiop_getNumIterations(&problem)+1) {
+    printf("iterate callback called %d times for the %d iterations of the reoptimization\n",
+      user_data.n_iter_callback, hiop_getNumIterations(&problem));
+    return -1;
+  }
   hiop_destroyProblem(&problem);
   free(problem.solution);
+  free(zl); free(zu); free(lambda);
   free(xlow); free(xupp);
   free(clow); free(cupp);
   free(Q); free(Md); free(buf_y);
@@ -17,12 +17,12 @@ static bool parse_arguments(int argc, char **argv,
 			    bool& self_check,
 			    long long& n_sp,
 			    long long& n_de,
-			    bool& one_call_cons)
+			    int& cons_eval_mode)
 {
   self_check=false;
   n_sp = 1000;
   n_de = 1000;
-  one_call_cons = false;
+  cons_eval_mode = 0;
   switch(argc) {
   case 1:
     //no arguments
@@ -35,7 +35,8 @@ static bool parse_arguments(int argc, char **argv,
     }
   case 4: // 3 arguments
     {
-      one_call_cons = (bool) atoi(argv[3]);
+      cons_eval_mode = atoi(argv[3]);
+      if(cons_eval_mode<0 || cons_eval_mode>2) return false;
     }
   case 3: //2 arguments
     {
@@ -69,8 +70,9 @@ static void usage(const char* exeName)
   printf("  'de_vars_size': # of dense variables [default 100, optional]\n");
   printf("  '-selfcheck': compares the optimal objective with sp_vars_size being 400 and "
 	 "de_vars_size being 100 (these two exact values must be passed as arguments). [optional]\n");
-  printf("  'eq_ineq_combined_nlp': 0 or 1, specifying whether the NLP formulation with split "
-	 "constraints should be used (0) or not (1) [default 0, optional]\n");
+  printf("  'eq_ineq_combined_nlp': 0, 1, or 2, specifying whether the NLP formulation with split "
+	 "constraints should be used (0) or not (1), or the latter should also provide the combined "
+	 "objective-gradient and constraints-Jacobian callbacks (2) [default 0, optional]\n");
 }
 
 
@@ -94,9 +96,10 @@ int main(int argc, char **argv)
   magma_init();
 #endif
 
-  bool selfCheck, one_call_cons;
+  bool selfCheck;
+  int cons_eval_mode;
   long long n_sp, n_de;
-  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, one_call_cons)) {
+  if(!parse_arguments(argc, argv, selfCheck, n_sp, n_de, cons_eval_mode)) {
     usage(argv[0]);
     return 1;
   }
@@ -106,7 +109,9 @@ int main(int argc, char **argv)
 
   //user's NLP -> implementation of hiop::hiopInterfaceMDS
   Ex4* my_nlp;
-  if(one_call_cons) {
+  if(2 == cons_eval_mode) {
+    my_nlp = new Ex4CombinedCallbacks(n_sp, n_de);
+  } else if(1 == cons_eval_mode) {
     my_nlp = new Ex4OneCallCons(n_sp, n_de);
   } else {
     my_nlp = new Ex4(n_sp, n_de);
@@ -18,6 +18,7 @@
 #include <cassert>
 #include <cstring> //for memcpy
 #include <cstdio>
+#include <vector>
 #include <cmath>
 
 /** Nonlinear *highly nonconvex* and *rank deficient* problem test for the Filter IPM 
@@ -86,13 +87,10 @@ public:
 
     Md_ = hiop::LinearAlgebraFactory::createMatrixDense(ns_, nd_);
     Md_->setToConstant(-1.0);
-
-    _buf_y_ = new double[nd_];
   }
 
   virtual ~Ex5()
   {
-    delete[] _buf_y_;
     delete Md_;
     delete Q_;
   }
@@ -189,8 +187,10 @@ public:
 
     double term2=0.;
     const double* y = x+2*ns_;
-    Q_->timesVec(0.0, _buf_y_, 1., y);
-    for(int i=0; i<nd_; i++) term2 += _buf_y_[i] * y[i];
+    //local buffer so that the evaluations can be done concurrently (see eval_funcs_thread_safe)
+    std::vector<double> Qy(nd_);
+    Q_->timesVec(0.0, Qy.data(), 1., y);
+    for(int i=0; i<nd_; i++) term2 += Qy[i] * y[i];
     obj_value += 0.5*term2;
     
     const double* s=x+ns_;
@@ -540,10 +540,13 @@ public:
 
   /** pass the COMM_SELF communicator since this example is only intended to run inside 1 MPI process */
   virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_SELF; return true;}
+
+  /** the objective and the constraints do not use internal buffers, so HiOp can evaluate them at
+   *  several points at once (see option 'linesearch_batch') */
+  virtual bool eval_funcs_thread_safe() { return true; }
 protected:
   int ns_, nd_;
   hiop::hiopMatrixDense *Q_, *Md_;
-  double* _buf_y_;
   bool rankdefic_eq_, rankdefic_ineq_;
   bool convex_obj_; 
 };
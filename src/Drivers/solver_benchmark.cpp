@@ -0,0 +1,373 @@
+// End-to-end benchmark of the HiOp solver (target 'hiop_solver_bench')
+//
+// Solves the problems of the example drivers over a grid of sizes, repeating each solve a given
+// number of times, and records the total time, the time of the main phases (from hiopRunStats),
+// the number of iterations, and the peak resident memory of each solve. The results are printed
+// on screen and written in JSON format; when a baseline (a JSON file written by a previous run)
+// is given, the median total times are compared against it and the driver returns a nonzero
+// exit code if any of them regressed by more than the threshold.
+//
+// Problems and the meaning of the size 'n'
+//  - ex1: dense constraints problem of nlpDenseCons_ex1 with a mesh of n elements (ratio 1.0)
+//  - ex4: MDS problem of nlpMDS_ex4 with n sparse and n/4 dense variables
+//  - ex5: MDS problem of nlpMDS_ex5 with n sparse and n/4 dense variables (convex objective and
+//    full-rank Jacobians)
+
+#include "nlpDenseCons_ex1.hpp"
+#include "nlpMDSForm_ex4.hpp"
+#include "nlpMDS_ex5.hpp"
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopAlgFilterIPM.hpp"
+
+#ifdef HIOP_USE_MAGMA
+#include "magma_v2.h"
+#endif
+
+#include <sys/resource.h>
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace hiop;
+
+struct SolveRecord
+{
+  std::string problem;
+  long long size;
+  int reps;
+  int status, iters;
+  double objective;
+  //total times over the repetitions
+  double t_total_min, t_total_median, t_total_mean;
+  //phase times of the median (in total time) repetition
+  double t_solver_internal, t_starting_point, t_duals_update;
+  double t_eval_f, t_eval_grad_f, t_eval_cons, t_eval_jac, t_eval_hess;
+  double t_kkt_total, t_kkt_fact;
+  //peak resident memory (in kilobytes) over the repetitions
+  long long peak_rss_kb;
+};
+
+/* Resets the peak resident set size of the process, when supported (Linux 4.0 or later) */
+static void reset_peak_rss()
+{
+#ifdef __linux__
+  FILE* f = fopen("/proc/self/clear_refs", "w");
+  if(f) {
+    fputs("5", f);
+    fclose(f);
+  }
+#endif
+}
+
+/* Peak resident set size in kilobytes since the last reset_peak_rss (or since the start of the
+ * process if resetting is not supported)
+ */
+static long long get_peak_rss_kb()
+{
+#ifdef __linux__
+  FILE* f = fopen("/proc/self/status", "r");
+  if(f) {
+    char line[256];
+    long long kb = -1;
+    while(fgets(line, sizeof(line), f)) {
+      if(0==strncmp(line, "VmHWM:", 6)) {
+	kb = atoll(line+6);
+	break;
+      }
+    }
+    fclose(f);
+    if(kb>=0) return kb;
+  }
+#endif
+  struct rusage usage;
+  if(0==getrusage(RUSAGE_SELF, &usage)) return usage.ru_maxrss;
+  return -1;
+}
+
+/* Runs one solve of 'problem' of size 'n' and fills in the status, objective, iterations, and
+ * the total and phase times of 'rec'
+ */
+static bool solve_once(const std::string& problem, long long n, SolveRecord& rec)
+{
+  hiopInterfaceBase* prob_interface = NULL;
+  hiopNlpFormulation* nlp = NULL;
+  hiopAlgFilterIPMBase* solver = NULL;
+
+  if(problem=="ex1") {
+    Ex1Interface* ex1 = new Ex1Interface(n, 1.0);
+    nlp = new hiopNlpDenseConstraints(*ex1);
+    prob_interface = ex1;
+  } else if(problem=="ex4" || problem=="ex5") {
+    hiopInterfaceMDS* mds;
+    if(problem=="ex4") mds = new Ex4(n, n/4);
+    else mds = new Ex5(n, n/4, true, false, false);
+    nlp = new hiopNlpMDS(*mds);
+    prob_interface = mds;
+
+    nlp->options->SetStringValue("dualsUpdateType", "linear");
+    nlp->options->SetStringValue("dualsInitialization", "zero");
+    nlp->options->SetStringValue("Hessian", "analytical_exact");
+    nlp->options->SetNumericValue("mu0", 1e-1);
+    if(problem=="ex4") nlp->options->SetStringValue("KKTLinsys", "xdycyd");
+  } else {
+    printf("unknown problem '%s'\n", problem.c_str());
+    return false;
+  }
+  nlp->options->SetIntegerValue("verbosity_level", 0);
+
+  if(problem=="ex1") solver = new hiopAlgFilterIPM(dynamic_cast<hiopNlpDenseConstraints*>(nlp));
+  else solver = new hiopAlgFilterIPMNewton(nlp);
+
+  rec.status = solver->run();
+  rec.objective = solver->getObjective();
+  rec.iters = solver->getNumIterations();
+
+  hiopRunStats& st = nlp->runStats;
+  rec.t_total_min = rec.t_total_median = rec.t_total_mean = st.tmOptimizTotal.getElapsedTime();
+  rec.t_solver_internal = st.tmSolverInternal.getElapsedTime();
+  rec.t_starting_point = st.tmStartingPoint.getElapsedTime();
+  rec.t_duals_update = st.tmMultUpdate.getElapsedTime();
+  rec.t_eval_f = st.tmEvalObj.getElapsedTime();
+  rec.t_eval_grad_f = st.tmEvalGrad_f.getElapsedTime();
+  rec.t_eval_cons = st.tmEvalCons.getElapsedTime();
+  rec.t_eval_jac = st.tmEvalJac_con.getElapsedTime();
+  rec.t_eval_hess = st.tmEvalHessL.getElapsedTime();
+  rec.t_kkt_total = st.kkt.tmTotal;
+  rec.t_kkt_fact = st.kkt.tmTotalUpdateInnerFact;
+
+  delete solver;
+  delete nlp;
+  delete prob_interface;
+  return true;
+}
+
+static bool benchmark(const std::string& problem, long long n, int reps, SolveRecord& rec)
+{
+  std::vector<SolveRecord> runs(reps);
+  reset_peak_rss();
+  for(int r=0; r<reps; r++) {
+    if(!solve_once(problem, n, runs[r])) return false;
+  }
+  std::vector<int> order(reps);
+  for(int r=0; r<reps; r++) order[r] = r;
+  std::sort(order.begin(), order.end(),
+	    [&](int a, int b) { return runs[a].t_total_median < runs[b].t_total_median; });
+
+  //phase times are those of the median run
+  rec = runs[order[reps/2]];
+  rec.problem = problem;
+  rec.size = n;
+  rec.reps = reps;
+  rec.t_total_min = runs[order[0]].t_total_median;
+  double sum = 0.;
+  for(int r=0; r<reps; r++) sum += runs[r].t_total_median;
+  rec.t_total_mean = sum/reps;
+  rec.peak_rss_kb = get_peak_rss_kb();
+  return true;
+}
+
+static bool write_json(const char* filename, const std::vector<SolveRecord>& recs)
+{
+  FILE* f = fopen(filename, "w");
+  if(NULL==f) return false;
+  fprintf(f, "{\n  \"benchmark\": \"hiop_solver_bench\",\n");
+#ifdef HIOP_DEEPCHECKS
+  fprintf(f, "  \"deepchecks\": true,\n");
+#else
+  fprintf(f, "  \"deepchecks\": false,\n");
+#endif
+  fprintf(f, "  \"results\": [");
+  //one record per line; read_baseline relies on this
+  for(size_t i=0; i<recs.size(); i++) {
+    const SolveRecord& r = recs[i];
+    fprintf(f, "%s\n    {\"problem\": \"%s\", \"size\": %lld, \"reps\": %d, \"status\": %d, "
+	    "\"iters\": %d, \"objective\": %.12e, \"t_total_min\": %.6e, \"t_total_median\": %.6e, "
+	    "\"t_total_mean\": %.6e, \"t_solver_internal\": %.6e, \"t_starting_point\": %.6e, "
+	    "\"t_duals_update\": %.6e, \"t_eval_f\": %.6e, "
+	    "\"t_eval_grad_f\": %.6e, \"t_eval_cons\": %.6e, \"t_eval_jac\": %.6e, "
+	    "\"t_eval_hess\": %.6e, \"t_kkt_total\": %.6e, \"t_kkt_fact\": %.6e, "
+	    "\"peak_rss_kb\": %lld}",
+	    i==0 ? "" : ",", r.problem.c_str(), r.size, r.reps, r.status, r.iters, r.objective,
+	    r.t_total_min, r.t_total_median, r.t_total_mean, r.t_solver_internal, r.t_starting_point,
+	    r.t_duals_update, r.t_eval_f, r.t_eval_grad_f, r.t_eval_cons,
+	    r.t_eval_jac, r.t_eval_hess, r.t_kkt_total, r.t_kkt_fact, r.peak_rss_kb);
+  }
+  fprintf(f, "\n  ]\n}\n");
+  fclose(f);
+  return true;
+}
+
+/* Reads the median total times and the iterations from a JSON file written by write_json. The
+ * map keys are "problem:size".
+ */
+static bool read_baseline(const char* filename, std::map<std::string, std::pair<double,int> >& base)
+{
+  FILE* f = fopen(filename, "r");
+  if(NULL==f) return false;
+  char line[2048];
+  while(fgets(line, sizeof(line), f)) {
+    const char* p = strstr(line, "\"problem\": \"");
+    const char* s = strstr(line, "\"size\": ");
+    const char* t = strstr(line, "\"t_total_median\": ");
+    const char* it = strstr(line, "\"iters\": ");
+    if(!p || !s || !t || !it) continue;
+    p += strlen("\"problem\": \"");
+    const char* p_end = strchr(p, '"');
+    if(!p_end) continue;
+    std::string key = std::string(p, p_end) + ":" +
+      std::to_string(atoll(s+strlen("\"size\": ")));
+    base[key] = std::make_pair(atof(t+strlen("\"t_total_median\": ")),
+			       atoi(it+strlen("\"iters\": ")));
+  }
+  fclose(f);
+  return true;
+}
+
+static std::vector<long long> parse_sizes(const char* str)
+{
+  std::vector<long long> vals;
+  std::string s(str);
+  size_t pos = 0;
+  while(pos<s.size()) {
+    size_t next = s.find(',', pos);
+    if(next==std::string::npos) next = s.size();
+    long long v = atoll(s.substr(pos, next-pos).c_str());
+    if(v>0) vals.push_back(v);
+    pos = next+1;
+  }
+  return vals;
+}
+
+static void usage(const char* exe)
+{
+  printf("Usage: %s [-problems ex1,ex4,ex5] [-sizes n1,n2,...] [-reps r] [-out file.json] "
+	 "[-baseline file.json] [-threshold t]\n", exe);
+  printf("  -problems  problems to solve (default all: ex1,ex4,ex5)\n");
+  printf("  -sizes     problem sizes; default 500,5000,50000 for ex1 and 200,400,800 for ex4 "
+	 "and ex5\n");
+  printf("  -reps      number of solves of each problem and size (default 3)\n");
+  printf("  -out       name of the JSON output file (default hiop_solver_bench.json)\n");
+  printf("  -baseline  JSON file written by a previous run to compare against\n");
+  printf("  -threshold relative increase of the median total time considered a regression "
+	 "(default 0.1)\n");
+}
+
+int main(int argc, char** argv)
+{
+#ifdef HIOP_USE_MPI
+  MPI_Init(&argc, &argv);
+  int comm_size;
+  int ierr = MPI_Comm_size(MPI_COMM_WORLD, &comm_size); assert(MPI_SUCCESS==ierr); (void)ierr;
+  if(comm_size != 1) {
+    printf("[error] driver detected more than one rank but the driver should be run "
+	   "in serial only; will exit\n");
+    MPI_Finalize();
+    return 1;
+  }
+#endif
+#ifdef HIOP_USE_MAGMA
+  magma_init();
+#endif
+
+  std::vector<std::string> problems = {"ex1", "ex4", "ex5"};
+  std::vector<long long> sizes;
+  int reps = 3;
+  double threshold = 0.1;
+  std::string out_file("hiop_solver_bench.json"), baseline_file;
+
+  bool args_ok = true;
+  for(int i=1; i<argc && args_ok; i++) {
+    if(0==strcmp(argv[i], "-problems") && i+1<argc) {
+      problems.clear();
+      std::string s(argv[++i]);
+      size_t pos = 0;
+      while(pos<s.size()) {
+	size_t next = s.find(',', pos);
+	if(next==std::string::npos) next = s.size();
+	problems.push_back(s.substr(pos, next-pos));
+	pos = next+1;
+      }
+    }
+    else if(0==strcmp(argv[i], "-sizes") && i+1<argc) sizes = parse_sizes(argv[++i]);
+    else if(0==strcmp(argv[i], "-reps") && i+1<argc) reps = std::max(1, atoi(argv[++i]));
+    else if(0==strcmp(argv[i], "-out") && i+1<argc) out_file = argv[++i];
+    else if(0==strcmp(argv[i], "-baseline") && i+1<argc) baseline_file = argv[++i];
+    else if(0==strcmp(argv[i], "-threshold") && i+1<argc) threshold = atof(argv[++i]);
+    else args_ok = false;
+  }
+  for(size_t p=0; p<problems.size() && args_ok; p++) {
+    if(problems[p]!="ex1" && problems[p]!="ex4" && problems[p]!="ex5") args_ok = false;
+  }
+  if(!args_ok) {
+    usage(argv[0]);
+#ifdef HIOP_USE_MPI
+    MPI_Finalize();
+#endif
+    return 1;
+  }
+
+  std::map<std::string, std::pair<double,int> > baseline;
+  if(!baseline_file.empty() && !read_baseline(baseline_file.c_str(), baseline)) {
+    printf("[warning] could not read baseline file '%s'\n", baseline_file.c_str());
+  }
+
+  printf("%-6s %8s %4s %6s %6s %12s %12s %12s %12s %10s %s\n", "prob", "size", "reps", "status",
+	 "iters", "t_median", "t_internal", "t_kkt", "t_evals", "rss_MB", "vs. baseline");
+  std::vector<SolveRecord> records;
+  int n_regressions = 0;
+  for(const std::string& problem : problems) {
+    std::vector<long long> prob_sizes = sizes;
+    if(prob_sizes.empty()) {
+      if(problem=="ex1") prob_sizes = {500, 5000, 50000};
+      else prob_sizes = {200, 400, 800};
+    }
+    for(long long n : prob_sizes) {
+      SolveRecord rec;
+      if(!benchmark(problem, n, reps, rec)) continue;
+      records.push_back(rec);
+
+      std::string cmp("-");
+      std::map<std::string, std::pair<double,int> >::const_iterator it =
+	baseline.find(problem + ":" + std::to_string(n));
+      if(it!=baseline.end() && it->second.first>0) {
+	const double rel = rec.t_total_median/it->second.first - 1.;
+	char buf[128];
+	snprintf(buf, sizeof(buf), "%+.1f%%%s%s", 100*rel, rel>threshold ? " REGRESSION" : "",
+		 rec.iters!=it->second.second ? " (iterations changed)" : "");
+	cmp = buf;
+	if(rel>threshold) n_regressions++;
+      }
+      const double t_evals = rec.t_eval_f + rec.t_eval_grad_f + rec.t_eval_cons + rec.t_eval_jac +
+	rec.t_eval_hess;
+      printf("%-6s %8lld %4d %6d %6d %12.4e %12.4e %12.4e %12.4e %10.1f %s\n", problem.c_str(), n,
+	     reps, rec.status, rec.iters, rec.t_total_median, rec.t_solver_internal, rec.t_kkt_total,
+	     t_evals, rec.peak_rss_kb/1024., cmp.c_str());
+    }
+  }
+
+  if(!write_json(out_file.c_str(), records)) {
+    printf("could not write '%s'\n", out_file.c_str());
+  } else {
+    printf("results written to '%s'\n", out_file.c_str());
+  }
+  if(!baseline.empty()) {
+    printf("%d regression(s) above the threshold of %.1f%% with respect to '%s'\n",
+	   n_regressions, 100*threshold, baseline_file.c_str());
+  }
+
+#ifdef HIOP_USE_MAGMA
+  magma_finalize();
+#endif
+#ifdef HIOP_USE_MPI
+  MPI_Finalize();
+#endif
+  return n_regressions>0 ? 2 : 0;
+}
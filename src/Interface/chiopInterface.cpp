@@ -3,7 +3,8 @@ extern "C" {
 
 using namespace hiop;
 
-// These are default options for the C interface for now. Setting options from C will be added in the future.
+// These are default options for MDS problems created through the C interface; they can be changed
+// with the option setters below.
 int hiop_createProblem(cHiopProblem *prob) {
   cppUserProblem * cppproblem = new cppUserProblem(prob);
   hiopNlpMDS *nlp = new hiopNlpMDS(*cppproblem);
@@ -19,20 +20,94 @@ int hiop_createProblem(cHiopProblem *prob) {
   prob->refcppHiop = nlp;
   prob->hiopinterface = cppproblem;
   return 0;
-} 
+}
+
+int hiop_createDenseConsProblem(cHiopProblem *prob, hiop_eval_Jac_cons_dense_cb eval_Jac_cons) {
+  if(NULL == eval_Jac_cons) {
+    return 1;
+  }
+  cppUserProblemDenseCons * cppproblem = new cppUserProblemDenseCons(prob, eval_Jac_cons);
+  hiopNlpDenseConstraints *nlp = new hiopNlpDenseConstraints(*cppproblem);
+  prob->refcppHiop = nlp;
+  prob->hiopinterface = cppproblem;
+  return 0;
+}
+
+int hiop_setNumericOption(cHiopProblem *prob, const char* name, double value) {
+  return prob->refcppHiop->options->SetNumericValue(name, value) ? 0 : 1;
+}
+
+int hiop_setIntegerOption(cHiopProblem *prob, const char* name, int value) {
+  return prob->refcppHiop->options->SetIntegerValue(name, value) ? 0 : 1;
+}
+
+int hiop_setStringOption(cHiopProblem *prob, const char* name, const char* value) {
+  return prob->refcppHiop->options->SetStringValue(name, value) ? 0 : 1;
+}
+
+int hiop_setStartingPoint(cHiopProblem *prob, const double* x0,
+			  const double* zl0, const double* zu0, const double* lambda0) {
+  cppUserProblemState* state = prob->hiopinterface;
+  state->x0 = x0;
+  state->zl0 = zl0;
+  state->zu0 = zu0;
+  state->lambda0 = lambda0;
+  return 0;
+}
+
+int hiop_setIterateCallback(cHiopProblem *prob, hiop_iterate_cb iterate_callback) {
+  prob->hiopinterface->iterate_cb = iterate_callback;
+  return 0;
+}
 
 int hiop_solveProblem(cHiopProblem *prob) {
-  hiopSolveStatus status;
-  hiopAlgFilterIPMNewton solver(prob->refcppHiop);
-  status = solver.run();
-  prob->obj_value = solver.getObjective();
-  solver.getSolution(prob->solution);
+  cppUserProblemState* state = prob->hiopinterface;
+  if(NULL == state->solver) {
+    //dense constraints problems are solved with the quasi-Newton IPM, MDS problems with the Newton IPM
+    hiopNlpDenseConstraints* nlp_dense = dynamic_cast<hiopNlpDenseConstraints*>(prob->refcppHiop);
+    if(nlp_dense) {
+      state->solver = new hiopAlgFilterIPMQuasiNewton(nlp_dense);
+    } else {
+      state->solver = new hiopAlgFilterIPMNewton(prob->refcppHiop);
+    }
+  }
+  hiopSolveStatus status = state->solver->run();
+  prob->obj_value = state->solver->getObjective();
+  if(prob->solution) {
+    state->solver->getSolution(prob->solution);
+  }
+  return status;
+}
+
+int hiop_getSolution(cHiopProblem *prob, double* x) {
+  cppUserProblemState* state = prob->hiopinterface;
+  if(NULL == state->solver) {
+    return 1;
+  }
+  state->solver->getSolution(x);
+  return 0;
+}
+
+int hiop_getDualSolutions(cHiopProblem *prob, double* zl, double* zu, double* lambda) {
+  cppUserProblemState* state = prob->hiopinterface;
+  if(NULL == state->solver) {
+    return 1;
+  }
+  state->solver->getDualSolutions(zl, zu, lambda);
   return 0;
 }
 
+int hiop_getNumIterations(cHiopProblem *prob) {
+  cppUserProblemState* state = prob->hiopinterface;
+  return NULL == state->solver ? 0 : state->solver->getNumIterations();
+}
+
 int hiop_destroyProblem(cHiopProblem *prob) {
+  //the solver uses the NLP formulation, which uses the user problem
+  delete prob->hiopinterface->solver;
+  prob->hiopinterface->solver = NULL;
   delete prob->refcppHiop;
   delete prob->hiopinterface;
   return 0;
 }
-} // extern C
\ No newline at end of file
+} // extern C
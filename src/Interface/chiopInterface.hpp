@@ -5,165 +5,321 @@
 #include "hiopNlpFormulation.hpp"
 #include "hiopAlgFilterIPM.hpp"
 
-/** Light C interface that wraps around the mixed-dense nlp class in HiOp. Its initial motivation
- * was to serve as an interface to Julia
+#include <cstring>
+
+/** Light C interface that wraps around the NLP formulations in HiOp: the mixed dense-sparse (MDS)
+ * formulation and the formulation with (few) dense constraints. Its initial motivation was to
+ * serve as an interface to Julia.
+ *
+ * The user fills in the callbacks of the 'cHiopProblem' struct, creates the problem handle with
+ * @hiop_createProblem (MDS) or @hiop_createDenseConsProblem, optionally sets options, a starting
+ * point, and an iterate callback, and solves with @hiop_solveProblem. The handle can be solved
+ * again (e.g., after changing options or the data behind 'user_data' that does not change the
+ * sizes or the sparsity), in which case the NLP formulation and the solver are reused. The
+ * solution and the duals are returned in caller-owned buffers.
+ *
+ * Note: the C declaration of 'cHiopProblem' in hiopInterface.h should be kept in sync with the
+ * one below.
  */
 
 using namespace hiop;
-class cppUserProblem;
+class cppUserProblemState;
 extern "C" {
+  // Jacobian of the constraints for the dense constraints formulation: 'JacD' is the m x n
+  // Jacobian stored by rows in a contiguous array
+  typedef int (*hiop_eval_Jac_cons_dense_cb)(long long n, long long m,
+					     double* x, int new_x,
+					     double* JacD, void* user_data);
+  // Called at the end of each iteration (not during the line-search); HiOp stops with status
+  // 'User_Stopped' when the callback returns a nonzero value
+  typedef int (*hiop_iterate_cb)(int iter, double obj_value,
+				 long long n, const double* x,
+				 const double* z_L, const double* z_U,
+				 long long m, const double* g, const double* lambda,
+				 double inf_pr, double inf_du, double mu,
+				 void* user_data);
+
   // C struct with HiOp function callbacks
   typedef struct cHiopProblem {
-    hiopNlpMDS *refcppHiop;
-    cppUserProblem *hiopinterface;
+    hiopNlpFormulation *refcppHiop;
+    cppUserProblemState *hiopinterface;
     // user_data similar to the Ipopt interface. In case of Julia pointer to the Julia problem object.
     void *user_data;
-    // Used by hiop_solveProblem() to store the final state. The duals should be added here.
+    // Used by hiop_solveProblem() to store the final state, when not NULL.
     double *solution;
     double obj_value;
     // HiOp callback function wrappers
-    int (*get_starting_point)(long long n_, double* x0, void* user_data); 
-    int (*get_prob_sizes)(long long* n_, long long* m_, void* user_data); 
+    int (*get_starting_point)(long long n_, double* x0, void* user_data);
+    int (*get_prob_sizes)(long long* n_, long long* m_, void* user_data);
     int (*get_vars_info)(long long n, double *xlow_, double* xupp_, void* user_data);
     int (*get_cons_info)(long long m, double *clow_, double* cupp_, void* user_data);
     int (*eval_f)(int n, double* x, int new_x, double* obj, void* user_data);
     int (*eval_grad_f)(long long n, double* x, int new_x, double* gradf, void* user_data);
     int (*eval_cons)(long long n, long long m,
-      double* x, int new_x, 
+      double* x, int new_x,
       double* cons, void* user_data);
+    // used only by the MDS formulation
     int (*get_sparse_dense_blocks_info)(int* nx_sparse, int* nx_dense,
       int* nnz_sparse_Jaceq, int* nnz_sparse_Jacineq,
-      int* nnz_sparse_Hess_Lagr_SS, 
+      int* nnz_sparse_Hess_Lagr_SS,
       int* nnz_sparse_Hess_Lagr_SD, void* user_data);
+    // used only by the MDS formulation
     int (*eval_Jac_cons)(long long n, long long m,
       double* x, int new_x,
-      long long nsparse, long long ndense, 
-      int nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+      long long nsparse, long long ndense,
+      int nnzJacS, int* iJacS, int* jJacS, double* MJacS,
       double* JacD, void *user_data);
+    // used only by the MDS formulation
     int (*eval_Hess_Lagr)(long long n, long long m,
       double* x, int new_x, double obj_factor,
       double* lambda, int new_lambda,
-      long long nsparse, long long ndense, 
-      int nnzHSS, int* iHSS, int* jHSS, double* MHSS, 
+      long long nsparse, long long ndense,
+      int nnzHSS, int* iHSS, int* jHSS, double* MHSS,
       double* HDD,
       int nnzHSD, int* iHSD, int* jHSD, double* MHSD, void* user_data);
   } cHiopProblem;
 }
 
+/** State of a C problem handle besides the NLP formulation: the solver, created by the first
+ * solve and reused by the subsequent ones, and the optional starting point and iterate callback.
+ * The starting point arrays are owned by the caller and are read only when a solve starts.
+ */
+class cppUserProblemState
+{
+public:
+  cppUserProblemState(cHiopProblem *cprob_)
+    : cprob(cprob_), solver(NULL),
+      x0(NULL), zl0(NULL), zu0(NULL), lambda0(NULL),
+      iterate_cb(NULL)
+  {
+  }
+  virtual ~cppUserProblemState()
+  {
+    delete solver;
+  }
+  // Storing the C struct in the CPP object
+  cHiopProblem *cprob;
+  hiopAlgFilterIPMBase *solver;
+  const double *x0, *zl0, *zu0, *lambda0;
+  hiop_iterate_cb iterate_cb;
+};
 
-// The cpp object used in the C interface
-class cppUserProblem : public hiopInterfaceMDS
+// The callbacks common to the formulations supported by the C interface
+template<class IFACE>
+class cppUserProblemBase : public IFACE, public cppUserProblemState
 {
   public:
-    cppUserProblem(cHiopProblem *cprob_)
-      : cprob(cprob_) 
+    cppUserProblemBase(cHiopProblem *cprob_)
+      : cppUserProblemState(cprob_)
     {
     }
-
-    virtual ~cppUserProblem()
+    virtual ~cppUserProblemBase()
     {
     }
     // HiOp callbacks calling the C wrappers
-    bool get_prob_sizes(long long& n_, long long& m_) 
+    bool get_prob_sizes(long long& n_, long long& m_)
     {
       cprob->get_prob_sizes(&n_, &m_, cprob->user_data);
       return true;
     };
-    bool get_starting_point(const long long& n, double *x0)
+    bool get_starting_point(const long long& n, double *x0_)
+    {
+      if(NULL == cprob->get_starting_point) return false;
+      cprob->get_starting_point(n, x0_, cprob->user_data);
+      return true;
+    };
+    bool get_starting_point(const long long& n, const long long& m,
+			    double* x0_,
+			    bool& duals_avail,
+			    double* z_bndL0, double* z_bndU0,
+			    double* lambda0_)
     {
-      cprob->get_starting_point(n, x0, cprob->user_data);
+      //the point set with hiop_setStartingPoint, if any, takes precedence over the callback
+      duals_avail = false;
+      if(NULL == x0) return false;
+      memcpy(x0_, x0, n*sizeof(double));
+      if(NULL!=zl0 && NULL!=zu0 && NULL!=lambda0) {
+	memcpy(z_bndL0, zl0, n*sizeof(double));
+	memcpy(z_bndU0, zu0, n*sizeof(double));
+	memcpy(lambda0_, lambda0, m*sizeof(double));
+	duals_avail = true;
+      }
       return true;
     };
-    bool get_vars_info(const long long& n, double *xlow_, double* xupp_, NonlinearityType* type)
+    bool get_vars_info(const long long& n, double *xlow_, double* xupp_,
+		       hiopInterfaceBase::NonlinearityType* type)
     {
-      for(long long i=0; i<n; ++i) type[i]=hiopNonlinear;
+      for(long long i=0; i<n; ++i) type[i]=hiopInterfaceBase::hiopNonlinear;
       cprob->get_vars_info(n, xlow_, xupp_, cprob->user_data);
       return true;
     };
-    bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)
+    bool get_cons_info(const long long& m, double* clow, double* cupp,
+		       hiopInterfaceBase::NonlinearityType* type)
     {
-      for(long long i=0; i<m; ++i) type[i]=hiopNonlinear;
+      for(long long i=0; i<m; ++i) type[i]=hiopInterfaceBase::hiopNonlinear;
       cprob->get_cons_info(m, clow, cupp, cprob->user_data);
       return true;
     };
     bool eval_f(const long long& n, const double* x, bool new_x, double& obj_value)
     {
-      cprob->eval_f(n, (double *) x, 0, &obj_value, cprob->user_data);
+      cprob->eval_f(n, (double *) x, new_x, &obj_value, cprob->user_data);
       return true;
     };
 
     bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)
     {
-      cprob->eval_grad_f(n, (double *) x, 0, gradf, cprob->user_data);
+      cprob->eval_grad_f(n, (double *) x, new_x, gradf, cprob->user_data);
 
       return true;
     };
     bool eval_cons(const long long& n, const long long& m,
-      const long long& num_cons, const long long* idx_cons,  
-      const double* x, bool new_x, 
+      const long long& num_cons, const long long* idx_cons,
+      const double* x, bool new_x,
       double* cons)
     {
       return false;
     };
-    bool eval_cons(const long long& n, const long long& m, 
+    bool eval_cons(const long long& n, const long long& m,
       const double* x, bool new_x, double* cons)
     {
       cprob->eval_cons(n, m, (double *) x, new_x, cons, cprob->user_data);
       return true;
     };
+    bool iterate_callback(int iter, double obj_value,
+			  int n, const double* x,
+			  const double* z_L,
+			  const double* z_U,
+			  int m, const double* g,
+			  const double* lambda,
+			  double inf_pr, double inf_du,
+			  double mu,
+			  double /*alpha_du*/, double /*alpha_pr*/,
+			  int /*ls_trials*/)
+    {
+      if(NULL == iterate_cb) return true;
+      return 0 == iterate_cb(iter, obj_value, n, x, z_L, z_U, m, g, lambda,
+			     inf_pr, inf_du, mu, cprob->user_data);
+    };
+};
+
+// The cpp object used in the C interface for MDS problems
+class cppUserProblem : public cppUserProblemBase<hiopInterfaceMDS>
+{
+  public:
+    cppUserProblem(cHiopProblem *cprob_)
+      : cppUserProblemBase<hiopInterfaceMDS>(cprob_)
+    {
+    }
+
+    virtual ~cppUserProblem()
+    {
+    }
     bool get_sparse_dense_blocks_info(int& nx_sparse, int& nx_dense,
       int& nnz_sparse_Jaceq, int& nnz_sparse_Jacineq,
-      int& nnz_sparse_Hess_Lagr_SS, 
+      int& nnz_sparse_Hess_Lagr_SS,
       int& nnz_sparse_Hess_Lagr_SD)
     {
-      cprob->get_sparse_dense_blocks_info(&nx_sparse, &nx_dense, &nnz_sparse_Jaceq, &nnz_sparse_Jacineq, 
+      cprob->get_sparse_dense_blocks_info(&nx_sparse, &nx_dense, &nnz_sparse_Jaceq, &nnz_sparse_Jacineq,
                                           &nnz_sparse_Hess_Lagr_SS, &nnz_sparse_Hess_Lagr_SD, cprob->user_data);
       return true;
     };
     bool eval_Jac_cons(const long long& n, const long long& m,
       const long long& num_cons, const long long* idx_cons,
       const double* x, bool new_x,
-      const long long& nsparse, const long long& ndense, 
-      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+      const long long& nsparse, const long long& ndense,
+      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
       double** JacD)
     {
       return false;
     };
     bool eval_Jac_cons(const long long& n, const long long& m,
       const double* x, bool new_x,
-      const long long& nsparse, const long long& ndense, 
-      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
+      const long long& nsparse, const long long& ndense,
+      const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS,
       double** JacD)
     {
-      cprob->eval_Jac_cons(n, m, (double *) x, new_x, nsparse, ndense, 
+      cprob->eval_Jac_cons(n, m, (double *) x, new_x, nsparse, ndense,
                                           nnzJacS, iJacS, jJacS, MJacS, &JacD[0][0], cprob->user_data);
       return true;
     };
     bool eval_Hess_Lagr(const long long& n, const long long& m,
       const double* x, bool new_x, const double& obj_factor,
       const double* lambda, bool new_lambda,
-      const long long& nsparse, const long long& ndense, 
-      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS, 
+      const long long& nsparse, const long long& ndense,
+      const int& nnzHSS, int* iHSS, int* jHSS, double* MHSS,
       double** HDD,
       int& nnzHSD, int* iHSD, int* jHSD, double* MHSD)
     {
-      //Note: lambda is not used since all the constraints are linear and, therefore, do 
-      //not contribute to the Hessian of the Lagrangian
       cprob->eval_Hess_Lagr(n, m, (double *) x, new_x, obj_factor, (double *) lambda, new_lambda, nsparse, ndense,
-                                          nnzHSS, iHSS, jHSS, MHSS, 
-                                          &HDD[0][0], 
+                                          nnzHSS, iHSS, jHSS, MHSS,
+                                          &HDD[0][0],
                                           nnzHSD, iHSD, jHSD, MHSD, cprob->user_data);
       return true;
     };
+};
+
+// The cpp object used in the C interface for problems with dense constraints
+class cppUserProblemDenseCons : public cppUserProblemBase<hiopInterfaceDenseConstraints>
+{
+  public:
+    cppUserProblemDenseCons(cHiopProblem *cprob_, hiop_eval_Jac_cons_dense_cb eval_Jac_cons_)
+      : cppUserProblemBase<hiopInterfaceDenseConstraints>(cprob_), eval_Jac_cons_dense(eval_Jac_cons_)
+    {
+    }
+
+    virtual ~cppUserProblemDenseCons()
+    {
+    }
+    bool eval_Jac_cons(const long long& /*n*/, const long long& /*m*/,
+      const long long& /*num_cons*/, const long long* /*idx_cons*/,
+      const double* /*x*/, bool /*new_x*/,
+      double** /*Jac*/)
+    {
+      return false;
+    };
+    bool eval_Jac_cons(const long long& n, const long long& m,
+      const double* x, bool new_x,
+      double** Jac)
+    {
+      eval_Jac_cons_dense(n, m, (double *) x, new_x, &Jac[0][0], cprob->user_data);
+      return true;
+    };
 private:
-  // Storing the C struct in the CPP object
-  cHiopProblem *cprob;
+  hiop_eval_Jac_cons_dense_cb eval_Jac_cons_dense;
 };
 
-/** The 3 essential function calls to create and destroy a problem object in addition to solve a problem.
- * Some option setters will be added in the future.
+/** Creation and destruction of a problem handle, for the MDS formulation and for the formulation
+ * with dense constraints (which uses the callbacks of 'cHiopProblem' except the MDS ones and takes
+ * the dense Jacobian callback as argument). All functions return 0 on success.
  */
 extern "C" int hiop_createProblem(cHiopProblem *problem);
-extern "C" int hiop_solveProblem(cHiopProblem *problem);
+extern "C" int hiop_createDenseConsProblem(cHiopProblem *problem,
+					   hiop_eval_Jac_cons_dense_cb eval_Jac_cons);
 extern "C" int hiop_destroyProblem(cHiopProblem *problem);
-#endif
\ No newline at end of file
+
+/** Option setters; same names and values as in the 'hiop.options' file, which takes precedence. */
+extern "C" int hiop_setNumericOption(cHiopProblem *problem, const char* name, double value);
+extern "C" int hiop_setIntegerOption(cHiopProblem *problem, const char* name, int value);
+extern "C" int hiop_setStringOption(cHiopProblem *problem, const char* name, const char* value);
+
+/** Starting point used by the subsequent solves instead of the 'get_starting_point' callback,
+ * until called again. The duals 'zl0', 'zu0', and 'lambda0' are used only when all three are not
+ * NULL; 'x0' equal to NULL reverts to the callback. The arrays are not copied and should remain
+ * valid until the solves start. */
+extern "C" int hiop_setStartingPoint(cHiopProblem *problem, const double* x0,
+				     const double* zl0, const double* zu0, const double* lambda0);
+/** Iterate callback (NULL to remove it) */
+extern "C" int hiop_setIterateCallback(cHiopProblem *problem, hiop_iterate_cb iterate_callback);
+
+/** Solves the problem; creates the solver at the first call and reuses it at subsequent calls.
+ * Returns the solve status (a hiopSolveStatus value, negative on failure) and sets 'obj_value'
+ * and, when not NULL, 'solution'. */
+extern "C" int hiop_solveProblem(cHiopProblem *problem);
+
+/** Solution, duals of the bounds ('zl' and 'zu', of size n) and of the constraints ('lambda', of
+ * size m, in the user's order) of the last solve, in caller-owned arrays */
+extern "C" int hiop_getSolution(cHiopProblem *problem, double* x);
+extern "C" int hiop_getDualSolutions(cHiopProblem *problem, double* zl, double* zu, double* lambda);
+/** Number of iterations of the last solve */
+extern "C" int hiop_getNumIterations(cHiopProblem *problem);
+#endif
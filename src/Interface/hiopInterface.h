@@ -1,11 +1,25 @@
-// The C interface header used by the user. This needs a detailed user documentation.
+// The C interface header used by the user. See chiopInterface.hpp for the documentation of the
+// functions below.
+
+// Jacobian of the constraints for the dense constraints formulation: 'JacD' is the m x n Jacobian
+// stored by rows in a contiguous array
+typedef int (*hiop_eval_Jac_cons_dense_cb)(long long n, long long m,
+                                           double* x, int new_x,
+                                           double* JacD, void* user_data);
+// Called at the end of each iteration; HiOp stops when the callback returns a nonzero value
+typedef int (*hiop_iterate_cb)(int iter, double obj_value,
+                               long long n, const double* x,
+                               const double* z_L, const double* z_U,
+                               long long m, const double* g, const double* lambda,
+                               double inf_pr, double inf_du, double mu,
+                               void* user_data);
 
 typedef struct cHiopProblem {
   void *refcppHiop; // Pointer to the cpp object
   void *hiopinterface;
   // user_data similar to the Ipopt interface. In case of Julia pointer to the Julia problem object.
   void *user_data; 
-  double *solution;
+  double *solution; // set by hiop_solveProblem when not NULL
   double obj_value;
   int (*get_starting_point)(long long n_, double* x0, void* jprob); 
   int (*get_prob_sizes)(long long* n_, long long* m_, void* jprob); 
@@ -16,6 +30,7 @@ typedef struct cHiopProblem {
   int (*eval_cons)(long long n, long long m,
     double* x, int new_x, 
     double* cons, void* jprob);
+  // the next three are used only by the MDS formulation
   int (*get_sparse_dense_blocks_info)(int* nx_sparse, int* nx_dense,
     int* nnz_sparse_Jaceq, int* nnz_sparse_Jacineq,
     int* nnz_sparse_Hess_Lagr_SS, 
@@ -34,5 +49,16 @@ typedef struct cHiopProblem {
     int nnzHSD, int* iHSD, int* jHSD, double* MHSD, void* jprob);
 } cHiopProblem;
 extern int hiop_createProblem(cHiopProblem *problem);
+extern int hiop_createDenseConsProblem(cHiopProblem *problem,
+                                       hiop_eval_Jac_cons_dense_cb eval_Jac_cons);
+extern int hiop_destroyProblem(cHiopProblem *problem);
+extern int hiop_setNumericOption(cHiopProblem *problem, const char* name, double value);
+extern int hiop_setIntegerOption(cHiopProblem *problem, const char* name, int value);
+extern int hiop_setStringOption(cHiopProblem *problem, const char* name, const char* value);
+extern int hiop_setStartingPoint(cHiopProblem *problem, const double* x0,
+                                 const double* zl0, const double* zu0, const double* lambda0);
+extern int hiop_setIterateCallback(cHiopProblem *problem, hiop_iterate_cb iterate_callback);
 extern int hiop_solveProblem(cHiopProblem *problem);
-extern int hiop_destroyProblem(cHiopProblem *problem);
\ No newline at end of file
+extern int hiop_getSolution(cHiopProblem *problem, double* x);
+extern int hiop_getDualSolutions(cHiopProblem *problem, double* zl, double* zu, double* lambda);
+extern int hiop_getNumIterations(cHiopProblem *problem);
\ No newline at end of file
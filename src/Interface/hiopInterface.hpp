@@ -136,7 +136,10 @@ public:
    *  (xlow<=-1e20 means no lower bound, xupp>=1e20 means no upper bound) */
   virtual bool get_vars_info(const long long& n, double *xlow, double* xupp, NonlinearityType* type)=0;
   /** bounds on the constraints 
-   *  (clow<=-1e20 means no lower bound, cupp>=1e20 means no upper bound) */
+   *  (clow<=-1e20 means no lower bound, cupp>=1e20 means no upper bound) 
+   *  Constraints flagged as 'hiopLinear' in 'type' have constant Jacobian rows and zero Hessian;
+   *  with option 'cache_linear_jac' set to 'yes' HiOp evaluates their Jacobian rows only once.
+   */
   virtual bool get_cons_info(const long long& m, double* clow, double* cupp, NonlinearityType* type)=0;
 
   /** Objective function evaluation
@@ -148,6 +151,17 @@ public:
    *  When MPI enabled, each rank works only with local buffers x and gradf.
    */
   virtual bool eval_grad_f(const long long& n, const double* x, bool new_x, double* gradf)=0;
+  /** Evaluates the objective and its gradient in one call. Optional: implementers whose objective 
+   *  and gradient come from the same computation (e.g., an adjoint or a reverse-mode AD sweep) 
+   *  can provide it to avoid doing the computation twice or caching it based on 'new_x'.
+   *
+   *  HiOp calls this method once; if it returns false, HiOp uses 'eval_f' and 'eval_grad_f' above
+   *  for the rest of the solve. Otherwise HiOp uses it whenever both the objective and the 
+   *  gradient are needed at a point, as well as when only the gradient is needed (the objective 
+   *  is then discarded).
+   */
+  virtual bool eval_f_grad_f(const long long& /*n*/, const double* /*x*/, bool /*new_x*/, 
+			     double& /*obj_value*/, double* /*gradf*/) { return false; }
 
   /** Evaluates a subset of the constraints cons(x) (where clow<=cons(x)<=cupp). The subset is of size
    *  'num_cons' and is described by indexes in the 'idx_cons' array. The method will be called at each
@@ -187,7 +201,15 @@ public:
 			 const double* x, bool new_x, 
 			 double* cons) { return false; }
   
-  /** pass the communicator, defaults to MPI_COMM_WORLD (dummy for non-MPI builds)  */
+  /** 
+   * Indicates whether 'eval_f' and 'eval_cons' can be called concurrently from multiple threads 
+   * (at different points x and with new_x=true). When this method returns true, HiOp may evaluate 
+   * several trial points of the line search at once (see option 'linesearch_batch'). Defaults to false.
+   */
+  virtual bool eval_funcs_thread_safe() { return false; }
+
+  /** pass the communicator, defaults to MPI_COMM_WORLD (dummy for non-MPI builds). Problems solved
+   *  concurrently on different threads of a process should each pass their own communicator. */
   virtual bool get_MPI_comm(MPI_Comm& comm_out) { comm_out=MPI_COMM_WORLD; return true;}
 
   /**  
@@ -326,6 +348,18 @@ public:
   			     const double* x, bool new_x,
   			     double** Jac) { return false; }
 
+  /** Evaluates the constraints and their Jacobian in one call (optional). Parameters are the ones
+   * of the one-call 'eval_cons' and 'eval_Jac_cons' above. 
+   * 
+   * HiOp calls this method once; if it returns false, HiOp evaluates the constraints and the 
+   * Jacobian with the methods above for the rest of the solve. Otherwise HiOp uses it whenever
+   * both the constraints and the Jacobian are needed at a point, as well as when only the 
+   * Jacobian is needed (the constraints are then discarded).
+   */
+  virtual bool eval_cons_Jac_cons(const long long& /*n*/, const long long& /*m*/,
+				  const double* /*x*/, bool /*new_x*/,
+				  double* /*cons*/, double** /*Jac*/) { return false; }
+
   
 };
 
@@ -433,6 +467,21 @@ public:
 			     const int& nnzJacS, int* iJacS, int* jJacS, double* MJacS, 
 			     double** JacD){ return false; }
 
+  /** Evaluates the constraints and their MDS Jacobian in one call (optional). Parameters are the 
+   * ones of the one-call 'eval_cons' and 'eval_Jac_cons' above; notes 1)-5) above apply.
+   *
+   * HiOp calls this method once; if it returns false, HiOp evaluates the constraints and the 
+   * Jacobian with the methods above for the rest of the solve. Otherwise HiOp uses it whenever
+   * both the constraints and the Jacobian are needed at a point, as well as when only the 
+   * Jacobian is needed (the constraints are then discarded).
+   */
+  virtual bool eval_cons_Jac_cons(const long long& /*n*/, const long long& /*m*/, 
+				  const double* /*x*/, bool /*new_x*/,
+				  double* /*cons*/,
+				  const long long& /*nsparse*/, const long long& /*ndense*/, 
+				  const int& /*nnzJacS*/, int* /*iJacS*/, int* /*jJacS*/, double* /*MJacS*/, 
+				  double** /*JacD*/) { return false; }
+
   
   /** Evaluates the Hessian of the Lagrangian function in 3 structural blocks
    * - HSS is the Hessian w.r.t.(xs,xs)
@@ -62,14 +62,16 @@ namespace hiop {
   }
 
   
-  hiopLinSolverIndefDense::hiopLinSolverIndefDense(int n, hiopNlpFormulation* nlp)
-    : M(n,n)
+  hiopLinSolverIndefDense::hiopLinSolverIndefDense(int n, hiopNlpFormulation* nlp, bool packed)
+    : M(packed ? *new hiopMatrixSymDensePacked(n) : *new hiopMatrixDenseRowMajor(n,n)),
+      packed_(packed)
   {
     nlp_ = nlp;
     perf_report_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
   }
   hiopLinSolverIndefDense::~hiopLinSolverIndefDense()
   { 
+    delete &M;
   }
 
 }
@@ -97,14 +97,21 @@ public:
 class hiopLinSolverIndefDense : public hiopLinSolver
 {
 public:
-  hiopLinSolverIndefDense(int n, hiopNlpFormulation* nlp);
+  /** 
+   * The system matrix is a full n x n dense matrix, or, when 'packed' is true, a 
+   * hiopMatrixSymDensePacked holding only the upper triangle (n*(n+1)/2 elements). 
+   */
+  hiopLinSolverIndefDense(int n, hiopNlpFormulation* nlp, bool packed=false);
   virtual ~hiopLinSolverIndefDense();
 
   inline hiopMatrixDenseRowMajor& sysMatrix() { return M; }
+  inline bool packed_storage() const { return packed_; }
 protected:
-  hiopMatrixDenseRowMajor M;
+  //allocated and owned by this class
+  hiopMatrixDenseRowMajor& M;
+  bool packed_;
 protected:
-  hiopLinSolverIndefDense() : M(0,0) { assert(false); }
+  hiopLinSolverIndefDense() : M(*new hiopMatrixDenseRowMajor(0,0)), packed_(false) { assert(false); }
 };
 
 } //end namespace
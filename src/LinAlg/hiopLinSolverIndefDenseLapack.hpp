@@ -53,12 +53,15 @@
 
 namespace hiop {
 
-/** Wrapper for LAPACK's DSYTRF */
+/** 
+ * Wrapper for LAPACK's DSYTRF, or for DSPTRF when the system matrix is stored packed 
+ * (option 'kkt_dense_storage')
+ */
 class hiopLinSolverIndefDenseLapack : public hiopLinSolverIndefDense
 {
 public:
   hiopLinSolverIndefDenseLapack(int n, hiopNlpFormulation* nlp)
-    : hiopLinSolverIndefDense(n, nlp)
+    : hiopLinSolverIndefDense(n, nlp, "packed"==nlp->options->GetString("kkt_dense_storage"))
   {
     ipiv = new int[n];
     dwork = LinearAlgebraFactory::createVector(0);
@@ -82,29 +85,35 @@ public:
     double dwork_tmp;
     char uplo='L'; // M is upper in C++ so it's lower in fortran
 
-    //
-    //query sizes
-    //
-    int lwork=-1;
-    DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, &dwork_tmp, &lwork, &info );
-    assert(info==0);
+    if(packed_) {
+      //
+      // factorization of the packed matrix (needs no workspace)
+      //
+      DSPTRF(&uplo, &N, M.local_buffer(), ipiv, &info);
+    } else {
+      //
+      //query sizes
+      //
+      int lwork=-1;
+      DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, &dwork_tmp, &lwork, &info );
+      assert(info==0);
 
-    lwork=(int)dwork_tmp;
-    if(lwork != dwork->get_size()) {
-      delete dwork;
-      dwork = NULL;
-      dwork = LinearAlgebraFactory::createVector(lwork);
-    }
+      lwork=(int)dwork_tmp;
+      if(lwork != dwork->get_size()) {
+        delete dwork;
+        dwork = NULL;
+        dwork = LinearAlgebraFactory::createVector(lwork);
+      }
 
-    bool rank_deficient=false;
-    //
-    // factorization
-    //
-    DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, dwork->local_data(), &lwork, &info );
+      //
+      // factorization
+      //
+      DSYTRF(&uplo, &N, M.local_buffer(), &lda, ipiv, dwork->local_data(), &lwork, &info );
+    }
     if(info<0) {
       nlp_->log->printf(hovError,
-		       "hiopLinSolverIndefDense error: %d argument to dsytrf has an illegal value.\n",
-		       -info);
+		       "hiopLinSolverIndefDense error: %d argument to %s has an illegal value.\n",
+		       -info, packed_ ? "dsptrf" : "dsytrf");
       return -1;
     } else {
       if(info>0) {
@@ -125,6 +134,7 @@ public:
     // Code originally written by M. Schanenfor PIPS based on
     // LINPACK's dsidi Fortran routine (http://www.netlib.org/linpack/dsidi.f)
     // 04/08/2020 - petra: fixed the test for non-positive pivots (was only for negative pivots)
+    // The row pointers of the packed storage address the entries of D the same way.
     int negEigVal=0;
     int posEigVal=0;
     int nullEigVal=0;
@@ -184,11 +194,17 @@ public:
 
     char uplo='L'; // M is upper in C++ so it's lower in fortran
     int NRHS=1, LDB=N;
-    DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, x->local_data(), &LDB, &info);
+    if(packed_) {
+      DSPTRS(&uplo, &N, &NRHS, M.local_buffer(), ipiv, x->local_data(), &LDB, &info);
+    } else {
+      DSYTRS(&uplo, &N, &NRHS, M.local_buffer(), &LDA, ipiv, x->local_data(), &LDB, &info);
+    }
     if(info<0) {
-      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned error %d\n", info);
+      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: %s returned error %d\n",
+			packed_ ? "DSPTRS" : "DSYTRS", info);
     } else if(info>0) {
-      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: DSYTRS returned warning %d\n", info);
+      nlp_->log->printf(hovError, "hiopLinSolverIndefDenseLapack: %s returned warning %d\n",
+			packed_ ? "DSPTRS" : "DSYTRS", info);
     }
     nlp_->runStats.linsolv.tmTriuSolves.stop();
     return info==0;
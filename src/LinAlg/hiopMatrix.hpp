@@ -51,6 +51,7 @@
 
 #include <cstdio>
 #include "hiop_defs.hpp"
+#include "hiopCppStdUtils.hpp"
 
 namespace hiop
 {
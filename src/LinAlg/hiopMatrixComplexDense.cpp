@@ -94,7 +94,7 @@ namespace hiop
 					    const long long* rows_idxs,
 					    long long n_rows)
   {
-    const hiopMatrixComplexDense& src = dynamic_cast<const hiopMatrixComplexDense&>(src_gen);
+    const hiopMatrixComplexDense& src = known_cast<const hiopMatrixComplexDense&>(src_gen);
     assert(n_global_==src.n_global_);
     assert(n_local_==src.n_local_);
     assert(n_rows<=src.m_local_);
@@ -236,7 +236,7 @@ namespace hiop
 
   void hiopMatrixComplexDense::addMatrix(double alpha, const hiopMatrix& X_)
   {
-    const hiopMatrixComplexDense& X = dynamic_cast<const hiopMatrixComplexDense&>(X_); 
+    const hiopMatrixComplexDense& X = known_cast<const hiopMatrixComplexDense&>(X_); 
     addMatrix(std::complex<double>(alpha,0), X);    
   }
   void hiopMatrixComplexDense::addMatrix(const std::complex<double>& alpha, const hiopMatrixComplexDense& X)
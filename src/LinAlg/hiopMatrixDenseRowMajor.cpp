@@ -55,6 +55,7 @@
 #include <cassert>
 
 #include "hiop_blasdefs.hpp"
+#include "hiopCommProfiler.hpp"
 
 #include "hiopVectorPar.hpp"
 
@@ -84,24 +85,34 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const long long& m,
   if(max_rows_==-1) max_rows_=m_local_;
   assert(max_rows_>=m_local_ && "the requested extra allocation is smaller than the allocation needed by the matrix");
 
+  pool_ = buff_pool_ = NULL;
   M_=new double*[max_rows_==0?1:max_rows_];
-  M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  M_[0] = max_rows_==0?NULL:hiopMemoryPool::allocate(max_rows_*n_local_, pool_);
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
 
   //! valgrind reports a shit load of errors without this; check this
-  for(int i=0; i<max_rows_*n_local_; i++) M_[0][i]=0.0;
+  //(done with the thread partitioning of the first touch, see hiopMemoryPool)
+  if(M_[0]) hiopMemoryPool::first_touch(M_[0], max_rows_*n_local_);
 
   //internal buffers 
   buff_mxnlocal_ = NULL;//new double[max_rows_*n_local_];
+
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, max_rows_*n_local_*sizeof(double));
 }
 hiopMatrixDenseRowMajor::~hiopMatrixDenseRowMajor()
 {
-  if(buff_mxnlocal_) delete[] buff_mxnlocal_;
+  if(buff_mxnlocal_) {
+    hiopMemoryPool::deallocate(buff_mxnlocal_, max_rows_*n_local_, buff_pool_);
+    mem_tracker_->remove(mem_cat_, max_rows_*n_local_*sizeof(double));
+  }
   if(M_) {
-    if(M_[0]) delete[] M_[0];
+    if(M_[0]) hiopMemoryPool::deallocate(M_[0], max_rows_*n_local_, pool_);
     delete[] M_;
   }
+  mem_tracker_->remove(mem_cat_, max_rows_*n_local_*sizeof(double));
 }
 
 /// TODO: check again
@@ -113,14 +124,19 @@ hiopMatrixDenseRowMajor::hiopMatrixDenseRowMajor(const hiopMatrixDenseRowMajor&
 
   //M=new double*[m_local_==0?1:m_local_];
   max_rows_ = dm.max_rows_;
+  pool_ = buff_pool_ = NULL;
   M_=new double*[max_rows_==0?1:max_rows_];
   //M[0] = m_local_==0?NULL:new double[m_local_*n_local_];
-  M_[0] = max_rows_==0?NULL:new double[max_rows_*n_local_];
+  M_[0] = max_rows_==0?NULL:hiopMemoryPool::allocate(max_rows_*n_local_, pool_);
   //for(int i=1; i<m_local_; i++)
   for(int i=1; i<max_rows_; i++)
     M_[i]=M_[0]+i*n_local_;
 
   buff_mxnlocal_ = NULL;
+
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, max_rows_*n_local_*sizeof(double));
 }
 
 void hiopMatrixDenseRowMajor::appendRow(const hiopVector& row)
@@ -135,7 +151,7 @@ void hiopMatrixDenseRowMajor::appendRow(const hiopVector& row)
 
 void hiopMatrixDenseRowMajor::copyFrom(const hiopMatrixDense& dmmat)
 {
-  const auto& dm = dynamic_cast<const hiopMatrixDenseRowMajor&>(dmmat);
+  const auto& dm = known_cast<const hiopMatrixDenseRowMajor&>(dmmat);
   assert(n_local_==dm.n_local_); assert(m_local_==dm.m_local_); assert(n_global_==dm.n_global_);
   assert(glob_jl_==dm.glob_jl_); assert(glob_ju_==dm.glob_ju_);
   if(NULL==dm.M_[0]) {
@@ -156,7 +172,7 @@ void hiopMatrixDenseRowMajor::copyFrom(const double* buffer)
 
 void hiopMatrixDenseRowMajor::copyRowsFrom(const hiopMatrixDense& srcmat, int num_rows, int row_dest)
 {
-  const auto& src = dynamic_cast<const hiopMatrixDenseRowMajor&>(srcmat);
+  const auto& src = known_cast<const hiopMatrixDenseRowMajor&>(srcmat);
 #ifdef HIOP_DEEPCHECKS
   assert(row_dest>=0);
   assert(n_global_==src.n_global_);
@@ -170,18 +186,21 @@ void hiopMatrixDenseRowMajor::copyRowsFrom(const hiopMatrixDense& srcmat, int nu
 
 void hiopMatrixDenseRowMajor::copyRowsFrom(const hiopMatrix& src_gen, const long long* rows_idxs, long long n_rows)
 {
-  const auto& src = dynamic_cast<const hiopMatrixDenseRowMajor&>(src_gen);
+  const auto& src = known_cast<const hiopMatrixDenseRowMajor&>(src_gen);
   assert(n_global_==src.n_global_);
   assert(n_local_==src.n_local_);
   assert(n_rows<=src.m_local_);
   assert(n_rows == m_local_);
 
-  // todo //! opt -> copy multiple (consecutive rows at the time -> maybe keep blocks of eq and ineq,
-  //instead of indexes)
-
+  //runs of consecutive source rows are copied at once (the rows of both matrices are contiguous);
+  //for constraints grouped as equalities and inequalities this is one copy per matrix
   //int i should suffice for dense matrices
-  for(int i=0; i<n_rows; ++i) {
-    memcpy(M_[i], src.M_[rows_idxs[i]], n_local_*sizeof(double));
+  int i=0;
+  while(i<n_rows) {
+    int run=1;
+    while(i+run<n_rows && rows_idxs[i+run]==rows_idxs[i]+run) run++;
+    memcpy(M_[i], src.M_[rows_idxs[i]], ((size_t)run)*n_local_*sizeof(double));
+    i += run;
   }
 }
 
@@ -189,7 +208,7 @@ void hiopMatrixDenseRowMajor::copyRowsFrom(const hiopMatrix& src_gen, const long
 void hiopMatrixDenseRowMajor::copyBlockFromMatrix(const long i_start, const long j_start,
 					  const hiopMatrixDense& srcmat)
 {
-  const auto& src = dynamic_cast<const hiopMatrixDenseRowMajor&>(srcmat);
+  const auto& src = known_cast<const hiopMatrixDenseRowMajor&>(srcmat);
   assert(n_local_==n_global_ && "this method should be used only in 'serial' mode");
   assert(src.n_local_==src.n_global_ && "this method should be used only in 'serial' mode");
   assert(m_local_>=i_start+src.m_local_ && "the matrix does not fit as a sublock in 'this' at specified coordinates");
@@ -210,7 +229,7 @@ void hiopMatrixDenseRowMajor::copyBlockFromMatrix(const long i_start, const long
 
 void hiopMatrixDenseRowMajor::copyFromMatrixBlock(const hiopMatrixDense& srcmat, const int i_block, const int j_block)
 {
-  const auto& src = dynamic_cast<const hiopMatrixDenseRowMajor&>(srcmat);
+  const auto& src = known_cast<const hiopMatrixDenseRowMajor&>(srcmat);
   assert(n_local_==n_global_ && "this method should be used only in 'serial' mode");
   assert(src.n_local_==src.n_global_ && "this method should be used only in 'serial' mode");
   assert(m_local_+i_block<=src.m_local_ && "the source does not enough rows to fill 'this'");
@@ -275,7 +294,7 @@ void hiopMatrixDenseRowMajor::replaceRow(long long row, const hiopVector& vec)
 void hiopMatrixDenseRowMajor::getRow(long long irow, hiopVector& row_vec)
 {
   assert(irow>=0); assert(irow<m_local_);
-  hiopVectorPar& vec=dynamic_cast<hiopVectorPar&>(row_vec);
+  hiopVectorPar& vec=known_cast<hiopVectorPar&>(row_vec);
   assert(n_local_==vec.get_local_size());
   memcpy(vec.local_data(), M_[irow], n_local_*sizeof(double));
 }
@@ -381,8 +400,8 @@ void hiopMatrixDenseRowMajor::print(FILE* f,
 void hiopMatrixDenseRowMajor::timesVec(double beta, hiopVector& y_,
 			       double alpha, const hiopVector& x_) const
 {
-  hiopVectorPar& y = dynamic_cast<hiopVectorPar&>(y_);
-  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  hiopVectorPar& y = known_cast<hiopVectorPar&>(y_);
+  const hiopVectorPar& x = known_cast<const hiopVectorPar&>(x_);
 #ifdef HIOP_DEEPCHECKS
   assert(y.get_local_size() == m_local_);
   assert(y.get_size() == m_local_); //y should not be distributed
@@ -431,7 +450,7 @@ void hiopMatrixDenseRowMajor::timesVec(double beta,  double* ya,
 #ifdef HIOP_USE_MPI
   //here m_local_ is > 0
   double yglob[m_local_]; 
-  int ierr=MPI_Allreduce(ya, yglob, m_local_, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(ya, yglob, m_local_, MPI_DOUBLE, MPI_SUM, comm_, "mat_timesVec"); assert(MPI_SUCCESS==ierr);
   memcpy(ya, yglob, m_local_*sizeof(double));
 #endif
 
@@ -441,8 +460,8 @@ void hiopMatrixDenseRowMajor::timesVec(double beta,  double* ya,
 void hiopMatrixDenseRowMajor::transTimesVec(double beta, hiopVector& y_,
 				    double alpha, const hiopVector& x_) const
 {
-  hiopVectorPar& y = dynamic_cast<hiopVectorPar&>(y_);
-  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  hiopVectorPar& y = known_cast<hiopVectorPar&>(y_);
+  const hiopVectorPar& x = known_cast<const hiopVectorPar&>(x_);
 #ifdef HIOP_DEEPCHECKS
   assert(x.get_local_size() == m_local_);
   assert(x.get_size() == m_local_); //x should not be distributed
@@ -486,8 +505,8 @@ void hiopMatrixDenseRowMajor::timesMat(double beta, hiopMatrix& W_, double alpha
 #ifndef HIOP_USE_MPI
   timesMat_local(beta,W_,alpha,X_);
 #else
-  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_); double** WM=W.local_data();
-  const auto& X =  dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
+  auto& W = known_cast<hiopMatrixDenseRowMajor&>(W_); double** WM=W.local_data();
+  const auto& X =  known_cast<const hiopMatrixDenseRowMajor&>(X_);
   
   assert(W.m()==this->m());
   assert(X.m()==this->n());
@@ -523,8 +542,8 @@ void hiopMatrixDenseRowMajor::timesMat(double beta, hiopMatrix& W_, double alpha
  */
 void hiopMatrixDenseRowMajor::timesMat_local(double beta, hiopMatrix& W_, double alpha, const hiopMatrix& X_) const
 {
-  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
-  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_);
+  const auto& X = known_cast<const hiopMatrixDenseRowMajor&>(X_);
+  auto& W = known_cast<hiopMatrixDenseRowMajor&>(W_);
 #ifdef HIOP_DEEPCHECKS  
   assert(W.m()==this->m());
   assert(X.m()==this->n());
@@ -558,8 +577,8 @@ void hiopMatrixDenseRowMajor::timesMat_local(double beta, hiopMatrix& W_, double
  */
 void hiopMatrixDenseRowMajor::transTimesMat(double beta, hiopMatrix& W_, double alpha, const hiopMatrix& X_) const
 {
-  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
-  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_);
+  const auto& X = known_cast<const hiopMatrixDenseRowMajor&>(X_);
+  auto& W = known_cast<hiopMatrixDenseRowMajor&>(W_);
 
   assert(W.m()==n_local_);
   assert(X.m()==m_local_);
@@ -586,8 +605,8 @@ void hiopMatrixDenseRowMajor::transTimesMat(double beta, hiopMatrix& W_, double
  */
 void hiopMatrixDenseRowMajor::timesMatTrans_local(double beta, hiopMatrix& W_, double alpha, const hiopMatrix& X_) const
 {
-  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
-  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_);
+  const auto& X = known_cast<const hiopMatrixDenseRowMajor&>(X_);
+  auto& W = known_cast<hiopMatrixDenseRowMajor&>(W_);
 #ifdef HIOP_DEEPCHECKS
   assert(W.m()==m_local_);
   //assert(X.n()==n_local_);
@@ -616,10 +635,10 @@ void hiopMatrixDenseRowMajor::timesMatTrans_local(double beta, hiopMatrix& W_, d
 /* W = beta*W + alpha*this*X^T */
 void hiopMatrixDenseRowMajor::timesMatTrans(double beta, hiopMatrix& W_, double alpha, const hiopMatrix& X_) const
 {
-  auto& W = dynamic_cast<hiopMatrixDenseRowMajor&>(W_); 
+  auto& W = known_cast<hiopMatrixDenseRowMajor&>(W_); 
   assert(W.n_local_==W.n_global_ && "not intended for the case when the result matrix is distributed.");
 #ifdef HIOP_DEEPCHECKS
-  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_);
+  const auto& X = known_cast<const hiopMatrixDenseRowMajor&>(X_);
   assert(W.isfinite());
   assert(X.isfinite());
   assert(this->n()==X.n());
@@ -637,13 +656,13 @@ void hiopMatrixDenseRowMajor::timesMatTrans(double beta, hiopMatrix& W_, double
   int n2Red=W.m()*W.n(); 
   double** WM=W.local_data();
   double* Wglob= W.new_mxnlocal_buff(); 
-  int ierr = MPI_Allreduce(WM[0], Wglob, n2Red, MPI_DOUBLE, MPI_SUM, comm_); assert(ierr==MPI_SUCCESS);
+  int ierr = hiopAllreduce(WM[0], Wglob, n2Red, MPI_DOUBLE, MPI_SUM, comm_, "mat_timesMatTrans"); assert(ierr==MPI_SUCCESS);
   memcpy(WM[0], Wglob, n2Red*sizeof(double));
 #endif
 }
 void hiopMatrixDenseRowMajor::addDiagonal(const double& alpha, const hiopVector& d_)
 {
-  const hiopVectorPar& d = dynamic_cast<const hiopVectorPar&>(d_);
+  const hiopVectorPar& d = known_cast<const hiopVectorPar&>(d_);
 #ifdef HIOP_DEEPCHECKS
   assert(d.get_size()==n());
   assert(d.get_size()==m());
@@ -659,7 +678,7 @@ void hiopMatrixDenseRowMajor::addDiagonal(const double& value)
 }
 void hiopMatrixDenseRowMajor::addSubDiagonal(const double& alpha, long long start, const hiopVector& d_)
 {
-  const hiopVectorPar& d = dynamic_cast<const hiopVectorPar&>(d_);
+  const hiopVectorPar& d = known_cast<const hiopVectorPar&>(d_);
   long long dlen=d.get_size();
 #ifdef HIOP_DEEPCHECKS
   assert(start>=0);
@@ -676,7 +695,7 @@ void hiopMatrixDenseRowMajor::addSubDiagonal(const double& alpha, long long star
 void hiopMatrixDenseRowMajor::addSubDiagonal(int start_on_dest_diag, const double& alpha, 
 				     const hiopVector& d_, int start_on_src_vec, int num_elems/*=-1*/)
 {
-  const hiopVectorPar& d = dynamic_cast<const hiopVectorPar&>(d_);
+  const hiopVectorPar& d = known_cast<const hiopVectorPar&>(d_);
   if(num_elems<0) num_elems = d.get_size()-start_on_src_vec;
   assert(num_elems <= d.get_size());
   assert(n_local_ == n_global_ && "method supported only for non-distributed matrices");
@@ -704,7 +723,7 @@ void hiopMatrixDenseRowMajor::addSubDiagonal(int start_on_dest_diag, int num_ele
 
 void hiopMatrixDenseRowMajor::addMatrix(double alpha, const hiopMatrix& X_)
 {
-  const auto& X = dynamic_cast<const hiopMatrixDenseRowMajor&>(X_); 
+  const auto& X = known_cast<const hiopMatrixDenseRowMajor&>(X_); 
 #ifdef HIOP_DEEPCHECKS
   assert(m_local_==X.m_local_);
   assert(n_local_==X.n_local_);
@@ -789,7 +808,7 @@ double hiopMatrixDenseRowMajor::max_abs_value()
   double maxv = DLANGE(&norm, &n_local_, &m_local_, M_[0], &n_local_, NULL);
 #ifdef HIOP_USE_MPI
   double maxvg;
-  int ierr=MPI_Allreduce(&maxv,&maxvg,1,MPI_DOUBLE,MPI_MAX,comm_); assert(ierr==MPI_SUCCESS);
+  int ierr=hiopAllreduce(&maxv,&maxvg,1,MPI_DOUBLE,MPI_MAX,comm_, "mat_max_abs_value"); assert(ierr==MPI_SUCCESS);
   return maxvg;
 #endif
   return maxv;
@@ -821,5 +840,239 @@ bool hiopMatrixDenseRowMajor::assertSymmetry(double tol) const
   return true;
 }
 #endif
+/**********************************************************************************************
+ * hiopMatrixSymDensePacked
+ **********************************************************************************************/
+hiopMatrixSymDensePacked::hiopMatrixSymDensePacked(const long long& n)
+  : hiopMatrixDenseRowMajor()
+{
+  m_local_ = n; n_global_ = n;
+  comm_ = MPI_COMM_SELF; myrank_ = 0;
+  glob_jl_ = 0; glob_ju_ = n;
+  n_local_ = n;
+  max_rows_ = n;
+
+  pool_ = buff_pool_ = NULL;
+  buff_mxnlocal_ = NULL;
+  M_ = new double*[n==0?1:n];
+  M_[0] = n==0?NULL:hiopMemoryPool::allocate(packed_size(), pool_);
+  //row i starts at offset i*n-i*(i-1)/2 in the packed buffer and holds the columns i,...,n-1
+  for(long long i=1; i<n; i++)
+    M_[i] = M_[0] + i*n - i*(i-1)/2 - i;
+
+  if(M_[0]) hiopMemoryPool::first_touch(M_[0], packed_size());
+
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, packed_size()*sizeof(double));
+}
+
+hiopMatrixSymDensePacked::~hiopMatrixSymDensePacked()
+{
+  assert(NULL==buff_mxnlocal_);
+  if(M_) {
+    if(M_[0]) hiopMemoryPool::deallocate(M_[0], packed_size(), pool_);
+    delete[] M_;
+    M_ = NULL;
+  }
+  mem_tracker_->remove(mem_cat_, packed_size()*sizeof(double));
+  //the storage is released above; nothing is left for the destructor of the base class
+  max_rows_ = 0;
+}
+
+void hiopMatrixSymDensePacked::setToConstant(double c)
+{
+  if(!M_[0]) {
+    assert(m_local_==0);
+    return;
+  }
+  double* buf = M_[0];
+  const long long len = packed_size();
+  for(long long k=0; k<len; k++) buf[k] = c;
+}
+
+void hiopMatrixSymDensePacked::copyFrom(const hiopMatrixDense& dmmat)
+{
+  const auto& dm = known_cast<const hiopMatrixSymDensePacked&>(dmmat);
+  assert(m_local_==dm.m_local_);
+  if(M_[0]) memcpy(M_[0], dm.M_[0], packed_size()*sizeof(double));
+}
+
+/* 'buffer' is expected to hold the packed upper triangle */
+void hiopMatrixSymDensePacked::copyFrom(const double* buffer)
+{
+  if(NULL==buffer) {
+    setToZero();
+  } else {
+    if(M_[0]) memcpy(M_[0], buffer, packed_size()*sizeof(double));
+  }
+}
+
+void hiopMatrixSymDensePacked::timesVec(double beta,  double* ya,
+					double alpha, const double* xa) const
+{
+  char uplo='L'; //upper triangle packed by rows is lower triangle packed by columns in Fortran
+  int N=n_local_, inc=1;
+  if(N==0) return;
+  DSPMV(&uplo, &N, &alpha, M_[0], xa, &inc, &beta, ya, &inc);
+}
+
+void hiopMatrixSymDensePacked::timesMat(double, hiopMatrix&, double, const hiopMatrix&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::timesMat_local(double, hiopMatrix&, double, const hiopMatrix&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::transTimesMat(double, hiopMatrix&, double, const hiopMatrix&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::timesMatTrans(double, hiopMatrix&, double, const hiopMatrix&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::timesMatTrans_local(double, hiopMatrix&, double, 
+						   const hiopMatrix&) const
+{
+  assert(false && "not supported for packed storage");
+}
+
+void hiopMatrixSymDensePacked::addMatrix(double alpha, const hiopMatrix& X_)
+{
+  const auto& X = known_cast<const hiopMatrixSymDensePacked&>(X_); 
+  assert(m_local_==X.m_local_);
+  int N=packed_size(), inc=1;
+  if(N>0) DAXPY(&N, &alpha, X.M_[0], &inc, M_[0], &inc);
+}
+
+void hiopMatrixSymDensePacked::addToSymDenseMatrixUpperTriangle(int, int, double, 
+								hiopMatrixDense&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::transAddToSymDenseMatrixUpperTriangle(int, int, double,
+								     hiopMatrixDense&) const
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::
+addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start, double alpha, hiopMatrixDense& W) const
+{
+  assert(W.n()==W.m());
+  assert(diag_start+m_local_ <= W.n());
+  double** WM = W.get_M();
+  //row i of the upper triangle is contiguous in the packed buffer, from M_[i]+i to M_[i]+m_local_
+  for(int i=0; i<m_local_; i++) {
+    double* Wi = WM[i+diag_start]+diag_start;
+    const double* Mi = M_[i];
+    for(int j=i; j<m_local_; j++) Wi[j] += alpha*Mi[j];
+  }
+}
+
+void hiopMatrixSymDensePacked::appendRow(const hiopVector&)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::copyRowsFrom(const hiopMatrixDense&, int, int)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::copyRowsFrom(const hiopMatrix&, const long long*, long long)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::copyBlockFromMatrix(const long, const long, const hiopMatrixDense&)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::copyFromMatrixBlock(const hiopMatrixDense&, const int, const int)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::shiftRows(long long)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::replaceRow(long long, const hiopVector&)
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::getRow(long long, hiopVector&)
+{
+  assert(false && "not supported for packed storage");
+}
+#ifdef HIOP_DEEPCHECKS
+void hiopMatrixSymDensePacked::overwriteUpperTriangleWithLower()
+{
+  assert(false && "not supported for packed storage");
+}
+void hiopMatrixSymDensePacked::overwriteLowerTriangleWithUpper()
+{
+  assert(false && "not supported for packed storage");
+}
+#endif
+
+double hiopMatrixSymDensePacked::max_abs_value()
+{
+  double maxv = 0.;
+  const long long len = packed_size();
+  for(long long k=0; k<len; k++) maxv = std::max(maxv, fabs(M_[0][k]));
+  return maxv;
+}
+
+bool hiopMatrixSymDensePacked::isfinite() const
+{
+  const long long len = packed_size();
+  for(long long k=0; k<len; k++)
+    if(false==std::isfinite(M_[0][k])) return false;
+  return true;
+}
+
+void hiopMatrixSymDensePacked::print(FILE* f, 
+				     const char* msg/*=NULL*/, 
+				     int maxRows/*=-1*/, 
+				     int maxCols/*=-1*/, 
+				     int rank/*=-1*/) const
+{
+  if(myrank_==rank || rank==-1) {
+    if(NULL==f) f=stdout;
+    if(maxRows>m_local_) maxRows=m_local_;
+    if(maxCols>n_local_) maxCols=n_local_;
+
+    if(msg) {
+      fprintf(f, "%s (local_dims=[%d,%d])\n", msg, m_local_,n_local_);
+    } else { 
+      fprintf(f, "hiopMatrixSymDensePacked::printing max=[%d,%d] (local_dims=[%d,%d], on rank=%d)\n", 
+	      maxRows, maxCols, m_local_,n_local_,myrank_);
+    }
+    maxRows = maxRows>=0?maxRows:m_local_;
+    maxCols = maxCols>=0?maxCols:n_local_;
+    fprintf(f, "[");
+    for(int i=0; i<maxRows; i++) {
+      if(i>0) fprintf(f, " ");
+      for(int j=0; j<maxCols; j++) 
+	fprintf(f, "%20.12e ", j>=i ? M_[i][j] : M_[j][i]);
+      if(i<maxRows-1)
+	fprintf(f, "; ...\n");
+      else
+	fprintf(f, "];\n");
+    }
+  }
+}
+
+hiopMatrixDense* hiopMatrixSymDensePacked::alloc_clone() const
+{
+  return new hiopMatrixSymDensePacked(m_local_);
+}
+
+hiopMatrixDense* hiopMatrixSymDensePacked::new_copy() const
+{
+  hiopMatrixDense* c = new hiopMatrixSymDensePacked(m_local_);
+  c->copyFrom(*this);
+  return c;
+}
+
 };
 
@@ -48,6 +48,8 @@
 
 #pragma once
 #include "hiopMatrixDense.hpp"
+#include "hiopMemTracker.hpp"
+#include "hiopMemoryPool.hpp"
 #include <cstddef>
 #include <cstdio>
 
@@ -226,7 +228,7 @@ public:
 #ifdef HIOP_DEEPCHECKS
   virtual bool assertSymmetry(double tol=1e-16) const;
 #endif
-private:
+protected:
   double** M_; //local storage
   int n_local_; //local number of rows and cols, respectively
   long long glob_jl_, glob_ju_;
@@ -235,18 +237,116 @@ private:
 
   //this is very private do not touch :)
   long long max_rows_;
-private:
+
+  //category and tracker under which the storage, including buff_mxnlocal_, is recorded (the
+  //tracker of the creating thread)
+  hiopMemCategory mem_cat_;
+  hiopMemTracker* mem_tracker_;
+  //arenas of the storage and of buff_mxnlocal_ (NULL for the heap)
+  hiopMemoryPool* pool_;
+  mutable hiopMemoryPool* buff_pool_;
+protected:
   hiopMatrixDenseRowMajor() {};
   /** copy constructor, for internal/private use only (it doesn't copy the values) */
   hiopMatrixDenseRowMajor(const hiopMatrixDenseRowMajor&);
+private:
 
   inline double* new_mxnlocal_buff() const {
     if(buff_mxnlocal_==NULL) {
-      buff_mxnlocal_ = new double[max_rows_*n_local_];
+      buff_mxnlocal_ = hiopMemoryPool::allocate(max_rows_*n_local_, buff_pool_);
+      mem_tracker_->add(mem_cat_, max_rows_*n_local_*sizeof(double));
     } 
     return buff_mxnlocal_;
   }
 };
 
+/**
+ * @brief Symmetric n x n matrix of which only the upper triangle is stored, packed row-wise
+ *
+ * The row pointers returned by local_data()/get_M() are shifted so that M[i][j] addresses the
+ * entry (i,j) of the upper triangle for j>=i; the entries with j<i must not be accessed through
+ * them. The code assembling the KKT matrices in the upper triangle (the *ToSymDenseMatrixUpperTriangle
+ * and *SymDeMatUTri methods) works therefore unchanged on this storage. The packed buffer
+ * (local_buffer()) is the lower triangle packed by columns in Fortran, as expected by LAPACK's
+ * DSPTRF/DSPTRS with uplo='L'.
+ *
+ * The matrix is local (not distributed). Only the operations needed on the KKT systems are
+ * supported; the others, including the row and block copies inherited from 
+ * hiopMatrixDenseRowMajor that assume full rows, assert and leave the matrix unchanged.
+ */
+class hiopMatrixSymDensePacked : public hiopMatrixDenseRowMajor
+{
+public:
+  hiopMatrixSymDensePacked(const long long& n);
+  virtual ~hiopMatrixSymDensePacked();
+
+  /// @brief number of elements of the packed storage, n*(n+1)/2
+  inline long long packed_size() const { return packed_size(m_local_); }
+  static inline long long packed_size(const long long& n) { return n*(n+1)/2; }
+
+  virtual void setToConstant(double c);
+  virtual void copyFrom(const hiopMatrixDense& dm);
+  virtual void copyFrom(const double* buffer);
+
+  using hiopMatrixDenseRowMajor::timesVec;
+  using hiopMatrixDenseRowMajor::transTimesVec;
+
+  /* y = beta*y + alpha*this*x, with this symmetric */
+  virtual void timesVec(double beta,  double* y,
+			double alpha, const double* x) const;
+  virtual void transTimesVec(double beta,   double* y,
+			     double alpha, const double* x) const
+  {
+    timesVec(beta, y, alpha, x);
+  }
+
+  virtual void timesMat(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+  virtual void timesMat_local(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+  virtual void transTimesMat(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+  virtual void timesMatTrans(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+  virtual void timesMatTrans_local(double beta, hiopMatrix& W, double alpha, const hiopMatrix& X) const;
+
+  virtual void addMatrix(double alpha, const hiopMatrix& X);
+  virtual void addToSymDenseMatrixUpperTriangle(int row_dest_start, int col_dest_start, 
+						double alpha, hiopMatrixDense& W) const;
+  virtual void transAddToSymDenseMatrixUpperTriangle(int row_dest_start, int col_dest_start, 
+						     double alpha, hiopMatrixDense& W) const;
+  /* reads only the (stored) upper triangle of this */
+  virtual void addUpperTriangleToSymDenseMatrixUpperTriangle(int diag_start, 
+							     double alpha, hiopMatrixDense& W) const;
+
+  /* not supported: the rows are not stored entirely */
+  virtual void appendRow(const hiopVector& row);
+  virtual void copyRowsFrom(const hiopMatrixDense& src, int num_rows, int row_dest);
+  virtual void copyRowsFrom(const hiopMatrix& src_gen, const long long* rows_idxs, long long n_rows);
+  virtual void copyBlockFromMatrix(const long i_block_start, const long j_block_start,
+				   const hiopMatrixDense& src);
+  virtual void copyFromMatrixBlock(const hiopMatrixDense& src, const int i_src_block_start, 
+				   const int j_src_block_start);
+  virtual void shiftRows(long long shift);
+  virtual void replaceRow(long long row, const hiopVector& vec);
+  virtual void getRow(long long irow, hiopVector& row_vec);
+#ifdef HIOP_DEEPCHECKS
+  virtual void overwriteUpperTriangleWithLower();
+  virtual void overwriteLowerTriangleWithUpper();
+#endif
+
+  virtual double max_abs_value();
+  virtual bool isfinite() const;
+
+  /* prints the full matrix, with the lower triangle taken from the upper triangle */
+  virtual void print(FILE* f=NULL, const char* msg=NULL, int maxRows=-1, int maxCols=-1, int rank=-1) const;
+
+  virtual hiopMatrixDense* alloc_clone() const;
+  virtual hiopMatrixDense* new_copy() const;
+
+#ifdef HIOP_DEEPCHECKS
+  virtual bool assertSymmetry(double /*tol*/=1e-16) const { return true; }
+#endif
+private:
+  hiopMatrixSymDensePacked() = delete;
+  hiopMatrixSymDensePacked(const hiopMatrixSymDensePacked&) = delete;
+};
+
 } // namespace hiop
 
@@ -53,7 +53,7 @@ public:
 
   virtual void copyRowsFrom(const hiopMatrix& src_in, const long long* rows_idxs, long long n_rows)
   {
-    const hiopMatrixMDS& src = dynamic_cast<const hiopMatrixMDS&>(src_in);
+    const hiopMatrixMDS& src = known_cast<const hiopMatrixMDS&>(src_in);
     mSp->copyRowsFrom(*src.mSp, rows_idxs, n_rows);
     mDe->copyRowsFrom(*src.mDe, rows_idxs, n_rows);
   }
@@ -264,7 +264,7 @@ public:
 
   virtual void copyRowsFrom(const hiopMatrix& src_in, const long long* rows_idxs, long long n_rows)
   {
-    const hiopMatrixSymBlockDiagMDS& src = dynamic_cast<const hiopMatrixSymBlockDiagMDS&>(src_in);
+    const hiopMatrixSymBlockDiagMDS& src = known_cast<const hiopMatrixSymBlockDiagMDS&>(src_in);
     mSp->copyRowsFrom(src, rows_idxs, n_rows);
     mDe->copyRowsFrom(src, rows_idxs, n_rows);
   }
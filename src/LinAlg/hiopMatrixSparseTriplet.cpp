@@ -24,6 +24,9 @@ hiopMatrixSparseTriplet::hiopMatrixSparseTriplet(int rows, int cols, int nnz)
   iRow_ = new  int[nnz_];
   jCol_ = new int[nnz_];
   values_ = new double[nnz_];
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, nnz_*(2*sizeof(int)+sizeof(double)));
 }
 
 hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
@@ -32,6 +35,7 @@ hiopMatrixSparseTriplet::~hiopMatrixSparseTriplet()
   delete [] jCol_;
   delete [] values_;
   delete row_starts_;
+  mem_tracker_->remove(mem_cat_, nnz_*(2*sizeof(int)+sizeof(double)));
 }
 
 void hiopMatrixSparseTriplet::setToZero()
@@ -52,8 +56,8 @@ void hiopMatrixSparseTriplet::timesVec(double beta,  hiopVector& y,
   assert(x.get_size() == ncols_);
   assert(y.get_size() == nrows_);
 
-  hiopVectorPar& yy = dynamic_cast<hiopVectorPar&>(y);
-  const hiopVectorPar& xx = dynamic_cast<const hiopVectorPar&>(x);
+  hiopVectorPar& yy = known_cast<hiopVectorPar&>(y);
+  const hiopVectorPar& xx = known_cast<const hiopVectorPar&>(x);
 
   double* y_data = yy.local_data();
   const double* x_data = xx.local_data_const();
@@ -85,8 +89,8 @@ void hiopMatrixSparseTriplet::transTimesVec(double beta,   hiopVector& y,
   assert(x.get_size() == nrows_);
   assert(y.get_size() == ncols_);
 
-  hiopVectorPar& yy = dynamic_cast<hiopVectorPar&>(y);
-  const hiopVectorPar& xx = dynamic_cast<const hiopVectorPar&>(x);
+  hiopVectorPar& yy = known_cast<hiopVectorPar&>(y);
+  const hiopVectorPar& xx = known_cast<const hiopVectorPar&>(x);
   
   double* y_data = yy.local_data();
   const double* x_data = xx.local_data_const();
@@ -297,7 +301,7 @@ addMDinvNtransToSymDeMatUTri(int row_dest_start, int col_dest_start,
 			     const hiopVector& D, const hiopMatrixSparse& M2mat,
 			     hiopMatrixDense& W) const
 {
-  const auto& M2 = dynamic_cast<const hiopMatrixSparseTriplet&>(M2mat);
+  const auto& M2 = known_cast<const hiopMatrixSparseTriplet&>(M2mat);
   const hiopMatrixSparseTriplet& M1 = *this;
   const int m1 = M1.nrows_, nx = M1.ncols_, m2 = M2.nrows_;
   assert(nx==M1.ncols_);
@@ -396,7 +400,7 @@ void hiopMatrixSparseTriplet::copyRowsFrom(const hiopMatrix& src_gen,
 					   const long long* rows_idxs,
 					   long long n_rows)
 {
-  const hiopMatrixSparseTriplet& src = dynamic_cast<const hiopMatrixSparseTriplet&>(src_gen);
+  const hiopMatrixSparseTriplet& src = known_cast<const hiopMatrixSparseTriplet&>(src_gen);
   assert(this->m() == n_rows);
   assert(this->numberOfNonzeros() <= src.numberOfNonzeros());
   assert(this->n() == src.n());
@@ -495,8 +499,8 @@ void hiopMatrixSymSparseTriplet::timesVec(double beta,  hiopVector& y,
   assert(x.get_size() == ncols_);
   assert(y.get_size() == nrows_);
 
-  hiopVectorPar& yy = dynamic_cast<hiopVectorPar&>(y);
-  const hiopVectorPar& xx = dynamic_cast<const hiopVectorPar&>(x);
+  hiopVectorPar& yy = known_cast<hiopVectorPar&>(y);
+  const hiopVectorPar& xx = known_cast<const hiopVectorPar&>(x);
 
   double* y_data = yy.local_data();
   const double* x_data = xx.local_data_const();
@@ -584,7 +588,7 @@ void hiopMatrixSymSparseTriplet::
 startingAtAddSubDiagonalToStartingAt(int diag_src_start, const double& alpha, 
 				     hiopVector& vec_dest, int vec_start, int num_elems/*=-1*/) const
 {
-  hiopVectorPar& vd = dynamic_cast<hiopVectorPar&>(vec_dest);
+  hiopVectorPar& vd = known_cast<hiopVectorPar&>(vec_dest);
   if(num_elems<0) num_elems = vd.get_size();
   assert(num_elems<=vd.get_size());
 
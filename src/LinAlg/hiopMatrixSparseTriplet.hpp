@@ -4,6 +4,7 @@
 #include "hiopVector.hpp"
 #include "hiopMatrixDense.hpp"
 #include "hiopMatrixSparse.hpp"
+#include "hiopMemTracker.hpp"
 
 #include <cassert>
 
@@ -117,6 +118,8 @@ protected:
   int* iRow_; ///< row indices of the nonzero entries
   int* jCol_; ///< column indices of the nonzero entries
   double* values_; ///< values_ of the nonzero entries
+  hiopMemCategory mem_cat_; ///< category under which the storage is recorded by hiopMemTracker
+  hiopMemTracker* mem_tracker_; ///< tracker that records the storage (of the creating thread)
 
 protected:
   struct RowStartsInfo
@@ -139,7 +142,8 @@ private:
   RowStartsInfo* allocAndBuildRowStarts() const; 
 private:
   hiopMatrixSparseTriplet() 
-    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL)
+    : hiopMatrixSparse(0, 0, 0), iRow_(NULL), jCol_(NULL), values_(NULL), mem_cat_(hiopMemOther),
+      mem_tracker_(&hiopMemTracker::global())
   {
   }
   hiopMatrixSparseTriplet(const hiopMatrixSparseTriplet&) 
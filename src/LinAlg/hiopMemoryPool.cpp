@@ -0,0 +1,264 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#include "hiopMemoryPool.hpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cassert>
+#include <algorithm>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+namespace hiop
+{
+
+static const size_t kAlignment = 64;
+static const size_t kHugePage = 2*1024*1024;
+static const size_t kPage = 4096;
+//blocks smaller than this (in bytes) are first touched by the calling thread only
+static const size_t kFirstTouchMinBytes = 256*1024;
+//blocks smaller than this (in bytes) are not interleaved
+static const size_t kInterleaveMinBytes = 1024*1024;
+
+hiopMemoryPool::hiopMemoryPool(bool huge_pages)
+  : huge_pages_(huge_pages), closed_(false), n_live_(0), n_allocs_(0), n_reused_(0),
+    bytes_cached_(0), bytes_total_(0), bytes_total_peak_(0)
+{
+}
+
+hiopMemoryPool::~hiopMemoryPool()
+{
+  release_nolock();
+}
+
+hiopMemoryPool* hiopMemoryPool::create(bool huge_pages)
+{
+  return new hiopMemoryPool(huge_pages);
+}
+
+void hiopMemoryPool::close(hiopMemoryPool* pool)
+{
+  if(NULL==pool) return;
+  bool del;
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex_);
+    pool->release_nolock();
+    pool->closed_ = true;
+    del = (0==pool->n_live_);
+  }
+  if(del) delete pool;
+}
+
+hiopMemoryPool*& hiopMemoryPool::thread_pool()
+{
+  static thread_local hiopMemoryPool* pool = NULL;
+  return pool;
+}
+
+hiopMemoryPool* hiopMemoryPool::active()
+{
+  return thread_pool();
+}
+
+bool& hiopMemoryPool::thread_interleave()
+{
+  static thread_local bool interleave = false;
+  return interleave;
+}
+
+void hiopMemoryPool::first_touch(double* p, size_t n)
+{
+  const long long len = (long long)n;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(n*sizeof(double)>=kFirstTouchMinBytes)
+#endif
+  for(long long i=0; i<len; i++) p[i] = 0.;
+}
+
+size_t hiopMemoryPool::block_size(size_t bytes) const
+{
+  if(bytes<=4096) return std::max((bytes+kAlignment-1)/kAlignment*kAlignment, kAlignment);
+  if(huge_pages_ && bytes>=kHugePage) return (bytes+kHugePage-1)/kHugePage*kHugePage;
+  return (bytes+4095)/4096*4096;
+}
+
+void* hiopMemoryPool::heap_alloc(size_t bytes, bool huge_pages)
+{
+  const bool huge = huge_pages && bytes>=kHugePage;
+  void* p = NULL;
+  if(0!=posix_memalign(&p, huge ? kHugePage : kAlignment, bytes)) return NULL;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if(huge) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  return p;
+}
+
+void* hiopMemoryPool::heap_alloc_interleaved(size_t bytes)
+{
+  bytes = (bytes+kPage-1)/kPage*kPage;
+  void* p = NULL;
+  if(0!=posix_memalign(&p, kPage, bytes)) return NULL;
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+  //interleave over the nodes the process is allowed to use; the placement stays the default 
+  //(first touch) if the kernel does not support it
+  unsigned long nodemask[16] = {0};
+  const unsigned long maxnode = 16*8*sizeof(unsigned long);
+  if(0==syscall(SYS_get_mempolicy, NULL, nodemask, maxnode, NULL, MPOL_F_MEMS_ALLOWED)) {
+    syscall(SYS_mbind, p, bytes, MPOL_INTERLEAVE, nodemask, maxnode, 0);
+  }
+#endif
+  return p;
+}
+
+void* hiopMemoryPool::get_block(size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  assert(!closed_);
+  n_allocs_++;
+  n_live_++;
+  auto it = free_lists_.find(bytes);
+  if(it!=free_lists_.end() && !it->second.empty()) {
+    void* p = it->second.back();
+    it->second.pop_back();
+    bytes_cached_ -= bytes;
+    n_reused_++;
+    return p;
+  }
+  void* p = heap_alloc(bytes, huge_pages_);
+  if(NULL==p) {
+    n_allocs_--;
+    n_live_--;
+    return NULL;
+  }
+  bytes_total_ += bytes;
+  bytes_total_peak_ = std::max(bytes_total_peak_, bytes_total_);
+  first_touch(static_cast<double*>(p), bytes/sizeof(double));
+  return p;
+}
+
+bool hiopMemoryPool::put_block(void* p, size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  assert(n_live_>0);
+  n_live_--;
+  if(closed_) {
+    free(p);
+    bytes_total_ -= bytes;
+    return 0==n_live_;
+  }
+  free_lists_[bytes].push_back(p);
+  bytes_cached_ += bytes;
+  return false;
+}
+
+void hiopMemoryPool::release_nolock()
+{
+  for(auto& fl : free_lists_) {
+    for(void* p : fl.second) free(p);
+    bytes_total_ -= (long long)(fl.first*fl.second.size());
+  }
+  free_lists_.clear();
+  bytes_cached_ = 0;
+}
+
+void hiopMemoryPool::release()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  release_nolock();
+}
+
+double* hiopMemoryPool::allocate(size_t n, hiopMemoryPool*& pool)
+{
+  pool = thread_pool();
+  void* p;
+  if(thread_interleave() && n*sizeof(double)>=kInterleaveMinBytes) {
+    //interleaved blocks are not cached, since the placement is a property of the pages
+    pool = NULL;
+    p = heap_alloc_interleaved(n*sizeof(double));
+    if(p) first_touch(static_cast<double*>(p), n);
+  } else if(pool) {
+    p = pool->get_block(pool->block_size(n*sizeof(double)));
+  } else {
+    p = heap_alloc(std::max(n*sizeof(double), kAlignment), false);
+    if(p) first_touch(static_cast<double*>(p), n);
+  }
+  //same behavior as the new[] the storage of the objects used to come from
+  if(NULL==p) throw std::bad_alloc();
+  return static_cast<double*>(p);
+}
+
+void hiopMemoryPool::deallocate(double* p, size_t n, hiopMemoryPool* pool)
+{
+  if(NULL==p) return;
+  if(NULL==pool) {
+    free(p);
+    return;
+  }
+  if(pool->put_block(p, pool->block_size(n*sizeof(double)))) delete pool;
+}
+
+std::string hiopMemoryPool::get_report()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  char buff[256];
+  snprintf(buff, 255, "Memory pool: %lld allocations, %.1f percent from the pool, "
+	   "peak %.3f MB, cached %.3f MB%s\n", n_allocs_,
+	   n_allocs_>0 ? 100.*n_reused_/n_allocs_ : 0., bytes_total_peak_/1048576.,
+	   bytes_cached_/1048576., huge_pages_ ? " (huge pages)" : "");
+  return std::string(buff);
+}
+
+} //end namespace
@@ -0,0 +1,184 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#ifndef HIOP_MEMORY_POOL
+#define HIOP_MEMORY_POOL
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace hiop
+{
+
+/* Size-bucketed pool (arena) for the storage of the linear algebra objects.
+ *
+ * All the blocks are 64-byte aligned. Freed blocks are cached in per-size free lists and are 
+ * reused by later allocations of the same (rounded) size, so that the vectors and matrices 
+ * created and destroyed during the iterations do not go to the heap. The block sizes are rounded
+ * up to 64 bytes for blocks up to 4KB and to 4KB above that. With huge pages, blocks of 2MB or 
+ * more are rounded up to and aligned at 2MB and advised as (transparent) huge pages.
+ *
+ * The objects take their storage from the arena that is active on the calling thread at their 
+ * construction, as set by hiopMemPoolScope, or from the heap (with the same alignment) when none
+ * is active. Each solver owns an arena (options 'mem_pool' and 'mem_pool_huge_pages'), whose 
+ * cached blocks are released when the solver objects are destroyed. An arena is closed by its 
+ * owner with 'close'; blocks still in use at that point are freed to the heap when their objects
+ * are destroyed, and the arena deletes itself after the last of them.
+ *
+ * NUMA placement: the pages of a block are placed on the memory of the socket of the thread that
+ * first writes them. Blocks newly obtained from the heap are therefore first touched (zeroed) by
+ * the OpenMP threads with a static schedule over the elements, the partitioning used by threaded
+ * kernels (and by the threaded BLAS) over the same elements. Large blocks allocated while a 
+ * hiopMemInterleaveScope is active, such as the dense KKT matrices (option 'mem_kkt_interleave'),
+ * are instead interleaved page by page over the NUMA nodes the process may use.
+ */
+class hiopMemoryPool
+{
+public:
+  static hiopMemoryPool* create(bool huge_pages);
+  static void close(hiopMemoryPool* pool);
+
+  /** 
+   * Allocates 'n' doubles from the arena active on the calling thread or from the heap. 'pool' 
+   * receives the arena (NULL for the heap), which should be passed to 'deallocate'. Throws
+   * std::bad_alloc if the memory cannot be obtained.
+   */
+  static double* allocate(size_t n, hiopMemoryPool*& pool);
+  static void deallocate(double* p, size_t n, hiopMemoryPool* pool);
+
+  //arena of the calling thread, NULL if none
+  static hiopMemoryPool* active();
+
+  //zeroes the 'n' doubles at 'p' with a static OpenMP schedule (when large enough)
+  static void first_touch(double* p, size_t n);
+
+  //frees the cached blocks
+  void release();
+
+  //number of allocations, fraction served from the cache, and cached and peak bytes
+  std::string get_report();
+private:
+  bool huge_pages_;
+  bool closed_;
+  //blocks allocated from the arena and not yet deallocated
+  long long n_live_;
+  long long n_allocs_, n_reused_;
+  long long bytes_cached_, bytes_total_, bytes_total_peak_;
+  std::unordered_map<size_t, std::vector<void*> > free_lists_;
+  std::mutex mutex_;
+
+  size_t block_size(size_t bytes) const;
+  void* get_block(size_t bytes);
+  //returns true if the arena should be deleted (closed and no blocks left)
+  bool put_block(void* p, size_t bytes);
+  void release_nolock();
+
+  static void* heap_alloc(size_t bytes, bool huge_pages);
+  static void* heap_alloc_interleaved(size_t bytes);
+
+  friend class hiopMemPoolScope;
+  friend class hiopMemInterleaveScope;
+  static hiopMemoryPool*& thread_pool();
+  static bool& thread_interleave();
+
+  hiopMemoryPool(bool huge_pages);
+  ~hiopMemoryPool();
+  hiopMemoryPool(const hiopMemoryPool&);
+  hiopMemoryPool& operator=(const hiopMemoryPool&);
+};
+
+/* Scoped arena: the linear algebra objects created by the calling thread while the scope is
+ * alive take their storage from 'pool' (from the heap if 'pool' is NULL). Scopes can be nested.
+ */
+class hiopMemPoolScope
+{
+public:
+  hiopMemPoolScope(hiopMemoryPool* pool)
+    : prev_(hiopMemoryPool::thread_pool())
+  {
+    hiopMemoryPool::thread_pool() = pool;
+  }
+  ~hiopMemPoolScope()
+  {
+    hiopMemoryPool::thread_pool() = prev_;
+  }
+private:
+  hiopMemoryPool* prev_;
+
+  hiopMemPoolScope(const hiopMemPoolScope&);
+  hiopMemPoolScope& operator=(const hiopMemPoolScope&);
+};
+
+/* Scoped placement: the large blocks allocated by the calling thread while the scope is alive 
+ * and 'interleave' is true are interleaved over the NUMA nodes (Linux only) and freed to the heap.
+ */
+class hiopMemInterleaveScope
+{
+public:
+  hiopMemInterleaveScope(bool interleave)
+    : prev_(hiopMemoryPool::thread_interleave())
+  {
+    hiopMemoryPool::thread_interleave() = interleave;
+  }
+  ~hiopMemInterleaveScope()
+  {
+    hiopMemoryPool::thread_interleave() = prev_;
+  }
+private:
+  bool prev_;
+
+  hiopMemInterleaveScope(const hiopMemInterleaveScope&);
+  hiopMemInterleaveScope& operator=(const hiopMemInterleaveScope&);
+};
+
+} //end namespace
+#endif
@@ -49,6 +49,7 @@
 #pragma once
 
 #include <cstdio>
+#include "hiopCppStdUtils.hpp"
 
 namespace hiop
 {
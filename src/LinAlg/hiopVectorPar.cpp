@@ -54,6 +54,7 @@
 #include <cassert>
 
 #include "hiop_blasdefs.hpp"
+#include "hiopCommProfiler.hpp"
 
 #include <limits>
 #include <cstddef>
@@ -83,18 +84,56 @@ hiopVectorPar::hiopVectorPar(const long long& glob_n, long long* col_part/*=NULL
   }   
   n_local_=glob_iu_-glob_il_;
 
-  data_ = new double[n_local_];
+  data_ = hiopMemoryPool::allocate(n_local_, pool_);
+  owns_data_ = true;
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, n_local_*sizeof(double));
 }
 hiopVectorPar::hiopVectorPar(const hiopVectorPar& v)
 {
   n_local_=v.n_local_; n_ = v.n_;
   glob_il_=v.glob_il_; glob_iu_=v.glob_iu_;
   comm_=v.comm_;
-  data_=new double[n_local_];  
+  data_ = hiopMemoryPool::allocate(n_local_, pool_);
+  owns_data_ = true;
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, n_local_*sizeof(double));
+}
+hiopVectorPar::hiopVectorPar(const hiopVectorPar& layout, double* data)
+{
+  n_local_=layout.n_local_; n_ = layout.n_;
+  glob_il_=layout.glob_il_; glob_iu_=layout.glob_iu_;
+  comm_=layout.comm_;
+  assert(data!=NULL || n_local_==0);
+  data_ = data;
+  //the storage of a view is accounted for by its owner
+  owns_data_ = false;
+  pool_ = NULL;
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+}
+hiopVectorPar::hiopVectorPar(double* data, const long long& n)
+  : comm_(MPI_COMM_SELF)
+{
+  assert(n>=0);
+  assert(data!=NULL || n==0);
+  n_ = n_local_ = n;
+  glob_il_=0; glob_iu_=n;
+  data_ = data;
+  owns_data_ = false;
+  pool_ = NULL;
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
 }
 hiopVectorPar::~hiopVectorPar()
 {
-  delete[] data_; data_=NULL;
+  if(owns_data_) {
+    hiopMemoryPool::deallocate(data_, n_local_, pool_);
+    mem_tracker_->remove(mem_cat_, n_local_*sizeof(double));
+  }
+  data_=NULL;
 }
 
 hiopVector* hiopVectorPar::alloc_clone() const
@@ -119,13 +158,13 @@ void hiopVectorPar::setToConstant(double c)
 }
 void hiopVectorPar::setToConstant_w_patternSelect(double c, const hiopVector& select)
 {
-  const hiopVectorPar& s = dynamic_cast<const hiopVectorPar&>(select);
+  const hiopVectorPar& s = known_cast<const hiopVectorPar&>(select);
   const double* svec = s.data_;
   for(int i=0; i<n_local_; i++) if(svec[i]==1.) data_[i]=c; else data_[i]=0.;
 }
 void hiopVectorPar::copyFrom(const hiopVector& v_ )
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   assert(n_local_==v.n_local_);
   assert(glob_il_==v.glob_il_); assert(glob_iu_==v.glob_iu_);
   memcpy(this->data_, v.data_, n_local_*sizeof(double));
@@ -148,7 +187,7 @@ void hiopVectorPar::copyFromStarting(int start_index/*_in_src*/,const hiopVector
 #ifdef HIOP_DEEPCHECKS
   assert(n_local_==n_ && "only for local/non-distributed vectors");
 #endif
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   assert(start_index+v.n_local_ <= n_local_);
   memcpy(data_+start_index, v.data_, v.n_local_*sizeof(double));
 }
@@ -161,7 +200,7 @@ void hiopVectorPar::startingAtCopyFromStartingAt(int start_idx_dest,
   assert(n_local_==n_ && "only for local/non-distributed vectors");
 #endif
   assert((start_idx_dest>=0 && start_idx_dest<this->n_local_) || this->n_local_==0);
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_in);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_in);
   assert((start_idx_src>=0 && start_idx_src<v.n_local_) || v.n_local_==0);
 
   int howManyToCopy = this->n_local_ - start_idx_dest;
@@ -177,7 +216,7 @@ void hiopVectorPar::startingAtCopyFromStartingAt(int start_idx_dest,
 
 void hiopVectorPar::copyToStarting(int start_index, hiopVector& v_)
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
 #ifdef HIOP_DEEPCHECKS
   assert(n_local_==n_ && "are you sure you want to call this?");
 #endif
@@ -190,7 +229,7 @@ void hiopVectorPar::copyToStarting(hiopVector& v_, int start_index/*_in_dest*/)
 #ifdef HIOP_DEEPCHECKS
   assert(n_local_==n_ && "only for local/non-distributed vectors");
 #endif
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   assert(start_index+n_local_ <= v.n_local_);
   memcpy(v.data_+start_index, data_, n_local_*sizeof(double)); 
 }
@@ -208,7 +247,7 @@ startingAtCopyToStartingAt(int start_idx_in_src, hiopVector& dest_, int start_id
 #ifdef DEBUG  
   if(start_idx_in_src==this->n_local_) assert((num_elems==-1 || num_elems==0));
 #endif
-  const hiopVectorPar& dest = dynamic_cast<hiopVectorPar&>(dest_);
+  const hiopVectorPar& dest = known_cast<hiopVectorPar&>(dest_);
   assert(start_idx_dest>=0 && start_idx_dest<=dest.n_local_);
 #ifdef DEBUG  
   if(start_idx_dest==dest.n_local_) assert((num_elems==-1 || num_elems==0));
@@ -239,7 +278,7 @@ double hiopVectorPar::twonorm() const
 #ifdef HIOP_USE_MPI
   nrm *= nrm;
   double nrmG;
-  int ierr = MPI_Allreduce(&nrm, &nrmG, 1, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr = hiopAllreduce(&nrm, &nrmG, 1, MPI_DOUBLE, MPI_SUM, comm_, "vec_twonorm"); assert(MPI_SUCCESS==ierr);
   nrm=sqrt(nrmG);
 #endif  
   return nrm;
@@ -247,7 +286,7 @@ double hiopVectorPar::twonorm() const
 
 double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   int one=1; int n=n_local_;
   assert(this->n_local_==v.n_local_);
 
@@ -255,7 +294,7 @@ double hiopVectorPar::dotProductWith( const hiopVector& v_ ) const
 
 #ifdef HIOP_USE_MPI
   double dotprodG;
-  int ierr = MPI_Allreduce(&dotprod, &dotprodG, 1, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr = hiopAllreduce(&dotprod, &dotprodG, 1, MPI_DOUBLE, MPI_SUM, comm_, "vec_dot"); assert(MPI_SUCCESS==ierr);
   dotprod=dotprodG;
 #endif
 
@@ -277,7 +316,7 @@ double hiopVectorPar::infnorm() const
   }
 #ifdef HIOP_USE_MPI
   double nrm_glob;
-  int ierr = MPI_Allreduce(&nrm, &nrm_glob, 1, MPI_DOUBLE, MPI_MAX, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr = hiopAllreduce(&nrm, &nrm_glob, 1, MPI_DOUBLE, MPI_MAX, comm_, "vec_infnorm"); assert(MPI_SUCCESS==ierr);
   return nrm_glob;
 #endif
 
@@ -306,7 +345,7 @@ double hiopVectorPar::onenorm() const
   double nrm1=0.; for(int i=0; i<n_local_; i++) nrm1 += fabs(data_[i]);
 #ifdef HIOP_USE_MPI
   double nrm1_global;
-  int ierr = MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr = hiopAllreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, comm_, "vec_onenorm"); assert(MPI_SUCCESS==ierr);
   return nrm1_global;
 #endif
   return nrm1;
@@ -320,7 +359,7 @@ double hiopVectorPar::onenorm_local() const
 
 void hiopVectorPar::componentMult( const hiopVector& v_ )
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   assert(n_local_==v.n_local_);
   for(int i=0; i<n_local_; ++i)
     data_[i] *= v.data_[i];
@@ -328,15 +367,15 @@ void hiopVectorPar::componentMult( const hiopVector& v_ )
 
 void hiopVectorPar::componentDiv ( const hiopVector& v_ )
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
   assert(n_local_==v.n_local_);
   for(int i=0; i<n_local_; i++) data_[i] /= v.data_[i];
 }
 
 void hiopVectorPar::componentDiv_w_selectPattern( const hiopVector& v_, const hiopVector& ix_)
 {
-  const hiopVectorPar& v = dynamic_cast<const hiopVectorPar&>(v_);
-  const hiopVectorPar& ix= dynamic_cast<const hiopVectorPar&>(ix_);
+  const hiopVectorPar& v = known_cast<const hiopVectorPar&>(v_);
+  const hiopVectorPar& ix= known_cast<const hiopVectorPar&>(ix_);
 #ifdef HIOP_DEEPCHECKS
   assert(v.n_local_==n_local_);
   assert(n_local_==ix.n_local_);
@@ -356,15 +395,15 @@ void hiopVectorPar::scale(double num)
 
 void hiopVectorPar::axpy(double alpha, const hiopVector& x_)
 {
-  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  const hiopVectorPar& x = known_cast<const hiopVectorPar&>(x_);
   int one = 1; int n=n_local_;
   DAXPY( &n, &alpha, x.data_, &one, data_, &one );
 }
 
 void hiopVectorPar::axzpy(double alpha, const hiopVector& x_, const hiopVector& z_)
 {
-  const hiopVectorPar& vx = dynamic_cast<const hiopVectorPar&>(x_);
-  const hiopVectorPar& vz = dynamic_cast<const hiopVectorPar&>(z_);
+  const hiopVectorPar& vx = known_cast<const hiopVectorPar&>(x_);
+  const hiopVectorPar& vz = known_cast<const hiopVectorPar&>(z_);
 #ifdef HIOP_DEEPCHECKS
   assert(vx.n_local_==vz.n_local_);
   assert(   n_local_==vz.n_local_);
@@ -390,8 +429,8 @@ void hiopVectorPar::axzpy(double alpha, const hiopVector& x_, const hiopVector&
 void hiopVectorPar::axdzpy( double alpha, const hiopVector& x_, const hiopVector& z_)
 {
   if(alpha==0.) return;
-  const hiopVectorPar& vx = dynamic_cast<const hiopVectorPar&>(x_);
-  const hiopVectorPar& vz = dynamic_cast<const hiopVectorPar&>(z_);
+  const hiopVectorPar& vx = known_cast<const hiopVectorPar&>(x_);
+  const hiopVectorPar& vz = known_cast<const hiopVectorPar&>(z_);
 #ifdef HIOP_DEEPCHECKS
   assert(vx.n_local_==vz.n_local_);
   assert(   n_local_==vz.n_local_);
@@ -420,9 +459,9 @@ void hiopVectorPar::axdzpy( double alpha, const hiopVector& x_, const hiopVector
 
 void hiopVectorPar::axdzpy_w_pattern( double alpha, const hiopVector& x_, const hiopVector& z_, const hiopVector& select)
 {
-  const hiopVectorPar& vx = dynamic_cast<const hiopVectorPar&>(x_);
-  const hiopVectorPar& vz = dynamic_cast<const hiopVectorPar&>(z_);
-  const hiopVectorPar& sel= dynamic_cast<const hiopVectorPar&>(select);
+  const hiopVectorPar& vx = known_cast<const hiopVectorPar&>(x_);
+  const hiopVectorPar& vz = known_cast<const hiopVectorPar&>(z_);
+  const hiopVectorPar& sel= known_cast<const hiopVectorPar&>(select);
 #ifdef HIOP_DEEPCHECKS
   assert(vx.n_local_==vz.n_local_);
   assert(   n_local_==vz.n_local_);
@@ -451,7 +490,7 @@ void hiopVectorPar::addConstant( double c )
 
 void  hiopVectorPar::addConstant_w_patternSelect(double c, const hiopVector& ix_)
 {
-  const hiopVectorPar& ix = dynamic_cast<const hiopVectorPar&>(ix_);
+  const hiopVectorPar& ix = known_cast<const hiopVectorPar&>(ix_);
   assert(this->n_local_ == ix.n_local_);
   const double* ix_vec = ix.data_;
   for(int i=0; i<n_local_; i++) if(ix_vec[i]==1.) data_[i]+=c;
@@ -483,7 +522,7 @@ double hiopVectorPar::logBarrier_local(const hiopVector& select) const
 {
   double sum = 0.0;
   double comp = 0.0;
-  const hiopVectorPar& ix = dynamic_cast<const hiopVectorPar&>(select);
+  const hiopVectorPar& ix = known_cast<const hiopVectorPar&>(select);
   assert(this->n_local_ == ix.n_local_);
   const double* ix_vec = ix.data_;
   for(int i=0; i<n_local_; i++)
@@ -503,11 +542,11 @@ double hiopVectorPar::logBarrier_local(const hiopVector& select) const
 void hiopVectorPar::addLogBarrierGrad(double alpha, const hiopVector& x, const hiopVector& ix)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert(this->n_local_ == dynamic_cast<const hiopVectorPar&>(ix).n_local_);
-  assert(this->n_local_ == dynamic_cast<const hiopVectorPar&>( x).n_local_);
+  assert(this->n_local_ == known_cast<const hiopVectorPar&>(ix).n_local_);
+  assert(this->n_local_ == known_cast<const hiopVectorPar&>( x).n_local_);
 #endif
-  const double* ix_vec = dynamic_cast<const hiopVectorPar&>(ix).data_;
-  const double*  x_vec = dynamic_cast<const hiopVectorPar&>( x).data_;
+  const double* ix_vec = known_cast<const hiopVectorPar&>(ix).data_;
+  const double*  x_vec = known_cast<const hiopVectorPar&>( x).data_;
 
   for(int i=0; i<n_local_; i++) 
     if(ix_vec[i]==1.) 
@@ -519,11 +558,11 @@ double hiopVectorPar::
 linearDampingTerm_local(const hiopVector& ixleft, const hiopVector& ixright, 
 			const double& mu, const double& kappa_d) const
 {
-  const double* ixl= (dynamic_cast<const hiopVectorPar&>(ixleft)).local_data_const();
-  const double* ixr= (dynamic_cast<const hiopVectorPar&>(ixright)).local_data_const();
+  const double* ixl= (known_cast<const hiopVectorPar&>(ixleft)).local_data_const();
+  const double* ixr= (known_cast<const hiopVectorPar&>(ixright)).local_data_const();
 #ifdef HIOP_DEEPCHECKS
-  assert(n_local_==(dynamic_cast<const hiopVectorPar&>(ixleft) ).n_local_);
-  assert(n_local_==(dynamic_cast<const hiopVectorPar&>(ixright) ).n_local_);
+  assert(n_local_==(known_cast<const hiopVectorPar&>(ixleft) ).n_local_);
+  assert(n_local_==(known_cast<const hiopVectorPar&>(ixright) ).n_local_);
 #endif
   double term=0.0;
   for(long long i=0; i<n_local_; i++) {
@@ -541,7 +580,7 @@ int hiopVectorPar::allPositive()
 
 #ifdef HIOP_USE_MPI
   int allPosG;
-  int ierr=MPI_Allreduce(&allPos, &allPosG, 1, MPI_INT, MPI_MIN, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(&allPos, &allPosG, 1, MPI_INT, MPI_MIN, comm_, "vec_allPositive"); assert(MPI_SUCCESS==ierr);
   return allPosG;
 #endif
   return allPos;
@@ -552,15 +591,15 @@ bool hiopVectorPar::projectIntoBounds_local(const hiopVector& xl_, const hiopVec
 					    double kappa1, double kappa2)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(xl_) ).n_local_==n_local_);
-  assert((dynamic_cast<const hiopVectorPar&>(ixl_)).n_local_==n_local_);
-  assert((dynamic_cast<const hiopVectorPar&>(xu_) ).n_local_==n_local_);
-  assert((dynamic_cast<const hiopVectorPar&>(ixu_)).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(xl_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ixl_)).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(xu_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ixu_)).n_local_==n_local_);
 #endif
-  const double* xl = (dynamic_cast<const hiopVectorPar&>(xl_) ).local_data_const();
-  const double* ixl= (dynamic_cast<const hiopVectorPar&>(ixl_)).local_data_const();
-  const double* xu = (dynamic_cast<const hiopVectorPar&>(xu_) ).local_data_const();
-  const double* ixu= (dynamic_cast<const hiopVectorPar&>(ixu_)).local_data_const();
+  const double* xl = (known_cast<const hiopVectorPar&>(xl_) ).local_data_const();
+  const double* ixl= (known_cast<const hiopVectorPar&>(ixl_)).local_data_const();
+  const double* xu = (known_cast<const hiopVectorPar&>(xu_) ).local_data_const();
+  const double* ixu= (known_cast<const hiopVectorPar&>(ixu_)).local_data_const();
   double* x0=data_; 
 
   const double small_double = std::numeric_limits<double>::min() * 100;
@@ -603,12 +642,12 @@ bool hiopVectorPar::projectIntoBounds_local(const hiopVector& xl_, const hiopVec
 double hiopVectorPar::fractionToTheBdry_local(const hiopVector& dx, const double& tau) const 
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(dx) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(dx) ).n_local_==n_local_);
   assert(tau>0);
   assert(tau<1);
 #endif
   double alpha=1.0, aux;
-  const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
+  const double* d = (known_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data_;
   for(int i=0; i<n_local_; i++) {
 #ifdef HIOP_DEEPCHECKS
@@ -625,15 +664,15 @@ double hiopVectorPar::
 fractionToTheBdry_w_pattern_local(const hiopVector& dx, const double& tau, const hiopVector& ix) const 
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(dx) ).n_local_==n_local_);
-  assert((dynamic_cast<const hiopVectorPar&>(ix) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(dx) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ix) ).n_local_==n_local_);
   assert(tau>0);
   assert(tau<1);
 #endif
   double alpha=1.0, aux;
-  const double* d = (dynamic_cast<const hiopVectorPar&>(dx) ).local_data_const();
+  const double* d = (known_cast<const hiopVectorPar&>(dx) ).local_data_const();
   const double* x = data_;
-  const double* pat = (dynamic_cast<const hiopVectorPar&>(ix) ).local_data_const();
+  const double* pat = (known_cast<const hiopVectorPar&>(ix) ).local_data_const();
   for(int i=0; i<n_local_; i++) {
     if(d[i]>=0) continue;
     if(pat[i]==0) continue;
@@ -649,9 +688,9 @@ fractionToTheBdry_w_pattern_local(const hiopVector& dx, const double& tau, const
 void hiopVectorPar::selectPattern(const hiopVector& ix_)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(ix_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ix_) ).n_local_==n_local_);
 #endif
-  const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_) ).local_data_const();
+  const double* ix = (known_cast<const hiopVectorPar&>(ix_) ).local_data_const();
   double* x=data_;
   for(int i=0; i<n_local_; i++) if(ix[i]==0.0) x[i]=0.0;
 }
@@ -659,9 +698,9 @@ void hiopVectorPar::selectPattern(const hiopVector& ix_)
 bool hiopVectorPar::matchesPattern(const hiopVector& ix_)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(ix_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ix_) ).n_local_==n_local_);
 #endif
-  const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_) ).local_data_const();
+  const double* ix = (known_cast<const hiopVectorPar&>(ix_) ).local_data_const();
   int bmatches=true;
   double* x=data_;
   for(int i=0; (i<n_local_) && bmatches; i++) 
@@ -669,7 +708,7 @@ bool hiopVectorPar::matchesPattern(const hiopVector& ix_)
 
 #ifdef HIOP_USE_MPI
   int bmatches_glob=bmatches;
-  int ierr=MPI_Allreduce(&bmatches, &bmatches_glob, 1, MPI_INT, MPI_LAND, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(&bmatches, &bmatches_glob, 1, MPI_INT, MPI_LAND, comm_, "vec_matchesPattern"); assert(MPI_SUCCESS==ierr);
   return bmatches_glob;
 #endif
   return bmatches;
@@ -678,9 +717,9 @@ bool hiopVectorPar::matchesPattern(const hiopVector& ix_)
 int hiopVectorPar::allPositive_w_patternSelect(const hiopVector& w_)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(w_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(w_) ).n_local_==n_local_);
 #endif 
-  const double* w = (dynamic_cast<const hiopVectorPar&>(w_) ).local_data_const();
+  const double* w = (known_cast<const hiopVectorPar&>(w_) ).local_data_const();
   const double* x=data_;
   int allPos=1; 
   for(int i=0; i<n_local_ && allPos; i++) 
@@ -688,7 +727,7 @@ int hiopVectorPar::allPositive_w_patternSelect(const hiopVector& w_)
   
 #ifdef HIOP_USE_MPI
   int allPosG=allPos;
-  int ierr = MPI_Allreduce(&allPos, &allPosG, 1, MPI_INT, MPI_MIN, comm_); assert(MPI_SUCCESS==ierr);
+  int ierr = hiopAllreduce(&allPos, &allPosG, 1, MPI_INT, MPI_MIN, comm_, "vec_allPositive_w_pattern"); assert(MPI_SUCCESS==ierr);
   return allPosG;
 #endif  
   return allPos;
@@ -697,11 +736,11 @@ int hiopVectorPar::allPositive_w_patternSelect(const hiopVector& w_)
 void hiopVectorPar::adjustDuals_plh(const hiopVector& x_, const hiopVector& ix_, const double& mu, const double& kappa)
 {
 #ifdef HIOP_DEEPCHECKS
-  assert((dynamic_cast<const hiopVectorPar&>(x_) ).n_local_==n_local_);
-  assert((dynamic_cast<const hiopVectorPar&>(ix_)).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(x_) ).n_local_==n_local_);
+  assert((known_cast<const hiopVectorPar&>(ix_)).n_local_==n_local_);
 #endif
-  const double* x  = (dynamic_cast<const hiopVectorPar&>(x_ )).local_data_const();
-  const double* ix = (dynamic_cast<const hiopVectorPar&>(ix_)).local_data_const();
+  const double* x  = (known_cast<const hiopVectorPar&>(x_ )).local_data_const();
+  const double* ix = (known_cast<const hiopVectorPar&>(ix_)).local_data_const();
   double* z=data_; //the dual
   double a,b;
   for(long long i=0; i<n_local_; i++) {
@@ -50,6 +50,8 @@
 
 #include <hiopMPI.hpp>
 #include "hiopVector.hpp"
+#include "hiopMemTracker.hpp"
+#include "hiopMemoryPool.hpp"
 
 #include <cstdio>
 
@@ -60,6 +62,17 @@ class hiopVectorPar : public hiopVector
 {
 public:
   hiopVectorPar(const long long& glob_n, long long* col_part=NULL, MPI_Comm comm=MPI_COMM_SELF);
+  /**
+   * @brief Non-owning vector with the size and distribution of 'layout' whose local elements are
+   * stored in 'data', which should have at least layout.get_local_size() elements and outlive
+   * 'this'. Clones and copies of the view own their storage.
+   */
+  hiopVectorPar(const hiopVectorPar& layout, double* data);
+  /**
+   * @brief Non-owning serial vector of size 'n' whose elements are stored in 'data', for example
+   * a sub-range of the local elements of another vector: hiopVectorPar(v.local_data()+start, n).
+   */
+  hiopVectorPar(double* data, const long long& n);
   virtual ~hiopVectorPar();
 
   virtual void setToZero();
@@ -164,6 +177,13 @@ protected:
   double* data_;
   long long glob_il_, glob_iu_;
   long long n_local_;
+  //category and tracker under which the storage is recorded (the tracker of the creating thread)
+  hiopMemCategory mem_cat_;
+  hiopMemTracker* mem_tracker_;
+  //false for views, whose storage is owned by someone else
+  bool owns_data_;
+  //arena of the storage (NULL for the heap)
+  hiopMemoryPool* pool_;
 private:
   /// @brief copy constructor, for internal/private use only (it doesn't copy the elements.)
   hiopVectorPar(const hiopVectorPar&);
@@ -11,6 +11,7 @@
 #define ZAXPY   FC_GLOBAL(zaxpy, ZAXPY)
 #define DCOPY   FC_GLOBAL(dcopy, DCOPY)
 #define DGEMV   FC_GLOBAL(dgemv, DGEMV)
+#define DSPMV   FC_GLOBAL(dspmv, DSPMV)
 #define ZGEMV   FC_GLOBAL(zgemv, ZGEMV)
 #define DGEMM   FC_GLOBAL(dgemm, DGEMM)
 #define DTRSM   FC_GLOBAL(dtrsm, DTRSM)
@@ -18,6 +19,8 @@
 #define DPOTRS  FC_GLOBAL(dpotrs, DPOTRS)
 #define DSYTRF  FC_GLOBAL(dsytrf, DSYTRF)
 #define DSYTRS  FC_GLOBAL(dsytrs, DSYTRS)
+#define DSPTRF  FC_GLOBAL(dsptrf, DSPTRF)
+#define DSPTRS  FC_GLOBAL(dsptrs, DSPTRS)
 #define DLANGE  FC_GLOBAL(dlange, DLANGE)
 #define ZLANGE  FC_GLOBAL(zlange, ZLANGE)
 #define DPOSVX  FC_GLOBAL(dposvx, DPOSVC)
@@ -46,6 +49,9 @@ extern "C" void   ZAXPY(int* n, dcomplex* da, dcomplex* dx, int* incx, dcomplex*
 extern "C" void   DCOPY(int* n,  double* da, int* incx, double* dy, int* incy);
 extern "C" void   DGEMV(char* trans, int* m, int* n, double* alpha, double* a, int* lda,
 			const double* x, int* incx, double* beta, double* y, int* incy );
+/* y := alpha*A*x + beta*y, with A symmetric and supplied in packed form */
+extern "C" void   DSPMV(char* uplo, int* n, double* alpha, const double* ap,
+			const double* x, int* incx, double* beta, double* y, int* incy );
 extern "C" void   ZGEMV(char* trans, int* m, int* n, dcomplex* alpha, dcomplex* a, int* lda,
 			const dcomplex* x, int* incx, dcomplex* beta, dcomplex* y, int* incy );  
 /* C := alpha*op( A )*op( B ) + beta*C
@@ -108,6 +114,13 @@ extern "C" void DSYTRF( char* UPLO, int* N, double* A, int* LDA, int* IPIV, doub
  */
 extern "C" void DSYTRS( char* UPLO, int* N, int* NRHS, double* A, int* LDA, int* IPIV, double*B, int* LDB, int* INFO );
 
+/* DSPTRF and DSPTRS are the counterparts of DSYTRF and DSYTRS for a matrix A stored in packed
+ * format (the upper or lower triangle stored by columns in an array of size N*(N+1)/2). 
+ * DSPTRF is not blocked.
+ */
+extern "C" void DSPTRF( char* UPLO, int* N, double* AP, int* IPIV, int* INFO );
+extern "C" void DSPTRS( char* UPLO, int* N, int* NRHS, double* AP, int* IPIV, double*B, int* LDB, int* INFO );
+
 /* returns the value of the one norm,  or the Frobenius norm, or
  *  the  infinity norm,  or the  element of  largest absolute value  of a
  *  real matrix A.
@@ -61,12 +61,25 @@ namespace hiop
 {
 
 hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
+  : trace_(nlp_)
 {
   nlp = nlp_;
   //force completion of the nlp's initialization
   nlp->finalizeInitialization();
+  ls_batch_num_ = 0;
+  trial_evaluated_last_ = false;
   reloadOptions();
 
+  //the storage of the solver's objects comes from its arena
+  mem_pool_ = NULL;
+  if(nlp->options->GetString("mem_pool")=="yes") {
+    mem_pool_ = hiopMemoryPool::create(nlp->options->GetString("mem_pool_huge_pages")=="yes");
+  }
+  hiopMemPoolScope pool_scope(mem_pool_);
+
+  //the storage of the objects below is accounted as 'iterate', except for the derivatives
+  hiopMemScope mem_scope(hiopMemIterate);
+
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
@@ -74,22 +87,29 @@ hiopAlgFilterIPMBase::hiopAlgFilterIPMBase(hiopNlpFormulation* nlp_)
   logbar = new hiopLogBarProblem(nlp);
   
   _f_nlp = _f_log = 0; 
-  _c = nlp->alloc_dual_eq_vec(); 
-  _d = nlp->alloc_dual_ineq_vec();
+  _cons_buf = nlp->alloc_cons_body_vecs(_c, _d);
   
   _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
+  {
+    hiopMemScope mem_scope_jac(hiopMemJacobian);
+    _Jac_c   = nlp->alloc_Jac_c();
+    _Jac_d   = nlp->alloc_Jac_d();
+  }
   
   _f_nlp_trial = _f_log_trial = 0;
-  _c_trial = nlp->alloc_dual_eq_vec(); 
-  _d_trial = nlp->alloc_dual_ineq_vec();
+  _cons_buf_trial = nlp->alloc_cons_body_vecs(_c_trial, _d_trial);
   
   _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
+  {
+    hiopMemScope mem_scope_jac(hiopMemJacobian);
+    _Jac_c_trial   = nlp->alloc_Jac_c();
+    _Jac_d_trial   = nlp->alloc_Jac_d();
+  }
   
-  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  {
+    hiopMemScope mem_scope_hess(hiopMemHessian);
+    _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  }
   
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
@@ -113,6 +133,7 @@ void hiopAlgFilterIPMBase::destructorPart()
 
   if(_c)       delete _c;
   if(_d)       delete _d;
+  if(_cons_buf) delete _cons_buf;
   if(_grad_f)  delete _grad_f;
   if(_Jac_c)   delete _Jac_c;
   if(_Jac_d)   delete _Jac_d;
@@ -123,6 +144,7 @@ void hiopAlgFilterIPMBase::destructorPart()
 
   if(_c_trial)       delete _c_trial;
   if(_d_trial)       delete _d_trial;
+  if(_cons_buf_trial) delete _cons_buf_trial;
   if(_grad_f_trial)  delete _grad_f_trial;
   if(_Jac_c_trial)   delete _Jac_c_trial;
   if(_Jac_d_trial)   delete _Jac_d_trial;
@@ -132,6 +154,11 @@ void hiopAlgFilterIPMBase::destructorPart()
   if(logbar) delete logbar;
 
   if(dualsUpdate) delete dualsUpdate;
+
+  lsBatchFree();
+
+  //the cached blocks are not reused by the objects of a problem of different size
+  if(mem_pool_) mem_pool_->release();
 }
 hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
 {
@@ -141,6 +168,7 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
 
   if(_c)       delete _c;
   if(_d)       delete _d;
+  if(_cons_buf) delete _cons_buf;
   if(_grad_f)  delete _grad_f;
   if(_Jac_c)   delete _Jac_c;
   if(_Jac_d)   delete _Jac_d;
@@ -151,6 +179,7 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
 
   if(_c_trial)       delete _c_trial;
   if(_d_trial)       delete _d_trial;
+  if(_cons_buf_trial) delete _cons_buf_trial;
   if(_grad_f_trial)  delete _grad_f_trial;
   if(_Jac_c_trial)   delete _Jac_c_trial;
   if(_Jac_d_trial)   delete _Jac_d_trial;
@@ -160,12 +189,20 @@ hiopAlgFilterIPMBase::~hiopAlgFilterIPMBase()
   if(logbar) delete logbar;
 
   if(dualsUpdate) delete dualsUpdate;
+
+  lsBatchFree();
+
+  hiopMemoryPool::close(mem_pool_);
 }
 
 void hiopAlgFilterIPMBase::reInitializeNlpObjects() 
 {
   destructorPart();
 
+  hiopMemPoolScope pool_scope(mem_pool_);
+  //the storage of the objects below is accounted as 'iterate', except for the derivatives
+  hiopMemScope mem_scope(hiopMemIterate);
+
   it_curr = new hiopIterate(nlp);
   it_trial= it_curr->alloc_clone();
   dir     = it_curr->alloc_clone();
@@ -173,22 +210,29 @@ void hiopAlgFilterIPMBase::reInitializeNlpObjects()
   logbar = new hiopLogBarProblem(nlp);
   
   _f_nlp = _f_log = 0; 
-  _c = nlp->alloc_dual_eq_vec(); 
-  _d = nlp->alloc_dual_ineq_vec();
+  _cons_buf = nlp->alloc_cons_body_vecs(_c, _d);
   
   _grad_f  = nlp->alloc_primal_vec();
-  _Jac_c   = nlp->alloc_Jac_c();
-  _Jac_d   = nlp->alloc_Jac_d();
+  {
+    hiopMemScope mem_scope_jac(hiopMemJacobian);
+    _Jac_c   = nlp->alloc_Jac_c();
+    _Jac_d   = nlp->alloc_Jac_d();
+  }
   
   _f_nlp_trial = _f_log_trial = 0;
-  _c_trial = nlp->alloc_dual_eq_vec(); 
-  _d_trial = nlp->alloc_dual_ineq_vec();
+  _cons_buf_trial = nlp->alloc_cons_body_vecs(_c_trial, _d_trial);
   
   _grad_f_trial  = nlp->alloc_primal_vec();
-  _Jac_c_trial   = nlp->alloc_Jac_c();
-  _Jac_d_trial   = nlp->alloc_Jac_d();
+  {
+    hiopMemScope mem_scope_jac(hiopMemJacobian);
+    _Jac_c_trial   = nlp->alloc_Jac_c();
+    _Jac_d_trial   = nlp->alloc_Jac_d();
+  }
   
-  _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  {
+    hiopMemScope mem_scope_hess(hiopMemHessian);
+    _Hess_Lagr = nlp->alloc_Hess_Lagr();
+  }
   
   resid = new hiopResidual(nlp);
   resid_trial = new hiopResidual(nlp);
@@ -267,6 +311,32 @@ void hiopAlgFilterIPMBase::reloadOptions()
   theta_min = 1e7; //temporary - will be updated after ini pt is computed
 
   perf_report_kkt_ = "on"==hiop::tolower(nlp->options->GetString("time_kkt"));
+
+  ls_batch_size_ = nlp->options->GetInteger("linesearch_batch");
+  if(ls_batch_size_>1 && nlp->get_num_ranks()>1) {
+    //the user's evaluations may perform MPI collectives on the same communicator
+    ls_batch_size_ = 1;
+    nlp->log->printf(hovWarning, 
+		     "Option linesearch_batch is supported only on one MPI rank and will be ignored.\n");
+  }
+  ls_batch_num_ = 0;
+
+  linsol_mode_ = nlp->options->GetStringHandle("linsol_mode");
+
+  hess_eval_async_ = "yes"==nlp->options->GetString("hess_eval_async");
+#ifdef HIOP_USE_MPI
+  if(hess_eval_async_ && nlp->get_num_ranks()>1) {
+    //HiOp's MPI calls would occur concurrently with the user's Hessian evaluation
+    int mpi_thread_level;
+    int ierr = MPI_Query_thread(&mpi_thread_level); assert(MPI_SUCCESS==ierr); (void)ierr;
+    if(mpi_thread_level < MPI_THREAD_MULTIPLE) {
+      hess_eval_async_ = false;
+      nlp->log->printf(hovWarning,
+		       "Option hess_eval_async=yes requires MPI to be initialized with MPI_THREAD_MULTIPLE "
+		       "when running on multiple ranks. Will evaluate the Hessian synchronously.\n");
+    }
+  }
+#endif
 }
 
 void hiopAlgFilterIPMBase::resetSolverStatus() 
@@ -281,6 +351,7 @@ startingProcedure(hiopIterate& it_ini,
 		  double &f, hiopVector& c, hiopVector& d, 
 		  hiopVector& gradf,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d)
 {
+  hiopProfRegion prof_reg(nlp->runStats.prof, "starting_point");
   bool duals_avail = false;  
   if(!nlp->get_starting_point(*it_ini.get_x(),
 			      duals_avail,
@@ -387,39 +458,25 @@ evalNlp(hiopIterate& iter,
 	hiopMatrix& Hess_L)
 {
   bool new_x=true; 
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
-  hiopVectorPar& c=dynamic_cast<hiopVectorPar&>(c_);
-  hiopVectorPar& d=dynamic_cast<hiopVectorPar&>(d_);
-  hiopVectorPar& gradf=dynamic_cast<hiopVectorPar&>(gradf_);
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar& c=known_cast<hiopVectorPar&>(c_);
+  hiopVectorPar& d=known_cast<hiopVectorPar&>(d_);
+  hiopVectorPar& gradf=known_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();//local_data_const();
-  //f(x)
-  if(!nlp->eval_f(x, new_x, f)) {
-    nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
+  //f(x) and its gradient, in one call when the user provides the combined callback
+  if(!nlp->eval_f_grad_f(x, new_x, f, gradf.local_data())) {
+    nlp->log->printf(hovError, "Error occured in user objective or gradient evaluation\n");
     return false;
   }
   new_x= false; //same x for the rest
   
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
-    return false;
-  }
-  
-  //bret = nlp->eval_c        (x, new_x, c.local_data());  assert(bret);
-  //bret = nlp->eval_d        (x, new_x, d.local_data());  assert(bret);
-  if(!nlp->eval_c_d(x, new_x, c.local_data(), d.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
-    return false;
+  //constraints and Jacobian, in one call when the user provides the combined callback
+  if(!nlp->eval_c_d_Jac_c_d(x, new_x, c.local_data(), d.local_data(), Jac_c, Jac_d)) {
+    nlp->log->printf(hovError, "Error occured in user constraint(s) or Jacobian evaluation\n");
+    return false; 
   }
-
   //nlp->log->write("Eq   body c:", c, hovFcnEval);
   //nlp->log->write("Ineq body d:", d, hovFcnEval);
-  
-  //bret = nlp->eval_Jac_c    (x, new_x, Jac_c);           assert(bret);
-  //bret = nlp->eval_Jac_d    (x, new_x, Jac_d);           assert(bret);
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
-    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
-    return false; 
-  }
   const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
   const hiopVectorPar* yd = dynamic_cast<const hiopVectorPar*>(iter.get_yd()); assert(yd);
   const int new_lambda = true;
@@ -439,39 +496,25 @@ evalNlp_noHess(hiopIterate& iter,
 	       hiopVector& gradf_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d)
 {
   bool new_x=true; 
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
-  hiopVectorPar& c=dynamic_cast<hiopVectorPar&>(c_);
-  hiopVectorPar& d=dynamic_cast<hiopVectorPar&>(d_);
-  hiopVectorPar& gradf=dynamic_cast<hiopVectorPar&>(gradf_);
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar& c=known_cast<hiopVectorPar&>(c_);
+  hiopVectorPar& d=known_cast<hiopVectorPar&>(d_);
+  hiopVectorPar& gradf=known_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();//local_data_const();
-  //f(x)
-  if(!nlp->eval_f(x, new_x, f)) {
-    nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
+  //f(x) and its gradient, in one call when the user provides the combined callback
+  if(!nlp->eval_f_grad_f(x, new_x, f, gradf.local_data())) {
+    nlp->log->printf(hovError, "Error occured in user objective or gradient evaluation\n");
     return false;
   }
   new_x= false; //same x for the rest
   
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
-    return false;
-  }
-  
-  //bret = nlp->eval_c        (x, new_x, c.local_data());  assert(bret);
-  //bret = nlp->eval_d        (x, new_x, d.local_data());  assert(bret);
-  if(!nlp->eval_c_d(x, new_x, c.local_data(), d.local_data())) {
-    nlp->log->printf(hovError, "Error occured in user constraint(s) function evaluation\n");
-    return false;
+  //constraints and Jacobian, in one call when the user provides the combined callback
+  if(!nlp->eval_c_d_Jac_c_d(x, new_x, c.local_data(), d.local_data(), Jac_c, Jac_d)) {
+    nlp->log->printf(hovError, "Error occured in user constraint(s) or Jacobian evaluation\n");
+    return false; 
   }
-
   //nlp->log->write("Eq   body c:", c, hovFcnEval);
   //nlp->log->write("Ineq body d:", d, hovFcnEval);
-  
-  //bret = nlp->eval_Jac_c    (x, new_x, Jac_c);           assert(bret);
-  //bret = nlp->eval_Jac_d    (x, new_x, Jac_d);           assert(bret);
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
-    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
-    return false; 
-  }
   return true;
 }
 
@@ -480,7 +523,7 @@ bool hiopAlgFilterIPMBase::evalNlp_HessOnly(hiopIterate& iter,
 {
   const bool new_x = false; //precondition is that 'evalNlp_noHess' was called just before
 
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
   
   const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
   const hiopVectorPar* yd = dynamic_cast<const hiopVectorPar*>(iter.get_yd()); assert(yd);
@@ -521,6 +564,7 @@ evalNlpAndLogErrors(const hiopIterate& it, const hiopResidual& resid, const doub
 		    double& nlpoptim, double& nlpfeas, double& nlpcomplem, double& nlpoverall,
 		    double& logoptim, double& logfeas, double& logcomplem, double& logoverall)
 {
+  hiopProfRegion prof_reg(nlp->runStats.prof, "errors");
   nlp->runStats.tmSolverInternal.start();
 
   long long n=nlp->n_complem(), m=nlp->m();
@@ -581,9 +625,9 @@ bool hiopAlgFilterIPMBase::evalNlp_funcOnly(hiopIterate& iter,
 					    double& f, hiopVector& c_, hiopVector& d_)
 {
   bool new_x=true; 
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
-  hiopVectorPar& c=dynamic_cast<hiopVectorPar&>(c_);
-  hiopVectorPar& d=dynamic_cast<hiopVectorPar&>(d_);
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar& c=known_cast<hiopVectorPar&>(c_);
+  hiopVectorPar& d=known_cast<hiopVectorPar&>(d_);
   double* x = it_x.local_data();
   if(!nlp->eval_f(x, new_x, f)) {
     nlp->log->printf(hovError, "Error occured in user objective evaluation\n");
@@ -597,21 +641,145 @@ bool hiopAlgFilterIPMBase::evalNlp_funcOnly(hiopIterate& iter,
   return true;
 }
 
+bool hiopAlgFilterIPMBase::evalNlp_funcOnly_trial(double& f, hiopVector& c_, hiopVector& d_)
+{
+  hiopProfRegion prof_reg(nlp->runStats.prof, "ls_trial_eval");
+  if(ls_batch_size_<=1 || !nlp->eval_funcs_concurrent_avail()) {
+    trial_evaluated_last_ = true;
+    return evalNlp_funcOnly(*it_trial, f, c_, d_);
+  }
+  //the user's last evaluation may be at another step length of the batch
+  trial_evaluated_last_ = false;
+
+  //the step length was evaluated at a previous trial of this line search
+  for(int k=0; k<ls_batch_num_; ++k) {
+    if(ls_batch_alpha_[k]==_alpha_primal) {
+      f = ls_batch_f_[k];
+      c_.copyFrom(*ls_batch_c_[k]);
+      d_.copyFrom(*ls_batch_d_[k]);
+      return true;
+    }
+  }
+
+  lsBatchAlloc();
+
+  //trial points for the step lengths alpha, alpha/2, alpha/4, ... (same halving as in the
+  //backtracking, so that the cached step lengths match exactly); the first one is 'it_trial'
+  ls_batch_num_ = 0;
+  double alpha = _alpha_primal;
+  for(int k=0; k<ls_batch_size_; ++k) {
+    if(k>0 && alpha<1e-16) break;
+    ls_batch_alpha_[k] = alpha;
+    if(k==0) {
+      ls_batch_x_[k]->copyFrom(*it_trial->get_x());
+    } else {
+      ls_batch_x_[k]->copyFrom(*it_curr->get_x());
+      ls_batch_x_[k]->axpy(alpha, *dir->get_x());
+    }
+    ls_batch_num_++;
+    alpha *= 0.5;
+  }
+
+  nlp->runStats.tmEvalObj.start();
+  std::vector<std::future<bool> > evals(ls_batch_num_);
+  hiopMemTracker* mem_tracker = &hiopMemTracker::global();
+  for(int k=1; k<ls_batch_num_; ++k) {
+    evals[k] = std::async(std::launch::async, [this, k, mem_tracker]() {
+	hiopMemTrackerScope mem_tracker_scope(*mem_tracker);
+	return nlp->eval_f_c_d_concurrent(ls_batch_x_[k]->local_data_const(), ls_batch_f_[k], 
+					  ls_batch_c_[k]->local_data(), ls_batch_d_[k]->local_data(),
+					  ls_batch_cons_[k]);
+      });
+  }
+  bool bret = nlp->eval_f_c_d_concurrent(ls_batch_x_[0]->local_data_const(), ls_batch_f_[0], 
+					 ls_batch_c_[0]->local_data(), ls_batch_d_[0]->local_data(),
+					 ls_batch_cons_[0]);
+  //keep the speculative evaluations only up to the first failure; the failed step length, if
+  //reached by the backtracking, is evaluated again
+  int num_ok = bret ? 1 : 0;
+  for(int k=1; k<ls_batch_num_; ++k) {
+    if(evals[k].get() && num_ok==k) {
+      num_ok++;
+    }
+  }
+  nlp->runStats.tmEvalObj.stop();
+  nlp->runStats.nEvalObj += ls_batch_num_;
+  nlp->runStats.nEvalCons_eq += ls_batch_num_;
+  nlp->runStats.nEvalCons_ineq += ls_batch_num_;
+
+  nlp->log->printf(hovLinesearchVerb, "Linesearch: evaluated %d trial points concurrently "
+		   "(%d successful)\n", ls_batch_num_, num_ok);
+  ls_batch_num_ = num_ok;
+
+  if(!bret) {
+    nlp->log->printf(hovError, "Error occured in user objective or constraint(s) function evaluation\n");
+    return false;
+  }
+  f = ls_batch_f_[0];
+  c_.copyFrom(*ls_batch_c_[0]);
+  d_.copyFrom(*ls_batch_d_[0]);
+  return true;
+}
+
+void hiopAlgFilterIPMBase::lsBatchAlloc()
+{
+  if(ls_batch_x_.size()==(size_t)ls_batch_size_ &&
+     ls_batch_x_[0]->get_size()==nlp->n() &&
+     ls_batch_c_[0]->get_size()==nlp->m_eq() &&
+     ls_batch_d_[0]->get_size()==nlp->m_ineq()) {
+    return;
+  }
+  lsBatchFree();
+  ls_batch_alpha_.resize(ls_batch_size_);
+  ls_batch_f_.resize(ls_batch_size_);
+  for(int k=0; k<ls_batch_size_; ++k) {
+    ls_batch_x_.push_back(nlp->alloc_primal_vec());
+    ls_batch_c_.push_back(nlp->alloc_dual_eq_vec());
+    ls_batch_d_.push_back(nlp->alloc_dual_ineq_vec());
+    ls_batch_cons_.push_back(new double[nlp->m()]);
+  }
+}
+
+void hiopAlgFilterIPMBase::lsBatchFree()
+{
+  for(size_t k=0; k<ls_batch_x_.size(); ++k) {
+    delete ls_batch_x_[k];
+    delete ls_batch_c_[k];
+    delete ls_batch_d_[k];
+    delete[] ls_batch_cons_[k];
+  }
+  ls_batch_x_.clear();
+  ls_batch_c_.clear();
+  ls_batch_d_.clear();
+  ls_batch_cons_.clear();
+  ls_batch_num_ = 0;
+}
+
 bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
 					     hiopVector& gradf_,
 					     hiopMatrix& Jac_c,
 					     hiopMatrix& Jac_d,
 					     hiopMatrix& Hess_L)
 {
-  bool new_x=false; //functions were previously evaluated in the line search
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*iter.get_x());
-  hiopVectorPar & gradf=dynamic_cast<hiopVectorPar&>(gradf_);
+  hiopProfRegion prof_reg(nlp->runStats.prof, "eval_derivs");
+  //the functions were previously evaluated at the trial point in the line search, unless the
+  //trial point was evaluated concurrently or taken from the line-search cache
+  bool new_x = !trial_evaluated_last_;
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar & gradf=known_cast<hiopVectorPar&>(gradf_);
   double* x = it_x.local_data();
-  if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
+  //the combined callbacks are used when provided; the objective and constraints are discarded
+  double f_discarded;
+  if(nlp->f_grad_combined()) {
+    if(!nlp->eval_f_grad_f(x, new_x, f_discarded, gradf.local_data())) {
+      nlp->log->printf(hovError, "Error occured in user objective or gradient evaluation\n");
+      return false;
+    }
+  } else if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
     nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
     return false;
   }
-  if(!nlp->eval_Jac_c_d(x, new_x, Jac_c, Jac_d)) {
+  if(!nlp->eval_c_d_Jac_c_d(x, new_x, NULL, NULL, Jac_c, Jac_d)) {
     nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
     return false; 
   }
@@ -629,6 +797,52 @@ bool hiopAlgFilterIPMBase::evalNlp_derivOnly(hiopIterate& iter,
   return true;
 }
 
+bool hiopAlgFilterIPMBase::evalNlp_derivOnly_asyncHess(hiopIterate& iter,
+						       hiopVector& gradf_,
+						       hiopMatrix& Jac_c,
+						       hiopMatrix& Jac_d,
+						       hiopMatrix& Hess_L,
+						       std::future<bool>& hess_eval)
+{
+  hiopProfRegion prof_reg(nlp->runStats.prof, "eval_derivs");
+  //the functions were previously evaluated at the trial point in the line search, unless the
+  //trial point was evaluated concurrently or taken from the line-search cache
+  bool new_x = !trial_evaluated_last_;
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*iter.get_x());
+  hiopVectorPar & gradf=known_cast<hiopVectorPar&>(gradf_);
+  double* x = it_x.local_data();
+  //the combined callbacks are used when provided; the objective and constraints are discarded
+  double f_discarded;
+  if(nlp->f_grad_combined()) {
+    if(!nlp->eval_f_grad_f(x, new_x, f_discarded, gradf.local_data())) {
+      nlp->log->printf(hovError, "Error occured in user objective or gradient evaluation\n");
+      return false;
+    }
+  } else if(!nlp->eval_grad_f(x, new_x, gradf.local_data())) {
+    nlp->log->printf(hovError, "Error occured in user gradient evaluation\n");
+    return false;
+  }
+  if(!nlp->eval_c_d_Jac_c_d(x, new_x, NULL, NULL, Jac_c, Jac_d)) {
+    nlp->log->printf(hovError, "Error occured in user Jacobian function evaluation\n");
+    return false; 
+  }
+
+  const hiopVectorPar* yc = dynamic_cast<const hiopVectorPar*>(iter.get_yc()); assert(yc);
+  const hiopVectorPar* yd = dynamic_cast<const hiopVectorPar*>(iter.get_yd()); assert(yd);
+  const double* yc_data = yc->local_data_const();
+  const double* yd_data = yd->local_data_const();
+  hiopNlpFormulation* nlp_ = nlp;
+  hiopMemTracker* mem_tracker = &hiopMemTracker::global();
+  hess_eval = std::async(std::launch::async, 
+			 [nlp_, x, new_x, yc_data, yd_data, &Hess_L, mem_tracker]() -> bool
+			 {
+			   hiopMemTrackerScope mem_tracker_scope(*mem_tracker);
+			   const int new_lambda = true;
+			   return nlp_->eval_Hess_Lagr(x, new_x, 1., yc_data, yd_data, new_lambda, Hess_L);
+			 });
+  return true;
+}
+
 /* returns the objective value; valid only after 'run' method has been called */
 double hiopAlgFilterIPMBase::getObjective() const
 {
@@ -653,7 +867,7 @@ void hiopAlgFilterIPMBase::getSolution(double* x) const
     nlp->log->
       printf(hovWarning, "getSolution: HiOp has not completed yet and solution returned may not be optimal.");
   }
-  hiopVectorPar& it_x = dynamic_cast<hiopVectorPar&>(*it_curr->get_x());
+  hiopVectorPar& it_x = known_cast<hiopVectorPar&>(*it_curr->get_x());
   //it_curr->get_x()->copyTo(x);
   nlp->user_x(it_x, x);
 }
@@ -670,8 +884,8 @@ void hiopAlgFilterIPMBase::getDualSolutions(double* zl_a, double* zu_a, double*
       printf(hovWarning,
 	     "getSolution: HiOp has not completed yet and solution returned may not be optimal.");
   }
-  hiopVectorPar& zl = dynamic_cast<hiopVectorPar&>(*it_curr->get_zl());
-  hiopVectorPar& zu = dynamic_cast<hiopVectorPar&>(*it_curr->get_zu());
+  hiopVectorPar& zl = known_cast<hiopVectorPar&>(*it_curr->get_zl());
+  hiopVectorPar& zu = known_cast<hiopVectorPar&>(*it_curr->get_zu());
 
   nlp->get_dual_solutions(*it_curr, zl_a, zu_a, lambda_a);  
 }
@@ -711,6 +925,25 @@ checkTermination(const double& err_nlp, const int& iter_num, hiopSolveStatus& st
   return false;
 }
 /***** Termination message *****/
+bool hiopAlgFilterIPMBase::checkMemoryLimit()
+{
+  const hiopMemTracker& mem = hiopMemTracker::global();
+  if(!mem.limit_exceeded()) return true;
+
+  const double MB = 1024.*1024.;
+  if(mem.get_failed_request()>0) {
+    nlp->log->printf(hovError, "Memory limit exceeded: an allocation of %.3f MB on top of the "
+		     "current %.3f MB would exceed the limit of %.3f MB (option 'mem_limit').\n",
+		     mem.get_failed_request()/MB, mem.get_current()/MB, mem.get_limit()/MB);
+  } else {
+    nlp->log->printf(hovError, "Memory limit exceeded: %.3f MB allocated exceed the limit of "
+		     "%.3f MB (option 'mem_limit').\n", mem.get_peak()/MB, mem.get_limit()/MB);
+  }
+  nlp->log->write(mem.get_report().c_str(), hovError);
+  nlp->log->flush();
+  return false;
+}
+
 void hiopAlgFilterIPMBase::displayTerminationMsg()
 {
   std::string strStatsReport = nlp->runStats.get_summary() + nlp->runStats.kkt.get_summary_total();
@@ -764,6 +997,12 @@ void hiopAlgFilterIPMBase::displayTerminationMsg()
       break;
     }
   };
+  if(nlp->runStats.prof.is_enabled()) {
+    //the report can be longer than the logger's printf buffer
+    nlp->log->write("Profile of the regions:", hovSummary);
+    nlp->log->write(nlp->runStats.prof.get_report().c_str(), hovSummary);
+  }
+  if(mem_pool_) nlp->log->printf(hovSummary, "%s", mem_pool_->get_report().c_str());
 }
 
 
@@ -793,6 +1032,8 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   //also reload options
   reloadOptions();
 
+  hiopMemPoolScope pool_scope(mem_pool_);
+
   //if nlp changed internally, we need to reinitialize 'this'
   if(it_curr->get_x()->get_size()!=nlp->n() ||
      //Jac_c->get_local_size_n()!=nlpdc->n_local()) { <- this is prone to racing conditions
@@ -808,6 +1049,19 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   hiopHessianLowRank* Hess = dynamic_cast<hiopHessianLowRank*>(_Hess_Lagr);
 
   nlp->runStats.initialize();
+  nlp->runStats.kkt.initialize();
+  if(!nlp->runStats.kkt.enable_hw_counters("on"==nlp->options->GetString("time_kkt_counters"))) {
+    nlp->log->printf(hovWarning, "The hardware counters of the KKT phases are not available "
+		     "(perf_event_open failed) and were turned off.\n");
+  }
+  nlp->runStats.prof.reset("on"==hiop::tolower(nlp->options->GetString("time_regions")));
+  hiopCommProfiler::global().reset(nlp->options->GetString("time_comm")!="off",
+				   nlp->options->GetString("time_comm")=="ranks");
+  hiopMemTracker::global().reset((long long)(nlp->options->GetNumeric("mem_limit")*1024*1024));
+  if(!checkMemoryLimit()) {
+    return solver_status_ = Memory_Alloc_Problem;
+  }
+  trace_.open();
   ////////////////////////////////////////////////////////////////////////////////////
   // run baby run
   ////////////////////////////////////////////////////////////////////////////////////
@@ -821,6 +1075,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
   nlp->runStats.tmOptimizTotal.start();
+  hiopProfRegion prof_run(nlp->runStats.prof, "run");
 
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
   _mu=mu0;
@@ -838,7 +1093,11 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   theta_max=1e+4*fmax(1.0,resid->getInfeasInfNorm());
   theta_min=1e-4*fmax(1.0,resid->getInfeasInfNorm());
   
-  hiopKKTLinSysLowRank* kkt=new hiopKKTLinSysLowRank(nlp);
+  hiopKKTLinSysLowRank* kkt;
+  {
+    hiopMemScope mem_scope(hiopMemKKT);
+    kkt = new hiopKKTLinSysLowRank(nlp);
+  }
 
   _alpha_primal = _alpha_dual = 0;
 
@@ -854,6 +1113,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
   bool bret=true; int lsStatus=-1, lsNum=0;
   solver_status_ = NlpSolve_Pending;
   while(true) {
+    hiopProfRegion prof_iter(nlp->runStats.prof, "iteration");
 
     bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
@@ -870,6 +1130,10 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
 		     "  LogBar errs: pr-infeas:%23.17e   dual-infeas:%23.17e  comp:%23.17e  overall:%23.17e\n",
 		     _err_log_feas, _err_log_optim, _err_log_complem, _err_log);
     outputIteration(lsStatus, lsNum);
+    if(trace_.is_on()) {
+      trace_.write_iter(iter_num, _f_nlp, _err_nlp_feas, _err_nlp_optim, _mu,
+			_alpha_primal, _alpha_dual, lsNum, kkt->get_linsys_size());
+    }
 
     if(_err_nlp_optim0<0) { // && _err_nlp_feas0<0 && _err_nlp_complem0<0 
       _err_nlp_optim0=_err_nlp_optim; _err_nlp_feas0=_err_nlp_feas; _err_nlp_complem0=_err_nlp_complem;
@@ -935,12 +1199,36 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
      * Search direction calculation
      ***************************************************/
     //first update the Hessian and kkt system
-    Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
-    kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
-    bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    nlp->runStats.kkt.start_optimiz_iteration();
+    {
+      hiopProfRegion prof_reg(nlp->runStats.prof, "hess_update");
+      hiopMemScope mem_scope(hiopMemLowRank);
+      Hess->update(*it_curr,*_grad_f,*_Jac_c,*_Jac_d);
+    }
+    {
+      hiopProfRegion prof_reg(nlp->runStats.prof, "kkt_update");
+      hiopMemScope mem_scope(hiopMemKKT);
+      kkt->update(it_curr, _grad_f, Jac_c, Jac_d, Hess);
+    }
+    if(!checkMemoryLimit()) {
+      nlp->runStats.kkt.end_optimiz_iteration();
+      delete kkt;
+      return solver_status_ = Memory_Alloc_Problem;
+    }
+    {
+      hiopProfRegion prof_reg(nlp->runStats.prof, "kkt_solve");
+      hiopMemScope mem_scope(hiopMemKKT);
+      bret = kkt->computeDirections(resid,dir); assert(bret==true);
+    }
+    nlp->runStats.kkt.end_optimiz_iteration();
+    if(perf_report_kkt_) {
+      nlp->log->printf(hovSummary, "%s", nlp->runStats.kkt.get_summary_last_iter().c_str());
+    }
 
-    nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
-    nlp->log->write("", *dir, hovIteration);
+    if(nlp->log->is_active(hovIteration)) {
+      nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
+      nlp->log->write("", *dir, hovIteration);
+    }
     /***************************************************************
      * backtracking line search
      ****************************************************************/
@@ -959,6 +1247,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     //2 close to solution but switching condition does not hold, so trial accepted based on "sufficient decrease"
     //3 close to solution and switching condition is true; trial accepted based on Armijo
     lsStatus=0; lsNum=0;
+    ls_batch_num_ = 0;
 
     bool grad_phi_dx_computed=false, iniStep=true; double grad_phi_dx;
 
@@ -984,7 +1273,7 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
       nlp->runStats.tmSolverInternal.stop(); //---
 
       //evaluate the problem at the trial iterate (functions only)
-      if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
+      if(!this->evalNlp_funcOnly_trial(_f_nlp_trial, *_c_trial, *_d_trial)) {
 	solver_status_ = Error_In_User_Function;
 	return Error_In_User_Function;
       }
@@ -1126,28 +1415,37 @@ hiopSolveStatus hiopAlgFilterIPMQuasiNewton::run()
     //it_trial->takeStep_duals(*it_curr, *dir, _alpha_primal, _alpha_dual); assert(bret);
     //bret = it_trial->adjustDuals_primalLogHessian(_mu,kappa_Sigma); assert(bret);
     assert(infeas_nrm_trial>=0 && "this should not happen");
-    bret = dualsUpdate->go(*it_curr, *it_trial, 
-			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
-			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    {
+      hiopProfRegion prof_reg(nlp->runStats.prof, "duals_update");
+      bret = dualsUpdate->go(*it_curr, *it_trial, 
+			     _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
+			     _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    }
 
     //update current iterate (do a fast swap of the pointers)
     hiopIterate* pit=it_curr; it_curr=it_trial; it_trial=pit;
-    nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num);
-    nlp->log->write("", *it_curr, hovIteration);
+    if(nlp->log->is_active(hovIteration)) {
+      nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num);
+      nlp->log->write("", *it_curr, hovIteration);
+    }
     nlp->runStats.tmSolverInternal.stop(); //-----
 
     //notify logbar about the changes
     logbar->updateWithNlpInfo(*it_curr, _mu, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d);
     //update residual
     resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
-    nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
-    nlp->log->write("", *resid, hovIteration);
+    if(nlp->log->is_active(hovIteration)) {
+      nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
+      nlp->log->write("", *resid, hovIteration);
+    }
   }
 
   nlp->runStats.tmOptimizTotal.stop();
 
   //solver_status_ contains the termination information
   displayTerminationMsg();
+  trace_.close();
+  nlp->log->flush();
 
   //user callback
   nlp->user_callback_solution(solver_status_,
@@ -1200,7 +1498,8 @@ decideAndCreateLinearSystem(hiopNlpFormulation* nlp)
   //hiopNlpMDS* nlpMDS = NULL;
   hiopNlpMDS* nlpMDS = dynamic_cast<hiopNlpMDS*>(nlp);
 
-  if(NULL == nlpMDS) {
+  //the dense linear systems need only the generic matrix operations, which the MDS matrices have
+  if(NULL == nlpMDS || nlp->options->GetString("kkt_dense_mds")=="yes") {
     std::string strKKT = nlp->options->GetString("KKTLinsys");
     if(strKKT == "xdycyd")
       return new hiopKKTLinSysDenseXDYcYd(nlp);
@@ -1220,6 +1519,8 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   //also reload options
   reloadOptions();
 
+  hiopMemPoolScope pool_scope(mem_pool_);
+
   //if nlp changed internally, we need to reinitialize 'this'
   if(it_curr->get_x()->get_size()!=nlp->n() ||
      //Jac_c->get_local_size_n()!=nlpdc->n_local()) { <- this is prone to racing conditions
@@ -1231,6 +1532,18 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 
   nlp->runStats.initialize();
   nlp->runStats.kkt.initialize();
+  if(!nlp->runStats.kkt.enable_hw_counters("on"==nlp->options->GetString("time_kkt_counters"))) {
+    nlp->log->printf(hovWarning, "The hardware counters of the KKT phases are not available "
+		     "(perf_event_open failed) and were turned off.\n");
+  }
+  nlp->runStats.prof.reset("on"==hiop::tolower(nlp->options->GetString("time_regions")));
+  hiopCommProfiler::global().reset(nlp->options->GetString("time_comm")!="off",
+				   nlp->options->GetString("time_comm")=="ranks");
+  hiopMemTracker::global().reset((long long)(nlp->options->GetNumeric("mem_limit")*1024*1024));
+  if(!checkMemoryLimit()) {
+    return solver_status_ = Memory_Alloc_Problem;
+  }
+  trace_.open();
   
   if(!pd_perturb_.initialize(nlp)) {
     return SolveInitializationError;
@@ -1249,6 +1562,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   nlp->log->write("---------------\nProblem Summary\n---------------", *nlp, hovSummary);
 
   nlp->runStats.tmOptimizTotal.start();
+  hiopProfRegion prof_run(nlp->runStats.prof, "run");
 
   startingProcedure(*it_curr, _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d); //this also evaluates the nlp
   _mu=mu0;
@@ -1269,7 +1583,11 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   theta_max=1e+4*fmax(1.0,resid->getInfeasInfNorm());
   theta_min=1e-4*fmax(1.0,resid->getInfeasInfNorm());
   
-  hiopKKTLinSysCompressed* kkt = decideAndCreateLinearSystem(nlp);
+  hiopKKTLinSysCompressed* kkt;
+  {
+    hiopMemScope mem_scope(hiopMemKKT);
+    kkt = decideAndCreateLinearSystem(nlp);
+  }
   assert(kkt != NULL);
   kkt->set_PD_perturb_calc(&pd_perturb_);
   
@@ -1287,11 +1605,16 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
   int lsStatus=-1, lsNum=0;
 
   int linsol_safe_mode_lastiter = -1;
-  bool linsol_safe_mode_on = "stable"==hiop::tolower(nlp->options->GetString("linsol_mode")); 
-  bool linsol_forcequick = "forcequick"==hiop::tolower(nlp->options->GetString("linsol_mode"));
+  bool linsol_safe_mode_on = "stable"==*linsol_mode_; 
+  bool linsol_forcequick = "forcequick"==*linsol_mode_;
+
+  //Hessian evaluation launched asynchronously at the end of the previous iteration; valid only
+  //when hess_eval_async_ is true
+  std::future<bool> hess_eval;
 
   solver_status_ = NlpSolve_Pending;
   while(true) {
+    hiopProfRegion prof_iter(nlp->runStats.prof, "iteration");
 
     bret = evalNlpAndLogErrors(*it_curr, *resid, _mu, 
 			       _err_nlp_optim, _err_nlp_feas, _err_nlp_complem, _err_nlp, 
@@ -1315,6 +1638,19 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       _err_nlp_optim0=_err_nlp_optim; _err_nlp_feas0=_err_nlp_feas; _err_nlp_complem0=_err_nlp_complem;
     }
 
+    //wait for the Hessian before calling back the user, so that user's code is not called concurrently
+    if(hess_eval.valid()) {
+      if(!hess_eval.get()) {
+	nlp->log->printf(hovError, "Error occured in user Hessian function evaluation\n");
+	solver_status_ = Error_In_User_Function;
+	return Error_In_User_Function;
+      }
+    }
+    if(trace_.is_on()) {
+      trace_.write_iter(iter_num, _f_nlp, _err_nlp_feas, _err_nlp_optim, _mu,
+			_alpha_primal, _alpha_dual, lsNum, kkt->get_linsys_size());
+    }
+
     //user callback
     if(!nlp->user_callback_iterate(iter_num, _f_nlp, 
 				   *it_curr->get_x(),
@@ -1401,7 +1737,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 	  
 	} else {
 	  // to do	  if(linsol_safe_mode_on || noinertiacorr)
-	  if("speculative"==hiop::tolower(nlp->options->GetString("linsol_mode"))) {
+	  if("speculative"==*linsol_mode_) {
 	    linsol_safe_mode_on=false;
 	  }
 	}
@@ -1416,7 +1752,18 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //
       //update the Hessian and kkt system; usually a matrix factorization occurs
       //
-      if(!kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr)) {
+      bool kkt_ok;
+      {
+	hiopProfRegion prof_reg(nlp->runStats.prof, "kkt_update");
+	hiopMemScope mem_scope(hiopMemKKT);
+	kkt_ok = kkt->update(it_curr, _grad_f, _Jac_c, _Jac_d, _Hess_Lagr);
+      }
+      if(!checkMemoryLimit()) {
+	nlp->runStats.kkt.end_optimiz_iteration();
+	delete kkt;
+	return solver_status_ = Memory_Alloc_Problem;
+      }
+      if(!kkt_ok) {
 
 	nlp->runStats.kkt.end_optimiz_iteration();
 
@@ -1450,7 +1797,12 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //
       // solve for search directions
       //
-      if(!kkt->computeDirections(resid, dir)) {
+      {
+	hiopProfRegion prof_reg(nlp->runStats.prof, "kkt_solve");
+	hiopMemScope mem_scope(hiopMemKKT);
+	kkt_ok = kkt->computeDirections(resid, dir);
+      }
+      if(!kkt_ok) {
 	
 	nlp->runStats.kkt.start_optimiz_iteration();
 	
@@ -1486,8 +1838,10 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 	nlp->log->printf(hovSummary, "%s", nlp->runStats.kkt.get_summary_last_iter().c_str());
       }
     
-      nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
-      nlp->log->write("", *dir, hovIteration);
+      if(nlp->log->is_active(hovIteration)) {
+        nlp->log->printf(hovIteration, "Iter[%d] full search direction -------------\n", iter_num);
+        nlp->log->write("", *dir, hovIteration);
+      }
       /***************************************************************
        * backtracking line search
        ****************************************************************/
@@ -1506,6 +1860,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
       //2 close to solution but switching condition does not hold; trial accepted based on "sufficient decrease"
       //3 close to solution and switching condition is true; trial accepted based on Armijo
       lsStatus=0; lsNum=0;
+      ls_batch_num_ = 0;
       
       bool grad_phi_dx_computed=false, iniStep=true; double grad_phi_dx;
       
@@ -1536,7 +1891,7 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
 	nlp->runStats.tmSolverInternal.stop(); //---
 	
 	//evaluate the problem at the trial iterate (functions only)
-	if(!this->evalNlp_funcOnly(*it_trial, _f_nlp_trial, *_c_trial, *_d_trial)) {
+	if(!this->evalNlp_funcOnly_trial(_f_nlp_trial, *_c_trial, *_d_trial)) {
 	  solver_status_ = Error_In_User_Function;
 	  return Error_In_User_Function;
 	}
@@ -1738,14 +2093,26 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     // this needs to be done before evalNlp_derivOnly so that the user's NLP functions
     // get the updated duals
     assert(infeas_nrm_trial>=0 && "this should not happen");
-    bret = dualsUpdate->go(*it_curr, *it_trial, 
-			   _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
-			   _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    {
+      hiopProfRegion prof_reg(nlp->runStats.prof, "duals_update");
+      bret = dualsUpdate->go(*it_curr, *it_trial, 
+			     _f_nlp, *_c, *_d, *_grad_f, *_Jac_c, *_Jac_d, *dir,  
+			     _alpha_primal, _alpha_dual, _mu, kappa_Sigma, infeas_nrm_trial); assert(bret);
+    }
 
     //evaluate derivatives at the trial (and to be accepted) trial point
-    if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)) {
-      solver_status_ = Error_In_User_Function;
-      return Error_In_User_Function;
+    if(hess_eval_async_) {
+      //the Hessian is evaluated while the logbar, the residuals, and the errors are updated below
+      if(!this->evalNlp_derivOnly_asyncHess(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr,
+					    hess_eval)) {
+	solver_status_ = Error_In_User_Function;
+	return Error_In_User_Function;
+      }
+    } else {
+      if(!this->evalNlp_derivOnly(*it_trial, *_grad_f, *_Jac_c, *_Jac_d, *_Hess_Lagr)) {
+	solver_status_ = Error_In_User_Function;
+	return Error_In_User_Function;
+      }
     }
 
     nlp->runStats.tmSolverInternal.start(); //-----
@@ -1758,8 +2125,10 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     //
     hiopIterate* pit=it_curr; it_curr=it_trial; it_trial=pit;
     
-    nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num);
-    nlp->log->write("", *it_curr, hovIteration);
+    if(nlp->log->is_active(hovIteration)) {
+      nlp->log->printf(hovIteration, "Iter[%d] -> full iterate:", iter_num);
+      nlp->log->write("", *it_curr, hovIteration);
+    }
     
     nlp->runStats.tmSolverInternal.stop(); //-----
 
@@ -1768,14 +2137,18 @@ hiopSolveStatus hiopAlgFilterIPMNewton::run()
     //update residual
     resid->update(*it_curr,_f_nlp, *_c, *_d,*_grad_f,*_Jac_c,*_Jac_d, *logbar);
     
-    nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
-    nlp->log->write("", *resid, hovIteration);
+    if(nlp->log->is_active(hovIteration)) {
+      nlp->log->printf(hovIteration, "Iter[%d] full residual:-------------\n", iter_num);
+      nlp->log->write("", *resid, hovIteration);
+    }
   }
 
   nlp->runStats.tmOptimizTotal.stop();
 
   //solver_status_ contains the termination information
   displayTerminationMsg();
+  trace_.close();
+  nlp->log->flush();
 
   //user callback
   nlp->user_callback_solution(solver_status_,
@@ -58,9 +58,13 @@
 #include "hiopLogBarProblem.hpp"
 #include "hiopDualsUpdater.hpp"
 #include "hiopPDPerturbation.hpp"
+#include "hiopIterTrace.hpp"
 
 #include "hiopTimer.hpp"
 
+#include <future>
+#include <vector>
+
 namespace hiop
 {
 
@@ -93,6 +97,13 @@ protected:
 	       hiopMatrix& Hess_L);
   bool evalNlp_funcOnly(hiopIterate& iter, 
 			double& f, hiopVector& c_, hiopVector& d_);
+  /* Evaluates the functions at the line-search trial iterate 'it_trial', which corresponds to the 
+   * primal step length '_alpha_primal'. When option 'linesearch_batch' is larger than 1 and the 
+   * user's evaluations are thread-safe, the functions at the subsequent backtracking step lengths 
+   * (alpha/2, alpha/4, ...) are evaluated concurrently and cached for the next trials. The cache
+   * should be invalidated (ls_batch_num_=0) before each line search.
+   */
+  bool evalNlp_funcOnly_trial(double& f, hiopVector& c_, hiopVector& d_);
   bool evalNlp_derivOnly(hiopIterate& iter, 
 			 hiopVector& gradf_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d,
 			 hiopMatrix& Hess_L);
@@ -109,6 +120,15 @@ protected:
    * is called with 'new_x' set to false.
    */
   bool evalNlp_HessOnly(hiopIterate& iter, hiopMatrix& Hess_L);
+
+  /* Evaluates the gradient and the Jacobians and launches the evaluation of the Hessian as an
+   * asynchronous task, which is returned in 'hess_eval'. 'Hess_L' and the duals of 'iter' should
+   * not be accessed until 'hess_eval' is waited upon. Errors in the Hessian evaluation are 
+   * reported by the value of 'hess_eval' (the task does not log).
+   */
+  bool evalNlp_derivOnly_asyncHess(hiopIterate& iter, 
+				   hiopVector& gradf_,  hiopMatrix& Jac_c,  hiopMatrix& Jac_d,
+				   hiopMatrix& Hess_L, std::future<bool>& hess_eval);
   
   /** Internal helper for NLP error/residuals computation.
    * TODO: add support for the 'true' infeasibility measure and propagate this downstream in
@@ -133,12 +153,16 @@ protected:
   //returns whether the algorithm should stop and set an appropriate solve status
   bool checkTermination(const double& _err_nlp, const int& iter_num, hiopSolveStatus& status);
   void displayTerminationMsg();
+  //returns false, after logging the memory report, if the limit of option 'mem_limit' was exceeded
+  bool checkMemoryLimit();
 
   void resetSolverStatus();
   virtual void reInitializeNlpObjects();
   virtual void reloadOptions();
 private:
   void destructorPart();
+  void lsBatchAlloc();
+  void lsBatchFree();
 protected:
   hiopNlpFormulation* nlp;
   hiopFilter filter;
@@ -169,6 +193,8 @@ protected:
    */
   double _f_nlp, _f_log, _f_nlp_trial, _f_log_trial;
   hiopVector *_c,*_d, *_c_trial, *_d_trial;
+  //storage of the pairs (_c,_d) and (_c_trial,_d_trial), see hiopNlpFormulation::alloc_cons_body_vecs
+  hiopVector *_cons_buf, *_cons_buf_trial;
   hiopVector* _grad_f, *_grad_f_trial; //gradient of the log-barrier objective function
   hiopMatrix* _Jac_c, *_Jac_c_trial; //Jacobian of c(x), the equality part
   hiopMatrix* _Jac_d, *_Jac_d_trial; //Jacobian of d(x), the inequality part
@@ -212,6 +238,30 @@ protected:
 
   /* Flag for timing and timing breakdown report for the KKT solve */
   bool perf_report_kkt_;
+
+  /* Flag for evaluating the Hessian asynchronously (see option 'hess_eval_async') */
+  bool hess_eval_async_;
+
+  /* Option 'linsol_mode', read in the optimization loop */
+  hiopOptions::Handle<std::string> linsol_mode_;
+
+  /* Concurrent evaluation of line-search trial points (see option 'linesearch_batch') */
+  int ls_batch_size_;                      //number of trial points evaluated concurrently
+  int ls_batch_num_;                       //number of cached evaluations for the current line search
+  std::vector<double> ls_batch_alpha_;     //step lengths of the cached evaluations
+  std::vector<double> ls_batch_f_;
+  std::vector<hiopVector*> ls_batch_x_, ls_batch_c_, ls_batch_d_;
+  std::vector<double*> ls_batch_cons_;     //buffers for one-call constraints evaluations
+  //true when the last evaluation of the user's functions was the sequential one of the trial point;
+  //otherwise (cached or concurrent evaluations) the derivatives are evaluated with new_x=true
+  bool trial_evaluated_last_;
+
+  /* Per-iteration records (see option 'trace_iter') */
+  hiopIterTrace trace_;
+
+  /* Arena of the storage of the solver's linear algebra objects (see option 'mem_pool'); NULL 
+   * when the storage comes from the heap */
+  hiopMemoryPool* mem_pool_;
 };
 
 class hiopAlgFilterIPMQuasiNewton : public hiopAlgFilterIPMBase
@@ -79,6 +79,24 @@ hiopDualsLsqUpdate::hiopDualsLsqUpdate(hiopNlpFormulation* nlp)
 #endif
   //user options
   recalc_lsq_duals_tol = 1e-6;
+
+  std::string lsq_solve = nlpd->options->GetString("duals_lsq_solve");
+  lsq_solve_type_ = lsq_solve=="reuse_fact" ? 1 : (lsq_solve=="cg" ? 2 : 0);
+  M_is_factorized_ = false;
+  //PCG with a stale factorization should converge in a handful of iterations; otherwise the
+  //Jacobian changed significantly and it is cheaper to refactorize
+  cg_max_iter_ = lsq_solve_type_==1 ? 10 : 100;
+  cg_tol_ = 1e-10;
+
+  _cg_x = _cg_r = _cg_z = _cg_p = _cg_Mp = _vec_me = NULL;
+  if(lsq_solve_type_!=0) {
+    _cg_x  = rhs->alloc_clone();
+    _cg_r  = rhs->alloc_clone();
+    _cg_z  = rhs->alloc_clone();
+    _cg_p  = rhs->alloc_clone();
+    _cg_Mp = rhs->alloc_clone();
+    _vec_me= nlpd->alloc_dual_eq_vec();
+  }
 };
 
 hiopDualsLsqUpdate::~hiopDualsLsqUpdate()
@@ -93,6 +111,12 @@ hiopDualsLsqUpdate::~hiopDualsLsqUpdate()
   delete rhsd;
   delete _vec_n;
   delete _vec_mi;
+  delete _cg_x;
+  delete _cg_r;
+  delete _cg_z;
+  delete _cg_p;
+  delete _cg_Mp;
+  delete _vec_me;
 #ifdef HIOP_DEEPCHECKS
   delete M_copy;
   delete rhs_copy;
@@ -150,6 +174,12 @@ go(const hiopIterate& iter,  hiopIterate& iter_plus,
  * 
  * The matrix of the above system is stored in the member variable M of this class and the
  *  right-hand side in 'rhs'
+ *
+ * Depending on option 'duals_lsq_solve', the system is solved by forming and factorizing M at 
+ * each update or by matrix-free (P)CG, which only needs products with J_c, J_d, and their 
+ * transposes. In the latter case the preconditioner is the Cholesky factorization of M from a 
+ * previous update (when available) and M is reformed and refactorized only when (P)CG does not
+ * converge in a few iterations.
  */
 bool hiopDualsLsqUpdate::
 LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c, const hiopMatrix& jac_d)
@@ -157,30 +187,8 @@ LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c,
   hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
   assert(nlpd!=NULL);
 
-  //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
-  //! streamline the communication (use _mxm as a global buffer for the MPI_Allreduce)
-  jac_c.timesMatTrans(0.0, *_mexme, 1.0, jac_c);
-  jac_c.timesMatTrans(0.0, *_mexmi, 1.0, jac_d);
-  jac_d.timesMatTrans(0.0, *_mixmi, 1.0, jac_d);
-  _mixmi->addDiagonal(1.0);
-
-  M->copyBlockFromMatrix(0,0,*_mexme);
-  M->copyBlockFromMatrix(0, nlpd->m_eq(), *_mexmi);
-  M->copyBlockFromMatrix(nlpd->m_eq(),nlpd->m_eq(), *_mixmi);
-
-#ifdef HIOP_DEEPCHECKS
-  M_copy->copyFrom(*M);
-  jac_d.timesMatTrans(0.0, *_mixme, 1.0, jac_c);
-  M_copy->copyBlockFromMatrix(nlpd->m_eq(), 0, *_mixme);
-  M_copy->assertSymmetry(1e-12);
-#endif
-
-  //bailout in case there is an error in the Cholesky factorization
-  int info;
-  if((info=this->factorizeMat(*M))) {
-    nlpd->log->printf(hovError, "dual lsq update: error %d in the Cholesky factorization.\n", info);
-    return false;
-  }
+  nlpd->runStats.tmMultUpdate.start();
+  nlpd->runStats.nDualsLsq++;
 
   // compute rhs=[rhsc,rhsd]. 
   // [ rhsc ] = - [ J_c   0 ] [ vecx ] 
@@ -203,41 +211,191 @@ LSQUpdate(hiopIterate& iter, const hiopVector& grad_f, const hiopMatrix& jac_c,
   rhs->copyFromStarting(nlpd->m_eq(), *rhsd);
 
   //nlpd->log->write("rhs", *rhs, hovSummary);
+
+  bool direct_solve = lsq_solve_type_==0 || (lsq_solve_type_==1 && !M_is_factorized_);
+  if(!direct_solve) {
+    //warm start from the current duals
+    _cg_x->copyFromStarting(0, *iter.get_yc());
+    _cg_x->copyFromStarting(nlpd->m_eq(), *iter.get_yd());
+
+    int num_iter = solveWithPCG(jac_c, jac_d, lsq_solve_type_==1, *rhs, *_cg_x);
+    if(num_iter>=0) {
+      nlpd->log->printf(hovScalars, "dual lsq update: %s converged in %d iterations\n", 
+			lsq_solve_type_==1 ? "PCG" : "CG", num_iter);
+      rhs->copyFrom(*_cg_x);
+    } else {
+      nlpd->log->printf(hovScalars, "dual lsq update: %s did not converge in %d iterations; will "
+			"factorize\n", lsq_solve_type_==1 ? "PCG" : "CG", cg_max_iter_);
+      direct_solve = true;
+    }
+  }
+
+  if(direct_solve) {
+    //bailout in case there is an error in the Cholesky factorization
+    if(!assembleAndFactorize(jac_c, jac_d)) {
+      nlpd->runStats.tmMultUpdate.stop();
+      return false;
+    }
+
 #ifdef HIOP_DEEPCHECKS
-  rhs_copy->copyFrom(*rhs);
+    rhs_copy->copyFrom(*rhs);
 #endif
 
-  //solve for this rhs
-  if((info=this->solveWithFactors(*M, *rhs))) {
-    nlpd->log->printf(hovError, "dual lsq update: error %d in the solution process.\n", info);
-    return false;
+    //solve for this rhs
+    int info;
+    if((info=this->solveWithFactors(*M, *rhs))) {
+      nlpd->log->printf(hovError, "dual lsq update: error %d in the solution process.\n", info);
+      nlpd->runStats.tmMultUpdate.stop();
+      return false;
+    }
+
+#ifdef HIOP_DEEPCHECKS
+    double nrmrhs = rhs_copy->twonorm();
+    M_copy->timesVec(-1.0,  *rhs_copy, 1.0, *rhs);
+    double nrmres = rhs_copy->twonorm() / (1+nrmrhs);
+    if(nrmres>1e-4) {
+      nlpd->log->printf(hovError,
+			"hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high: %g\n", nrmres);
+      assert(false && "hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high");
+      nlpd->runStats.tmMultUpdate.stop();
+      return false;
+    } else {
+      if(nrmres>1e-6)
+	nlpd->log->printf(hovWarning,
+			  "hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high: %g\n", nrmres);
+    }
+#endif
   }
 
   //update yc and yd in iter_plus
   rhs->copyToStarting(0, *iter.get_yc());
   rhs->copyToStarting(nlpd->m_eq(), *iter.get_yd());
 
-#ifdef HIOP_DEEPCHECKS
-  double nrmrhs = rhs_copy->twonorm();
-  M_copy->timesVec(-1.0,  *rhs_copy, 1.0, *rhs);
-  double nrmres = rhs_copy->twonorm() / (1+nrmrhs);
-  if(nrmres>1e-4) {
-    nlpd->log->printf(hovError,
-		      "hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high: %g\n", nrmres);
-    assert(false && "hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high");
-    return false;
-  } else {
-    if(nrmres>1e-6)
-      nlpd->log->printf(hovWarning,
-			"hiopDualsLsqUpdate::LSQUpdate linear system residual is dangerously high: %g\n", nrmres);
-  }
-#endif
-
   //nlpd->log->write("yc ini", *iter.get_yc(), hovSummary);
   //nlpd->log->write("yd ini", *iter.get_yd(), hovSummary);
+  nlpd->runStats.tmMultUpdate.stop();
   return true;
 };
 
+bool hiopDualsLsqUpdate::assembleAndFactorize(const hiopMatrix& jac_c, const hiopMatrix& jac_d)
+{
+  hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
+  assert(nlpd!=NULL);
+
+  //compute terms in M: Jc * Jc^T, J_c * J_d^T, and J_d * J_d^T
+  //! streamline the communication (use _mxm as a global buffer for the MPI_Allreduce)
+  jac_c.timesMatTrans(0.0, *_mexme, 1.0, jac_c);
+  jac_c.timesMatTrans(0.0, *_mexmi, 1.0, jac_d);
+  jac_d.timesMatTrans(0.0, *_mixmi, 1.0, jac_d);
+  _mixmi->addDiagonal(1.0);
+
+  M->copyBlockFromMatrix(0,0,*_mexme);
+  M->copyBlockFromMatrix(0, nlpd->m_eq(), *_mexmi);
+  M->copyBlockFromMatrix(nlpd->m_eq(),nlpd->m_eq(), *_mixmi);
+
+#ifdef HIOP_DEEPCHECKS
+  M_copy->copyFrom(*M);
+  jac_d.timesMatTrans(0.0, *_mixme, 1.0, jac_c);
+  M_copy->copyBlockFromMatrix(nlpd->m_eq(), 0, *_mixme);
+  M_copy->assertSymmetry(1e-12);
+#endif
+
+  nlpd->runStats.nDualsLsqFact++;
+  int info;
+  if((info=this->factorizeMat(*M))) {
+    nlpd->log->printf(hovError, "dual lsq update: error %d in the Cholesky factorization.\n", info);
+    M_is_factorized_ = false;
+    return false;
+  }
+  M_is_factorized_ = true;
+  return true;
+}
+
+void hiopDualsLsqUpdate::timesMatFree(const hiopMatrix& jac_c, const hiopMatrix& jac_d, 
+				      const hiopVector& v, hiopVector& Mv)
+{
+  hiopNlpDenseConstraints* nlpd = dynamic_cast<hiopNlpDenseConstraints*>(_nlp);
+  assert(nlpd!=NULL);
+
+  //[vc,vd] = v
+  rhsc->copyFrom(v.local_data_const());
+  rhsd->copyFrom(v.local_data_const()+nlpd->m_eq());
+
+  // w = J_c^T vc + J_d^T vd
+  hiopVector& w = *_vec_n;
+  jac_c.transTimesVec(0.0, w, 1.0, *rhsc);
+  jac_d.transTimesVec(1.0, w, 1.0, *rhsd);
+
+  // Mv = [ J_c w ; J_d w + vd ]
+  jac_c.timesVec(0.0, *_vec_me, 1.0, w);
+  jac_d.timesVec(0.0, *_vec_mi, 1.0, w);
+  _vec_mi->axpy(1.0, *rhsd);
+
+  Mv.copyFromStarting(0, *_vec_me);
+  Mv.copyFromStarting(nlpd->m_eq(), *_vec_mi);
+}
+
+int hiopDualsLsqUpdate::solveWithPCG(const hiopMatrix& jac_c, const hiopMatrix& jac_d, bool use_prec,
+				     const hiopVector& b, hiopVector& x)
+{
+  assert(!use_prec || M_is_factorized_);
+  hiopVector& r = *_cg_r;
+  hiopVector& z = *_cg_z;
+  hiopVector& p = *_cg_p;
+  hiopVector& Mp = *_cg_Mp;
+
+  const double nrmb = b.twonorm();
+  if(0.==nrmb) {
+    x.setToZero();
+    return 0;
+  }
+  const double tol = cg_tol_*nrmb;
+
+  // r = b - M x
+  timesMatFree(jac_c, jac_d, x, r);
+  r.scale(-1.0);
+  r.axpy(1.0, b);
+
+  z.copyFrom(r);
+  if(use_prec) {
+    solveWithFactors(*M, z);
+  }
+  p.copyFrom(z);
+  double rz = r.dotProductWith(z);
+
+  int k=0;
+  for(; k<cg_max_iter_; ++k) {
+    if(r.twonorm() <= tol) {
+      break;
+    }
+    timesMatFree(jac_c, jac_d, p, Mp);
+    const double pMp = p.dotProductWith(Mp);
+    if(pMp<=0.) {
+      //M is positive definite; this can occur only because of round-off
+      k = cg_max_iter_;
+      break;
+    }
+    const double alpha = rz/pMp;
+    x.axpy(alpha, p);
+    r.axpy(-alpha, Mp);
+
+    z.copyFrom(r);
+    if(use_prec) {
+      solveWithFactors(*M, z);
+    }
+    const double rz_new = r.dotProductWith(z);
+    p.scale(rz_new/rz);
+    p.axpy(1.0, z);
+    rz = rz_new;
+  }
+  _nlp->runStats.nDualsLsqCGIter += k;
+
+  if(r.twonorm() > tol) {
+    return -1;
+  }
+  return k;
+}
+
 int hiopDualsLsqUpdate::factorizeMat(hiopMatrixDense& M)
 {
 #ifdef HIOP_DEEPCHECKS
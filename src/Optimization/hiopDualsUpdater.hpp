@@ -122,6 +122,16 @@ private: //common code
 			 const hiopVector& grad_f,
 			 const hiopMatrix& jac_c,
 			 const hiopMatrix& jac_d);
+  /* forms M = [J_c; J_d] [J_c; J_d]^T + [0 0; 0 I] and factorizes it in place */
+  bool assembleAndFactorize(const hiopMatrix& jac_c, const hiopMatrix& jac_d);
+  /* matrix-free product Mv = M*v (without forming M) */
+  void timesMatFree(const hiopMatrix& jac_c, const hiopMatrix& jac_d, const hiopVector& v, hiopVector& Mv);
+  /* (P)CG for M*x = b, with 'x' containing the initial guess on entry; uses the (possibly stale)
+   * Cholesky factors in M as preconditioner when 'use_prec' is true. Returns the number of 
+   * iterations or -1 if the relative residual is not below cg_tol_ in cg_max_iter_ iterations.
+   */
+  int solveWithPCG(const hiopMatrix& jac_c, const hiopMatrix& jac_d, bool use_prec, 
+		   const hiopVector& b, hiopVector& x);
 private:
   hiopMatrixDense *_mexme, *_mexmi, *_mixmi, *_mxm;
   hiopMatrixDense *M;
@@ -129,6 +139,10 @@ private:
   hiopVector *rhs, *rhsc, *rhsd;
   hiopVector *_vec_n, *_vec_mi;
 
+  //buffers for the matrix-free (P)CG solves; allocated only when option 'duals_lsq_solve' is
+  //not 'fact'
+  hiopVector *_cg_x, *_cg_r, *_cg_z, *_cg_p, *_cg_Mp, *_vec_me;
+
 #ifdef HIOP_DEEPCHECKS
   hiopMatrixDense* M_copy;
   hiopVector *rhs_copy;
@@ -141,6 +155,16 @@ private:
    * is less than this tolerance; default 1e-6
    */
   double recalc_lsq_duals_tol;  
+
+  /** Solution of the linear system of the LSQ update: 0 factorization at each update (default),
+   * 1 PCG preconditioned by the last factorization, 2 unpreconditioned CG (option 'duals_lsq_solve')
+   */
+  int lsq_solve_type_;
+  /** whether M holds the Cholesky factors of a previous update (used by lsq_solve_type_=1) */
+  bool M_is_factorized_;
+  /** max iterations and relative tolerance for the (P)CG solves */
+  int cg_max_iter_;
+  double cg_tol_;
                                 
   //helpers
   int factorizeMat(hiopMatrixDense& M);
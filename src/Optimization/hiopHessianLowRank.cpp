@@ -72,12 +72,17 @@ using namespace std;
 #define SIGMA_STRATEGY4 4
 #define SIGMA_CONSTANT  5
 
+//length of the chunks (of the local part of n) processed by the one-sweep kernels; chunks of 
+//the rows of S and Y and of the diagonals are reused from cache within a chunk
+#define LOWRANK_CHUNK_LEN 256
+
 namespace hiop
 {
 
 hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_mem_len)
-  : l_max(max_mem_len), l_curr(-1), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
+  : l_max(max_mem_len), l_curr(-1), l_head_(0), sigma(1.), sigma0(1.), nlp(nlp_), matrixChanged(false)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   DhInv = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
   St = nlp->alloc_multivector_primal(0,l_max);
   Yt = St->alloc_clone(); //faster than nlp->alloc_multivector_primal(...);
@@ -90,22 +95,21 @@ hiopHessianLowRank::hiopHessianLowRank(hiopNlpDenseConstraints* nlp_, int max_me
   _it_prev=NULL; _grad_f_prev=NULL; _Jac_c_prev=NULL; _Jac_d_prev=NULL;
 
   //internal buffers for memory pool (none of them should be in n)
+  _buff1_lxlx3 = new double[3*l_max*l_max]; //also holds the output of productsSY_local
 #ifdef HIOP_USE_MPI
   _buff_kxk    = new double[nlp->m() * nlp->m()];
   _buff_2lxk   = new double[nlp->m() * 2*l_max];
-  _buff1_lxlx3 = new double[3*l_max*l_max];
   _buff2_lxlx3 = new double[3*l_max*l_max];
 #else
    //not needed in non-MPI mode
   _buff_kxk  = NULL;
   _buff_2lxk = NULL;
-  _buff1_lxlx3 = _buff2_lxlx3 = NULL;
+  _buff2_lxlx3 = NULL;
 #endif
 
   //auxiliary objects/buffers
-  _S1=_Y1=NULL;
-  _lxl_mat1=_kxl_mat1=_kx2l_mat1=NULL;
-  _l_vec1 = _l_vec2 = _2l_vec1 = NULL;
+  _lxl_mat1=_kx2l_mat1=_kx2l_mat2=NULL;
+  _l_vec1 = _2l_vec1 = NULL;
   _n_vec1 = DhInv->alloc_clone();
   _n_vec2 = DhInv->alloc_clone();
 
@@ -170,14 +174,11 @@ hiopHessianLowRank::~hiopHessianLowRank()
   if(_buff1_lxlx3) delete[] _buff1_lxlx3;
   if(_buff2_lxlx3) delete[] _buff2_lxlx3;
 
-  if(_S1) delete _S1;
-  if(_Y1) delete _Y1;
   if(_lxl_mat1)    delete _lxl_mat1;
-  if(_kxl_mat1)    delete _kxl_mat1; 
   if(_kx2l_mat1)   delete _kx2l_mat1;
+  if(_kx2l_mat2)   delete _kx2l_mat2;
 
   if(_l_vec1) delete _l_vec1;
-  if(_l_vec2) delete _l_vec2;
   if(_n_vec1) delete _n_vec1;
   if(_n_vec2) delete _n_vec2;
   if(_2l_vec1) delete _2l_vec1;
@@ -232,9 +233,9 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 {
   nlp->runStats.tmSolverInternal.start();
 
-  const hiopVectorPar&   grad_f_curr= dynamic_cast<const hiopVectorPar&>(grad_f_curr_);
-  const hiopMatrixDense& Jac_c_curr = dynamic_cast<const hiopMatrixDense&>(Jac_c_curr_);
-  const hiopMatrixDense& Jac_d_curr = dynamic_cast<const hiopMatrixDense&>(Jac_d_curr_);
+  const hiopVectorPar&   grad_f_curr= known_cast<const hiopVectorPar&>(grad_f_curr_);
+  const hiopMatrixDense& Jac_c_curr = known_cast<const hiopMatrixDense&>(Jac_c_curr_);
+  const hiopMatrixDense& Jac_d_curr = known_cast<const hiopMatrixDense&>(Jac_d_curr_);
 
 #ifdef HIOP_DEEPCHECKS
   assert(it_curr.zl->matchesPattern(nlp->get_ixl()));
@@ -270,7 +271,7 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
       if(sTy>s_nrm2*y_nrm2*std::numeric_limits<double>::epsilon()) { //sTy far away from zero
 
 	if(l_max>0) {
-	  //compute the new row in L, update S and Y (either augment them or shift cols and add s_new and y_new)
+	  //compute the new row in L, update S and Y (either augment them or overwrite the oldest pair)
 	  hiopVector& YTs = new_l_vec1(l_curr);
 	  Yt->timesVec(0.0, YTs, 1.0, s_new);
 	  //update representation
@@ -282,13 +283,12 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
 	    growD(l_curr, l_max, sTy);
 	    l_curr++;
 	  } else {
-	    //shift
-	    St->shiftRows(-1);
-	    Yt->shiftRows(-1);
-	    St->replaceRow(l_max-1, s_new);
-	    Yt->replaceRow(l_max-1, y_new);
-	    updateL(YTs,sTy);
-	    updateD(sTy);
+	    //S and Y are circular buffers: the new pair takes the slot of the oldest pair
+	    St->replaceRow(l_head_, s_new);
+	    Yt->replaceRow(l_head_, y_new);
+	    updateL(l_head_, YTs);
+	    updateD(l_head_, sTy);
+	    l_head_ = (l_head_+1) % l_max;
 	    l_curr=l_max;
 	  }
 	} //end of l_max>0
@@ -362,69 +362,41 @@ bool hiopHessianLowRank::update(const hiopIterate& it_curr, const hiopVector& gr
  */
 void hiopHessianLowRank::updateInternalBFGSRepresentation()
 {
-  long long n=St->n(), l=St->m();
+  hiopMemScope mem_scope(hiopMemLowRank);
+  long long l=St->m();
 
   //grow L,D, andV if needed
   if(L->m()!=l) { delete L; L=LinearAlgebraFactory::createMatrixDense(l,l);}
   if(D->get_size()!=l) { delete D; D=LinearAlgebraFactory::createVector(l); }
   if(V->m()!=2*l) {delete V; V=LinearAlgebraFactory::createMatrixDense(2*l,2*l); }
 
-  //-- block (2,2)
-  hiopMatrixDense& DpYtDhInvY = new_lxl_mat1(l);
-  symmMatTimesDiagTimesMatTrans_local(0.0, DpYtDhInvY, 1.0,*Yt,*DhInv);
-#ifdef HIOP_USE_MPI
-  const size_t buffsize=l*l*sizeof(double);
-  memcpy(_buff1_lxlx3, DpYtDhInvY.local_buffer(), buffsize);
-#else
-  DpYtDhInvY.addDiagonal(1., *D);
-  V->copyBlockFromMatrix(l,l,DpYtDhInvY);
-#endif
-
-  //-- block (1,2)
-  hiopMatrixDense& StB0DhInvYmL = DpYtDhInvY; //just a rename
-  hiopVector& B0DhInv = new_n_vec1(n);
-  B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
-  matTimesDiagTimesMatTrans_local(StB0DhInvYmL, *St, B0DhInv, *Yt);
-#ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+l*l, StB0DhInvYmL.local_buffer(), buffsize);
-#else
-  //substract L
-  StB0DhInvYmL.addMatrix(-1.0, *L);
-  // (1,2) block in V
-  V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
-#endif
-
-  //-- block (2,2)
-  hiopVector& theDiag = B0DhInv; //just a rename, also reuses values
-  theDiag.addConstant(-1.0); //at this point theDiag=DhInv*B0-I
-  theDiag.scale(sigma);
-  hiopMatrixDense& StDS = DpYtDhInvY; //a rename
-  symmMatTimesDiagTimesMatTrans_local(0.0, StDS, 1.0, *St, theDiag);
+  //Y'*DhInv*Y, S'*B0*DhInv*Y, and S'*B0*(DhInv*B0-I)*S in one sweep over S and Y
+  productsSY_local(_buff1_lxlx3);
 #ifdef HIOP_USE_MPI
-  memcpy(_buff1_lxlx3+2*l*l, DpYtDhInvY.local_buffer(), buffsize);
+  int ierr;
+  ierr = hiopAllreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "hess_lowrank_update"); assert(ierr==MPI_SUCCESS);
+  const double* blocks = _buff2_lxlx3;
 #else
-  V->copyBlockFromMatrix(0,0,StDS);
+  const double* blocks = _buff1_lxlx3;
 #endif
 
-
-#ifdef HIOP_USE_MPI
-  int ierr;
-  ierr = MPI_Allreduce(_buff1_lxlx3, _buff2_lxlx3, 3*l*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-
   // - block (2,2)
-  DpYtDhInvY.copyFrom(_buff2_lxlx3);
+  hiopMatrixDense& DpYtDhInvY = new_lxl_mat1(l);
+  DpYtDhInvY.copyFrom(blocks);
   DpYtDhInvY.addDiagonal(1., *D);
   V->copyBlockFromMatrix(l,l,DpYtDhInvY);
 
   // - block (1,2)
-  StB0DhInvYmL.copyFrom(_buff2_lxlx3+l*l);
+  hiopMatrixDense& StB0DhInvYmL = DpYtDhInvY; //just a rename
+  StB0DhInvYmL.copyFrom(blocks+l*l);
   StB0DhInvYmL.addMatrix(-1.0, *L);
   V->copyBlockFromMatrix(0,l,StB0DhInvYmL);
 
   // - block (1,1)
-  StDS.copyFrom(_buff2_lxlx3+2*l*l);
+  hiopMatrixDense& StDS = DpYtDhInvY; //a rename
+  StDS.copyFrom(blocks+2*l*l);
   V->copyBlockFromMatrix(0,0,StDS);
-#endif
+
 #ifdef HIOP_DEEPCHECKS
   delete _Vmat;
   _Vmat = V->new_copy();
@@ -449,45 +421,78 @@ void hiopHessianLowRank::solve(const hiopVector& rhs_, hiopVector& x_)
 {
   if(matrixChanged) updateInternalBFGSRepresentation();
 
-  hiopVectorPar& x = dynamic_cast<hiopVectorPar&>(x_);
-  const hiopVectorPar& rhsx = dynamic_cast<const hiopVectorPar&>(rhs_);
-  long long n=St->n(), l=St->m();
+  hiopVectorPar& x = known_cast<hiopVectorPar&>(x_);
+  const hiopVectorPar& rhsx = known_cast<const hiopVectorPar&>(rhs_);
+  long long l=St->m();
 #ifdef HIOP_DEEPCHECKS
+  long long n=St->n();
   assert(rhsx.get_size()==n);
   assert(x.get_size()==n);
   assert(DhInv->get_size()==n);
   assert(DhInv->isfinite_local() && "inf or nan entry detected");
   assert(rhsx.isfinite_local() && "inf or nan entry detected in rhs");
 #endif
-
-  //1. x = DhInv*res
-  x.copyFrom(rhsx);
-  x.componentMult(*DhInv);
-
-  //2. stx= S^T*B0*DhInv*res and ytx=Y^T*DhInv*res
-  hiopVector&stx=new_l_vec1(l), &ytx=new_l_vec2(l);
-  stx.setToZero(); ytx.setToZero();
-  Yt->timesVec(0.0,ytx,1.0,x);
-
-  hiopVector& B0DhInvx = new_n_vec1(n);
-  B0DhInvx.copyFrom(x); //it contains DhInv*res
-  B0DhInvx.scale(sigma); //B0*(DhInv*res) 
-  St->timesVec(0.0,stx,1.0,B0DhInvx);
+  const size_t n_local=x.get_local_size();
+  double* xd=x.local_data();
+  const double* rhsd=rhsx.local_data_const();
+  const double* dh=DhInv->local_data_const();
+  double **Sd=St->local_data(), **Yd=Yt->local_data();
+
+  //1. x = DhInv*res and
+  //2. stx= S^T*B0*DhInv*res and ytx=Y^T*DhInv*res, all in one sweep over S and Y
+  hiopVector& sty = new_2l_vec1(l);
+  double* stx=sty.local_data(); double* ytx=stx+l;
+  sty.setToZero();
+  for(size_t p0=0; p0<n_local; p0+=LOWRANK_CHUNK_LEN) {
+    const size_t len = min((size_t)LOWRANK_CHUNK_LEN, n_local-p0);
+    double* xc=xd+p0;
+    for(size_t p=0; p<len; p++) 
+      xc[p] = rhsd[p0+p]*dh[p0+p];
+
+    for(int i=0; i<l; i++) {
+      const double *Si=Sd[i]+p0, *Yi=Yd[i]+p0;
+      double acc_s=0., acc_y=0.;
+      for(size_t p=0; p<len; p++) {
+	acc_s += Si[p]*xc[p];
+	acc_y += Yi[p]*xc[p];
+      }
+      stx[i] += acc_s;
+      ytx[i] += acc_y;
+    }
+  }
+  for(int i=0; i<l; i++) stx[i] *= sigma; //B0*(DhInv*res)
+#ifdef HIOP_USE_MPI
+  if(l>0) {
+    int ierr = hiopAllreduce(stx, _buff2_lxlx3, 2*l, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "hess_lowrank_solve"); 
+    assert(ierr==MPI_SUCCESS); (void)ierr;
+    memcpy(stx, _buff2_lxlx3, 2*l*sizeof(double));
+  }
+#endif
 
   //3. solve with V
-  hiopVector& spart=stx; hiopVector& ypart=ytx;
-  solveWithV(spart,ypart);
+  solveWithV(sty);
+  double* spart=stx; double* ypart=ytx;
 
   //4. multiply with  DhInv*[B0*S Y], namely
   // result = DhInv*(B0*S*spart + Y*ypart)
-  hiopVector&  result = new_n_vec1(n);
-  St->transTimesVec(0.0, result, 1.0, spart);
-  result.scale(sigma);
-  Yt->transTimesVec(1.0, result, 1.0, ypart);
-  result.componentMult(*DhInv);
-
   //5. x = first term - second term = x_computed_in_1 - result 
-  x.axpy(-1.0,result);
+  //both done in one sweep over S and Y
+  for(int i=0; i<l; i++) spart[i] *= sigma;
+  double result[LOWRANK_CHUNK_LEN];
+  for(size_t p0=0; p0<n_local; p0+=LOWRANK_CHUNK_LEN) {
+    const size_t len = min((size_t)LOWRANK_CHUNK_LEN, n_local-p0);
+    for(size_t p=0; p<len; p++) result[p]=0.;
+
+    for(int i=0; i<l; i++) {
+      const double *Si=Sd[i]+p0, *Yi=Yd[i]+p0;
+      const double si=spart[i], yi=ypart[i];
+      for(size_t p=0; p<len; p++)
+	result[p] += Si[p]*si + Yi[p]*yi;
+    }
+    double* xc=xd+p0;
+    for(size_t p=0; p<len; p++)
+      xc[p] -= dh[p0+p]*result[p];
+  }
 #ifdef HIOP_DEEPCHECKS
   assert(x.isfinite_local() && "inf or nan entry detected in computed solution");
 #endif
@@ -526,26 +531,17 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 #else
   symmMatTimesDiagTimesMatTrans_local(beta,W,alpha,X,*DhInv);
 #endif
-  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y
-  hiopMatrixDense &S1=new_S1(X,*St), &Y1=new_Y1(X,*Yt); //both are kxl
-  hiopVector& B0DhInv = new_n_vec1(n);
-  B0DhInv.copyFrom(*DhInv); B0DhInv.scale(sigma);
-  matTimesDiagTimesMatTrans_local(S1, X, B0DhInv, *St);
-  matTimesDiagTimesMatTrans_local(Y1, X, *DhInv,  *Yt);
+  //2. compute S1=X*DhInv*B0*S and Y1=X*DhInv*Y in one sweep, as S1Y1=[S1 Y1] (kx2l)
+  hiopMatrixDense& S1Y1 = new_kx2l_mat1(k,l);
+  matTimesDhInvTimesSY_local(S1Y1, X);
 
   //3. reduce W, S1, and Y1 (dimensions: kxk, kxl, kxl)
-  hiopMatrixDense& S2Y2 = new_kx2l_mat1(k,l);  //Initialy S2Y2 = [Y1 S1]
-  S2Y2.copyBlockFromMatrix(0,0,S1);
-  S2Y2.copyBlockFromMatrix(0,l,Y1);
 #ifdef HIOP_USE_MPI
   int ierr;
-  ierr = MPI_Allreduce(S2Y2.local_buffer(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  ierr = MPI_Allreduce(W.local_buffer(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
-  S2Y2.copyFrom(_buff_2lxk);
+  ierr = hiopAllreduce(S1Y1.local_buffer(), _buff_2lxk, 2*l*k, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "hess_lowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
+  ierr = hiopAllreduce(W.local_buffer(),    _buff_kxk,  k*k,   MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "hess_lowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
+  S1Y1.copyFrom(_buff_2lxk);
   W.copyFrom(_buff_kxk);
-  //also copy S1 and Y1
-  S1.copyFromMatrixBlock(S2Y2, 0,0);
-  Y1.copyFromMatrixBlock(S2Y2, 0,l);
 #endif
 #ifdef HIOP_DEEPCHECKS
   nlp->log->write("symMatTimesInverseTimesMatTrans: W first term is: ", W, hovMatrices);
@@ -554,24 +550,13 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
   //   [Y2]       [Y1^T]
   //S2Y2 is exactly [S1^T] when Fortran Lapack looks at it
   //                [Y1^T]
-  hiopMatrixDense& RHS_fortran = S2Y2; 
-  solveWithV(RHS_fortran);
+  hiopMatrixDense& S2Y2 = new_kx2l_mat2(k,l);
+  S2Y2.copyFrom(S1Y1);
+  solveWithV(S2Y2);
 
   //5. W = W-alpha*[S1 Y1]*[S2^T] 
   //                       [Y2^T]
-  S2Y2 = RHS_fortran;
-  alpha = 0-alpha;
-  hiopMatrixDense& S2=new_kxl_mat1(k,l);
-  S2.copyFromMatrixBlock(S2Y2, 0, 0);
-  S1.timesMatTrans_local(1.0, W, alpha, S2);
-
-  hiopMatrixDense& Y2=S2;
-  Y2.copyFromMatrixBlock(S2Y2, 0, l);
-  Y1.timesMatTrans_local(1.0, W, alpha, Y2);
-
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: Y1 is : ", Y1, hovMatrices);
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: Y2 is : ", Y2, hovMatrices);
-  //nlp->log->write("symMatTimesInverseTimesMatTrans: W is : ", W, hovMatrices);
+  S1Y1.timesMatTrans_local(1.0, W, -alpha, S2Y2);
 
   //we're done here
 
@@ -584,6 +569,7 @@ symMatTimesInverseTimesMatTrans(double beta, hiopMatrixDense& W,
 
 void hiopHessianLowRank::factorizeV()
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   int N=V->n(), lda=N, info;
   if(N==0) return;
 
@@ -620,42 +606,27 @@ void hiopHessianLowRank::factorizeV()
 
 }
 
-void hiopHessianLowRank::solveWithV(hiopVector& rhs_s, hiopVector& rhs_y)
+void hiopHessianLowRank::solveWithV(hiopVector& rhs)
 {
   int N=V->n();
   if(N==0) return;
 
-  int l=rhs_s.get_size();
-
 #ifdef HIOP_DEEPCHECKS
-  nlp->log->write("hiopHessianLowRank::solveWithV: RHS IN 's' part: ", rhs_s, hovMatrices);
-  nlp->log->write("hiopHessianLowRank::solveWithV: RHS IN 'y' part: ", rhs_y, hovMatrices);
-  hiopVector* rhs_saved= LinearAlgebraFactory::createVector(rhs_s.get_size()+rhs_y.get_size());
-  rhs_saved->copyFromStarting(0, rhs_s);
-  rhs_saved->copyFromStarting(l, rhs_y);
+  assert(N==rhs.get_size());
+  nlp->log->write("hiopHessianLowRank::solveWithV: RHS IN: ", rhs, hovMatrices);
+  hiopVector* rhs_saved = rhs.new_copy();
 #endif
 
   int lda=N, one=1, info;
   char uplo='L'; 
-#ifdef HIOP_DEEPCHECKS
-  assert(N==rhs_s.get_size()+rhs_y.get_size());
-#endif
-  hiopVector& rhs=new_2l_vec1(l);
-  rhs.copyFromStarting(0, rhs_s);
-  rhs.copyFromStarting(l, rhs_y);
 
   DSYTRS(&uplo, &N, &one, V->local_buffer(), &lda, _V_ipiv_vec, rhs.local_data(), &N, &info);
 
   if(info<0) nlp->log->printf(hovError, "hiopHessianLowRank::solveWithV error: %d argument to dsytrf has an illegal value\n", -info);
   assert(info==0);
 
-  //copy back the solution
-  rhs.copyToStarting(0,rhs_s);
-  rhs.copyToStarting(l,rhs_y);
-
 #ifdef HIOP_DEEPCHECKS
-  nlp->log->write("solveWithV: SOL OUT 's' part: ", rhs_s, hovMatrices);
-  nlp->log->write("solveWithV: SOL OUT 'y' part: ", rhs_y, hovMatrices);
+  nlp->log->write("solveWithV: SOL OUT: ", rhs, hovMatrices);
 
   //residual calculation
   double nrmrhs=rhs_saved->infnorm();
@@ -717,6 +688,7 @@ void hiopHessianLowRank::solveWithV(hiopMatrixDense& rhs)
 
 void hiopHessianLowRank::growL(const int& lmem_curr, const int& lmem_max, const hiopVector& YTs)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   int l=L->m();
 #ifdef HIOP_DEEPCHECKS
   assert(l==L->n());
@@ -744,6 +716,7 @@ void hiopHessianLowRank::growL(const int& lmem_curr, const int& lmem_max, const
 
 void hiopHessianLowRank::growD(const int& lmem_curr, const int& lmem_max, const double& sTy)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   int l=D->get_size();
   assert(l==lmem_curr);
   assert(lmem_max>=l);
@@ -757,10 +730,12 @@ void hiopHessianLowRank::growD(const int& lmem_curr, const int& lmem_max, const
   D=Dnew;
 }
 
-/* L_{ij} = s_{i-1}^T y_{j-1}, if i>j, otherwise zero. Here i,j = 0,1,...,l_curr-1
- * L_new = lift and shift L to the left; replace last row with [Yts;0]
+/* L_{ij} = s_i^T y_j, if pair i is more recent than pair j, otherwise zero. Here i,j = 0,1,...,l_curr-1
+ * are slots (rows) in the circular storage of S and Y.
+ * The new pair replaces the oldest one in 'slot' and it is the most recent pair, hence
+ * L_new = L with row 'slot' replaced by [Yts] (zero diagonal entry) and column 'slot' zeroed
  */
-void hiopHessianLowRank::updateL(const hiopVector& YTs, const double& sTy)
+void hiopHessianLowRank::updateL(const int& slot, const hiopVector& YTs)
 {
   int l=YTs.get_size();
 #ifdef HIOP_DEEPCHECKS
@@ -768,36 +743,28 @@ void hiopHessianLowRank::updateL(const hiopVector& YTs, const double& sTy)
   assert(l==L->n());
   assert(l_curr==l);
   assert(l_curr==l_max);
+  assert(slot>=0 && slot<l);
 #endif
-  const int lm1=l-1;
   double** L_mat=L->local_data();
   const double* yts_vec=YTs.local_data_const();
-  for(int i=1; i<lm1; i++)
-    for(int j=0; j<i; j++)
-      L_mat[i][j] = L_mat[i+1][j+1];
-
-  //is this really needed?
-  //for(int i=0; i<lm1; i++)
-  //  L_mat[i][lm1]=0.0;
-
-  //first entry in YTs corresponds to y_to_be_discarded_since_it_is_the_oldest'* s_new and is discarded
-  for(int j=0; j<lm1; j++)
-    L_mat[lm1][j]=yts_vec[j+1];
-
-  L_mat[lm1][lm1]=0.0;
+  //the entry of YTs in 'slot' corresponds to y_to_be_discarded_since_it_is_the_oldest'* s_new 
+  for(int j=0; j<l; j++)
+    L_mat[slot][j]=yts_vec[j];
+  for(int i=0; i<l; i++)
+    L_mat[i][slot]=0.0;
 }
-void hiopHessianLowRank::updateD(const double& sTy)
+void hiopHessianLowRank::updateD(const int& slot, const double& sTy)
 {
-  int l=D->get_size();
-  double* D_vec = D->local_data();
-  for(int i=0; i<l-1; i++)
-    D_vec[i]=D_vec[i+1];
-  D_vec[l-1]=sTy;
+#ifdef HIOP_DEEPCHECKS
+  assert(slot>=0 && slot<D->get_size());
+#endif
+  D->local_data()[slot]=sTy;
 }
 
 
 hiopVector&  hiopHessianLowRank::new_l_vec1(int l)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   if(_l_vec1!=NULL && _l_vec1->get_size()==l) return *_l_vec1;
   
   if(_l_vec1!=NULL) {
@@ -806,19 +773,9 @@ hiopVector&  hiopHessianLowRank::new_l_vec1(int l)
   _l_vec1= LinearAlgebraFactory::createVector(l);
   return *_l_vec1;
 }
-hiopVector&  hiopHessianLowRank::new_l_vec2(int l)
-{
-  if(_l_vec2!=NULL && _l_vec2->get_size()==l) return *_l_vec2;
-  
-  if(_l_vec2!=NULL) {
-    delete _l_vec2;
-  }
-  _l_vec2= LinearAlgebraFactory::createVector(l);
-  return *_l_vec2;
-}
-
 hiopMatrixDense& hiopHessianLowRank::new_lxl_mat1(int l)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   if(_lxl_mat1!=NULL) {
     if( l==_lxl_mat1->m() ) {
       return *_lxl_mat1;
@@ -832,6 +789,7 @@ hiopMatrixDense& hiopHessianLowRank::new_lxl_mat1(int l)
 }
 hiopMatrixDense& hiopHessianLowRank::new_kx2l_mat1(int k, int l)
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   int twol=2*l;
   if(NULL!=_kx2l_mat1) {
     assert(_kx2l_mat1->m()==k);
@@ -846,53 +804,27 @@ hiopMatrixDense& hiopHessianLowRank::new_kx2l_mat1(int k, int l)
   
   return *_kx2l_mat1;
 }
-hiopMatrixDense& hiopHessianLowRank::new_kxl_mat1(int k, int l)
+hiopMatrixDense& hiopHessianLowRank::new_kx2l_mat2(int k, int l)
 {
-  if(_kxl_mat1!=NULL) {
-    assert(_kxl_mat1->m()==k);
-    if( l==_kxl_mat1->n() ) {
-      return *_kxl_mat1;
+  hiopMemScope mem_scope(hiopMemLowRank);
+  int twol=2*l;
+  if(NULL!=_kx2l_mat2) {
+    assert(_kx2l_mat2->m()==k);
+    if( twol==_kx2l_mat2->n() ) {
+      return *_kx2l_mat2;
     } else {
-      delete _kxl_mat1; 
-      _kxl_mat1=NULL;
+      delete _kx2l_mat2; 
+      _kx2l_mat2=NULL;
     }
   }
-  _kxl_mat1 = LinearAlgebraFactory::createMatrixDense(k,l);
-  return *_kxl_mat1;
-}
-hiopMatrixDense& hiopHessianLowRank::new_S1(const hiopMatrixDense& X, const hiopMatrixDense& St)
-{
-  //S1 is X*some_diag*S  (kxl). Here St=S^T is lxn and X is kxn (l BFGS memory size, k number of constraints)
-  long long k=X.m(), n=St.n(), l=St.m();
-#ifdef HIOP_DEEPCHECKS
-  assert(n==X.n());
-  if(_S1!=NULL) 
-    assert(_S1->m()==k);
-#endif
-  if(NULL!=_S1 && _S1->n()!=l) { delete _S1; _S1=NULL; }
+  _kx2l_mat2 = LinearAlgebraFactory::createMatrixDense(k,twol);
   
-  if(NULL==_S1) _S1=LinearAlgebraFactory::createMatrixDense(k,l);
-
-  return *_S1;
-}
-
-hiopMatrixDense& hiopHessianLowRank::new_Y1(const hiopMatrixDense& X, const hiopMatrixDense& Yt)
-{
-  //Y1 is X*somediag*Y (kxl). Here Yt=Y^T is lxn,  X is kxn
-  long long k=X.m(), n=Yt.n(), l=Yt.m();
-#ifdef HIOP_DEEPCHECKS
-  assert(X.n()==n);
-  if(_Y1!=NULL) assert(_Y1->m()==k);
-#endif
-
-  if(NULL!=_Y1 && _Y1->n()!=l) { delete _Y1; _Y1=NULL; }
-
-  if(NULL==_Y1) _Y1=LinearAlgebraFactory::createMatrixDense(k,l);
-  return *_Y1;
+  return *_kx2l_mat2;
 }
 #ifdef HIOP_DEEPCHECKS
 void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, const hiopVector& x, bool addLogTerm) 
 {
+  hiopMemScope mem_scope(hiopMemLowRank);
   long long n=St->n();
   assert(l_curr==St->m());
   assert(y.get_size()==n);
@@ -918,9 +850,11 @@ void hiopHessianLowRank::timesVecCmn(double beta, hiopVector& y, double alpha, c
   //allocate and compute a_k and b_k
   vector<hiopVector*> a(l_curr),b(l_curr);
   for(int k=0; k<l_curr; k++) {
+    //the pairs are used in chronological order; the oldest pair is in slot l_head_
+    const int slot = (l_head_+k) % l_curr;
     //bk=yk/sqrt(yk'*sk)
-    yk->copyFrom(Yt->local_data()[k]);
-    sk->copyFrom(St->local_data()[k]);
+    yk->copyFrom(Yt->local_data()[slot]);
+    sk->copyFrom(St->local_data()[slot]);
     double skTyk=yk->dotProductWith(*sk);
     assert(skTyk>0);
     b[k]=dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
@@ -1024,28 +958,100 @@ symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W,
   }
 }
 
-/* W=S*D*X^T, where S is lxn, D is diag nxn, and X is kxn */
-void hiopHessianLowRank::
-matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, const hiopVector& d, const hiopMatrixDense& X)
+/* W = X*DhInv*[B0*S Y], where X is kxn, S and Y are nxl (stored as St and Yt), and W is kx2l
+ * The ops are performed locally (the reduce is done externally) in one sweep over X, S, and Y:
+ * the chunks of the rows of S and Y are reused from cache for all the k rows of X.
+ */
+void hiopHessianLowRank::matTimesDhInvTimesSY_local(hiopMatrixDense& W, const hiopMatrixDense& X)
 {
+  const int l=St->m(), k=X.m();
+  const size_t n_local=X.get_local_size_n();
 #ifdef HIOP_DEEPCHECKS
-  assert(S.n()==d.get_size());
-  assert(S.n()==X.n());
-#endif  
-  int l=S.m(), n=d.get_local_size(), k=X.m();
-  double *Sdi, *Wdi, *Xdj, acc;
-  double **Wd=W.local_data(), **Sd=S.local_data(), **Xd=X.local_data(); const double *diag=d.local_data_const();
-  //!opt
-  for(int i=0;i<l; i++) {
-    Sdi=Sd[i]; Wdi=Wd[i];
+  assert(W.m()==k);
+  assert(W.n()==2*l);
+  assert(St->n()==X.n());
+  assert(DhInv->get_local_size()==n_local);
+#endif
+  double **Wd=W.local_data(), **Xd=X.local_data(), **Sd=St->local_data(), **Yd=Yt->local_data();
+  const double* dh=DhInv->local_data_const();
+  double xdh[LOWRANK_CHUNK_LEN];
+
+  W.setToZero();
+  for(size_t p0=0; p0<n_local; p0+=LOWRANK_CHUNK_LEN) {
+    const size_t len = min((size_t)LOWRANK_CHUNK_LEN, n_local-p0);
     for(int j=0; j<k; j++) {
-      Xdj=Xd[j];
-      acc=0.;
-      for(int p=0; p<n; p++) 
-	acc += Sdi[p]*diag[p]*Xdj[p];
-      //for(int p=0; p<n;p++) {acc += *Si * *diag * *Xd; Si++; diag++; Xd+=n;}
-      
-      Wdi[j]=acc;
+      const double* Xj=Xd[j]+p0;
+      for(size_t p=0; p<len; p++) 
+	xdh[p] = Xj[p]*dh[p0+p];
+
+      double* Wj=Wd[j];
+      for(int i=0; i<l; i++) {
+	const double *Si=Sd[i]+p0, *Yi=Yd[i]+p0;
+	double acc_s=0., acc_y=0.;
+	for(size_t p=0; p<len; p++) {
+	  acc_s += xdh[p]*Si[p];
+	  acc_y += xdh[p]*Yi[p];
+	}
+	Wj[i]   += acc_s;
+	Wj[l+i] += acc_y;
+      }
+    }
+  }
+  //B0=sigma*I
+  for(int j=0; j<k; j++)
+    for(int i=0; i<l; i++)
+      Wd[j][i] *= sigma;
+}
+
+/* Computes Y^T*DhInv*Y, S^T*B0*DhInv*Y, and S^T*B0*(DhInv*B0-I)*S, each lxl and stored row-major 
+ * in this order in 'buff', which should have at least 3*l*l entries. B0=sigma*I.
+ * The ops are performed locally (the reduce is done externally) in one sweep over S and Y.
+ */
+void hiopHessianLowRank::productsSY_local(double* buff)
+{
+  const int l=St->m();
+  const size_t n_local=St->get_local_size_n();
+  double **Sd=St->local_data(), **Yd=Yt->local_data();
+  const double* dh=DhInv->local_data_const();
+  double *YDY=buff, *SDY=buff+l*l, *SDS=buff+2*l*l;
+  double d_sy[LOWRANK_CHUNK_LEN], d_ss[LOWRANK_CHUNK_LEN];
+
+  for(int i=0; i<3*l*l; i++) buff[i]=0.;
+  
+  for(size_t p0=0; p0<n_local; p0+=LOWRANK_CHUNK_LEN) {
+    const size_t len = min((size_t)LOWRANK_CHUNK_LEN, n_local-p0);
+    const double* dhc=dh+p0;
+    for(size_t p=0; p<len; p++) {
+      d_sy[p] = sigma*dhc[p];              //B0*DhInv
+      d_ss[p] = sigma*(sigma*dhc[p]-1.0);  //B0*(DhInv*B0-I)
+    }
+    for(int i=0; i<l; i++) {
+      const double *Si=Sd[i]+p0, *Yi=Yd[i]+p0;
+      for(int j=0; j<l; j++) {
+	const double *Sj=Sd[j]+p0, *Yj=Yd[j]+p0;
+	double acc_sy=0.;
+	if(j>=i) {
+	  //symmetric blocks: only the upper triangle is computed
+	  double acc_yy=0., acc_ss=0.;
+	  for(size_t p=0; p<len; p++) {
+	    acc_yy += Yi[p]*dhc[p]*Yj[p];
+	    acc_sy += Si[p]*d_sy[p]*Yj[p];
+	    acc_ss += Si[p]*d_ss[p]*Sj[p];
+	  }
+	  YDY[i*l+j] += acc_yy;
+	  SDS[i*l+j] += acc_ss;
+	} else {
+	  for(size_t p=0; p<len; p++) 
+	    acc_sy += Si[p]*d_sy[p]*Yj[p];
+	}
+	SDY[i*l+j] += acc_sy;
+      }
+    }
+  }
+  for(int i=0; i<l; i++) {
+    for(int j=0; j<i; j++) {
+      YDY[i*l+j] = YDY[j*l+i];
+      SDS[i*l+j] = SDS[j*l+i];
     }
   }
 }
@@ -1128,9 +1134,9 @@ bool hiopHessianInvLowRank_obsolette::
 update(const hiopIterate& it_curr, const hiopVector& grad_f_curr_,
        const hiopMatrix& Jac_c_curr_, const hiopMatrix& Jac_d_curr_)
 {
-  const hiopVectorPar&   grad_f_curr= dynamic_cast<const hiopVectorPar&>(grad_f_curr_);
-  const hiopMatrixDense& Jac_c_curr = dynamic_cast<const hiopMatrixDense&>(Jac_c_curr_);
-  const hiopMatrixDense& Jac_d_curr = dynamic_cast<const hiopMatrixDense&>(Jac_d_curr_);
+  const hiopVectorPar&   grad_f_curr= known_cast<const hiopVectorPar&>(grad_f_curr_);
+  const hiopMatrixDense& Jac_c_curr = known_cast<const hiopMatrixDense&>(Jac_c_curr_);
+  const hiopMatrixDense& Jac_d_curr = known_cast<const hiopMatrixDense&>(Jac_d_curr_);
 
 #ifdef HIOP_DEEPCHECKS
   assert(it_curr.zl->matchesPattern(nlp->get_ixl()));
@@ -1259,8 +1265,8 @@ bool hiopHessianInvLowRank_obsolette::updateLogBarrierDiagonal(const hiopVector&
  */  
 void hiopHessianInvLowRank_obsolette::apply(double beta, hiopVector& y_, double alpha, const hiopVector& x_)
 {
-  hiopVectorPar& y = dynamic_cast<hiopVectorPar&>(y_);
-  const hiopVectorPar& x = dynamic_cast<const hiopVectorPar&>(x_);
+  hiopVectorPar& y = known_cast<hiopVectorPar&>(y_);
+  const hiopVectorPar& x = known_cast<const hiopVectorPar&>(x_);
   long long n=St->n(), l=St->m();
 #ifdef HIOP_DEEPCHECKS
   assert(y.get_size()==n);
@@ -1343,14 +1349,14 @@ symmetricTimesMat(double beta, hiopMatrixDense& W,
   symmMatTimesDiagTimesMatTrans_local(0.0,DpYtH0Y, 1.0,*Yt,*H0);
 #ifdef HIOP_USE_MPI
   //!opt - use one buffer and one reduce call
-  ierr=MPI_Allreduce(S1.local_buffer(),      _buff_lxk,l*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr=hiopAllreduce(S1.local_buffer(),      _buff_lxk,l*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm(), "hess_invlowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
   S1.copyFrom(_buff_lxk);
-  ierr=MPI_Allreduce(Y1.local_buffer(),      _buff_lxk,l*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr=hiopAllreduce(Y1.local_buffer(),      _buff_lxk,l*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm(), "hess_invlowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
   Y1.copyFrom(_buff_lxk);
-  ierr=MPI_Allreduce(W.local_buffer(),       _buff_kxk,k*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr=hiopAllreduce(W.local_buffer(),       _buff_kxk,k*k, MPI_DOUBLE,MPI_SUM,nlp->get_comm(), "hess_invlowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
   W.copyFrom(_buff_kxk);
 
-  ierr=MPI_Allreduce(DpYtH0Y.local_buffer(), _buff_lxl,l*l, MPI_DOUBLE,MPI_SUM,nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  ierr=hiopAllreduce(DpYtH0Y.local_buffer(), _buff_lxl,l*l, MPI_DOUBLE,MPI_SUM,nlp->get_comm(), "hess_invlowrank_symMatTimesInv"); assert(ierr==MPI_SUCCESS);
   DpYtH0Y.copyFrom(_buff_lxl);
 #endif
  //add D to finish calculating D+Y^T*H0*Y
@@ -87,6 +87,12 @@ namespace hiop
  *  
  * Parallel computations: Dk, B0 are distributed vectors, M is distributed 
  * column-wise, and N is local (stored on all processors).
+ *
+ * Storage: the pairs (s,y) are stored as rows of St and Yt used as circular buffers: once the 
+ * memory is full, a new pair overwrites the oldest one (in row/slot l_head_) and no rows are 
+ * shifted. L and D are kept in the same (slot) order as the rows of St and Yt, which amounts to
+ * a symmetric permutation of V. The kernels in 'solve', 'symMatTimesInverseTimesMatTrans', and 
+ * 'updateInternalBFGSRepresentation' traverse S and Y only once (in chunks of the local n).
  */
 class hiopHessianLowRank : public hiopMatrix
 {
@@ -126,6 +132,7 @@ public:
 protected:
   int l_max; //max memory size
   int l_curr; //number of pairs currently stored
+  int l_head_; //slot (row in St and Yt) of the oldest pair, to be overwritten when the memory is full
   double sigma; //initial scaling factor of identity
   double sigma0; //default scaling factor of identity
   int sigma_update_strategy;
@@ -153,8 +160,8 @@ private:
 #endif
   void growL(const int& lmem_curr, const int& lmem_max, const hiopVector& YTs);
   void growD(const int& l_curr, const int& l_max, const double& sTy);
-  void updateL(const hiopVector& STy, const double& sTy);
-  void updateD(const double& sTy);
+  void updateL(const int& slot, const hiopVector& YTs);
+  void updateD(const int& slot, const double& sTy);
   //also stored are the iterate, gradient obj, and Jacobians at the previous optimization iteration
   hiopIterate *_it_prev;
   hiopVector *_grad_f_prev;
@@ -167,19 +174,14 @@ private:
   double* _buff_kxk; // size = num_constraints^2 
   double* _buff_2lxk; // size = 2 x q-Newton mem size x num_constraints
   double *_buff1_lxlx3, *_buff2_lxlx3;
-  //auxiliary objects
-  hiopMatrixDense *_S1, *_Y1, *_lxl_mat1, *_kx2l_mat1, *_kxl_mat1; //preallocated matrices 
-  //holds X*D*S
-  hiopMatrixDense& new_S1(const hiopMatrixDense& X, const hiopMatrixDense& St);
-  //holds X*D*Y
-  hiopMatrixDense& new_Y1(const hiopMatrixDense& X, const hiopMatrixDense& Yt);
+  //auxiliary objects; they are reallocated only while the memory grows to l_max pairs
+  hiopMatrixDense *_lxl_mat1, *_kx2l_mat1, *_kx2l_mat2; //preallocated matrices 
   hiopMatrixDense& new_lxl_mat1 (int l);
-  hiopMatrixDense& new_kxl_mat1 (int k, int l);
   hiopMatrixDense& new_kx2l_mat1(int k, int l);
+  hiopMatrixDense& new_kx2l_mat2(int k, int l);
   
-  hiopVector *_l_vec1, *_l_vec2, *_n_vec1, *_n_vec2, *_2l_vec1;
+  hiopVector *_l_vec1, *_n_vec1, *_n_vec2, *_2l_vec1;
   hiopVector& new_l_vec1(int l);
-  hiopVector& new_l_vec2(int l);
   inline hiopVector& new_n_vec1(long long n)
   {
 #ifdef HIOP_DEEPCHECKS
@@ -208,14 +210,16 @@ private:
   static void symmMatTimesDiagTimesMatTrans_local(double beta, hiopMatrixDense& W_,
 					   double alpha, const hiopMatrixDense& X_,
 					   const hiopVector& d);
-  /* W=S*Diag*X^T */
-  static void matTimesDiagTimesMatTrans_local(hiopMatrixDense& W, const hiopMatrixDense& S, 
-					      const hiopVector& d, const hiopMatrixDense& X);
+  /* W = X*DhInv*[B0*S Y] (kx2l), locally, in one sweep over X, S, and Y */
+  void matTimesDhInvTimesSY_local(hiopMatrixDense& W, const hiopMatrixDense& X);
+  /* Y^T*DhInv*Y, S^T*B0*DhInv*Y, and S^T*B0*(DhInv*B0-I)*S (lxl each, in this order and row-major 
+   * in 'buff'), locally, in one sweep over S and Y */
+  void productsSY_local(double* buff);
   /* members and utilities related to V matrix: factorization and solve */
   hiopVector *_V_work_vec;
   int _V_ipiv_size; int* _V_ipiv_vec;
   void factorizeV();
-  void solveWithV(hiopVector& rhs_s, hiopVector& rhs_y);
+  void solveWithV(hiopVector& rhs_sy);
   void solveWithV(hiopMatrixDense& rhs);
 private:
   hiopHessianLowRank() {};
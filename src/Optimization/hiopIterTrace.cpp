@@ -0,0 +1,181 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopIterTrace.hpp"
+
+#include <cmath>
+
+namespace hiop
+{
+
+hiopIterTrace::hiopIterTrace(hiopNlpFormulation* nlp)
+  : nlp_(nlp), f_(NULL), csv_(false)
+{
+}
+
+hiopIterTrace::~hiopIterTrace()
+{
+  close();
+}
+
+bool hiopIterTrace::open()
+{
+  close();
+  if(NULL==nlp_) return false;
+
+  std::string format = nlp_->options->GetString("trace_iter");
+  if(format=="no") return true;
+#ifdef HIOP_USE_MPI
+  if(0 != nlp_->get_rank()) return true;
+#endif
+  csv_ = format=="csv";
+  const std::string fname = nlp_->options->GetString("trace_iter_file") + (csv_ ? ".csv" : ".jsonl");
+  f_ = fopen(fname.c_str(), "w");
+  if(NULL==f_) {
+    nlp_->log->printf(hovWarning, "Could not open '%s' for writing the iterations trace.\n", 
+		      fname.c_str());
+    return false;
+  }
+  if(csv_) {
+    fprintf(f_, "iter,obj,inf_pr,inf_du,mu,alpha_pr,alpha_du,ls_trials,inertia_corr,kkt_size,"
+	    "tm_iter,tm_kkt_init,tm_kkt_assembly,tm_kkt_fact,tm_kkt_rhs,tm_kkt_solve,"
+	    "tm_eval_f,tm_eval_grad_f,tm_eval_cons,tm_eval_jac,tm_eval_hess,"
+	    "n_eval_f,n_eval_grad_f,n_eval_cons,n_eval_jac,n_eval_hess\n");
+  }
+  tm_prev_ = std::chrono::steady_clock::now();
+  get_stats(tm_kkt_prev_, tm_eval_prev_, n_eval_prev_);
+  return true;
+}
+
+void hiopIterTrace::close()
+{
+  if(f_) fclose(f_);
+  f_ = NULL;
+}
+
+void hiopIterTrace::get_stats(double* tm_kkt, double* tm_eval, int* n_eval) const
+{
+  const hiopRunStats& stats = nlp_->runStats;
+  tm_kkt[0] = stats.kkt.tmTotalUpdateInit;
+  tm_kkt[1] = stats.kkt.tmTotalUpdateLinsys;
+  tm_kkt[2] = stats.kkt.tmTotalUpdateInnerFact;
+  tm_kkt[3] = stats.kkt.tmTotalSolveRhsManip;
+  tm_kkt[4] = stats.kkt.tmTotalSolveTriangular;
+
+  tm_eval[0] = stats.tmEvalObj.getElapsedTime();
+  tm_eval[1] = stats.tmEvalGrad_f.getElapsedTime();
+  tm_eval[2] = stats.tmEvalCons.getElapsedTime();
+  tm_eval[3] = stats.tmEvalJac_con.getElapsedTime();
+  tm_eval[4] = stats.tmEvalHessL.getElapsedTime();
+
+  n_eval[0] = stats.nEvalObj;
+  n_eval[1] = stats.nEvalGrad_f;
+  n_eval[2] = stats.nEvalCons_eq>stats.nEvalCons_ineq ? stats.nEvalCons_eq : stats.nEvalCons_ineq;
+  n_eval[3] = stats.nEvalJac_con_eq>stats.nEvalJac_con_ineq ? stats.nEvalJac_con_eq : stats.nEvalJac_con_ineq;
+  n_eval[4] = stats.nEvalHessL;
+}
+
+void hiopIterTrace::write_double(const char* name, double val)
+{
+  if(csv_) {
+    if(std::isfinite(val)) fprintf(f_, ",%.10e", val);
+    else                   fprintf(f_, ",");
+  } else {
+    //JSON does not support inf and nan
+    if(std::isfinite(val)) fprintf(f_, ",\"%s\":%.10e", name, val);
+    else                   fprintf(f_, ",\"%s\":null", name);
+  }
+}
+
+void hiopIterTrace::write_iter(int iter, double obj, double inf_pr, double inf_du, double mu,
+			       double alpha_pr, double alpha_du, int ls_trials, long long kkt_size)
+{
+  if(NULL==f_) return;
+
+  const std::chrono::steady_clock::time_point tm_now = std::chrono::steady_clock::now();
+  double tm_kkt[5], tm_eval[5]; int n_eval[5];
+  get_stats(tm_kkt, tm_eval, n_eval);
+
+  if(csv_) fprintf(f_, "%d", iter);
+  else     fprintf(f_, "{\"iter\":%d", iter);
+  write_double("obj", obj);
+  write_double("inf_pr", inf_pr);
+  write_double("inf_du", inf_du);
+  write_double("mu", mu);
+  write_double("alpha_pr", alpha_pr);
+  write_double("alpha_du", alpha_du);
+  if(csv_) {
+    fprintf(f_, ",%d,%d,%lld", ls_trials, nlp_->runStats.kkt.nUpdateICCorr, kkt_size);
+  } else {
+    fprintf(f_, ",\"ls_trials\":%d,\"inertia_corr\":%d,\"kkt_size\":%lld", 
+	    ls_trials, nlp_->runStats.kkt.nUpdateICCorr, kkt_size);
+  }
+
+  write_double("tm_iter", std::chrono::duration<double>(tm_now-tm_prev_).count());
+  const char* tm_kkt_names[5] = {"tm_kkt_init", "tm_kkt_assembly", "tm_kkt_fact", "tm_kkt_rhs", "tm_kkt_solve"};
+  for(int i=0; i<5; i++) write_double(tm_kkt_names[i], tm_kkt[i]-tm_kkt_prev_[i]);
+  const char* tm_eval_names[5] = {"tm_eval_f", "tm_eval_grad_f", "tm_eval_cons", "tm_eval_jac", "tm_eval_hess"};
+  for(int i=0; i<5; i++) write_double(tm_eval_names[i], tm_eval[i]-tm_eval_prev_[i]);
+  const char* n_eval_names[5] = {"n_eval_f", "n_eval_grad_f", "n_eval_cons", "n_eval_jac", "n_eval_hess"};
+  for(int i=0; i<5; i++) {
+    if(csv_) fprintf(f_, ",%d", n_eval[i]-n_eval_prev_[i]);
+    else     fprintf(f_, ",\"%s\":%d", n_eval_names[i], n_eval[i]-n_eval_prev_[i]);
+  }
+  fprintf(f_, csv_ ? "\n" : "}\n");
+  //make the records available to the tools monitoring the run
+  fflush(f_);
+
+  tm_prev_ = tm_now;
+  for(int i=0; i<5; i++) {
+    tm_kkt_prev_[i] = tm_kkt[i];
+    tm_eval_prev_[i] = tm_eval[i];
+    n_eval_prev_[i] = n_eval[i];
+  }
+}
+
+} //end namespace
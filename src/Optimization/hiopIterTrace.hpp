@@ -0,0 +1,108 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_ITER_TRACE
+#define HIOP_ITER_TRACE
+
+#include "hiopNlpFormulation.hpp"
+
+#include <cstdio>
+#include <chrono>
+
+namespace hiop
+{
+
+/* Writes one machine-readable record per optimization iteration to 'hiop_trace.jsonl' (JSON 
+ * Lines, one JSON object per line) or to 'hiop_trace.csv' (with a header line), as specified 
+ * by the option 'trace_iter'; the name 'hiop_trace' can be changed with the option 
+ * 'trace_iter_file'. The file is written by the master rank and overwritten at each solve.
+ *
+ * The times (in seconds) and the evaluation counts of a record are the ones incurred since the
+ * previous record, i.e., during the iteration that produced the iterate. The fields are:
+ *  iter, obj, inf_pr, inf_du, mu, alpha_pr, alpha_du, ls_trials, inertia_corr, kkt_size,
+ *  tm_iter, tm_kkt_init, tm_kkt_assembly, tm_kkt_fact, tm_kkt_rhs, tm_kkt_solve,
+ *  tm_eval_f, tm_eval_grad_f, tm_eval_cons, tm_eval_jac, tm_eval_hess,
+ *  n_eval_f, n_eval_grad_f, n_eval_cons, n_eval_jac, n_eval_hess
+ * 'kkt_size' is the dimension of the linear system factorized by the KKT solver (-1 when not 
+ * available) and 'inertia_corr' is the number of inertia corrections of the last factorization.
+ * The KKT times are available only for the KKT solvers that report them in hiopRunKKTSolStats.
+ */
+class hiopIterTrace
+{
+public:
+  hiopIterTrace(hiopNlpFormulation* nlp);
+  virtual ~hiopIterTrace();
+
+  //opens the trace file if requested by the option 'trace_iter'; should be called at the 
+  //beginning of each solve, after the run statistics are initialized
+  bool open();
+  void close();
+  inline bool is_on() const { return NULL!=f_; }
+
+  void write_iter(int iter, double obj, double inf_pr, double inf_du, double mu,
+		  double alpha_pr, double alpha_du, int ls_trials, long long kkt_size);
+private:
+  hiopNlpFormulation* nlp_;
+  FILE* f_;
+  bool csv_;
+
+  //values of the cumulative statistics at the previous record
+  std::chrono::steady_clock::time_point tm_prev_;
+  double tm_kkt_prev_[5];
+  double tm_eval_prev_[5];
+  int n_eval_prev_[5];
+
+  void get_stats(double* tm_kkt, double* tm_eval, int* n_eval) const;
+  void write_double(const char* name, double val);
+private:
+  hiopIterTrace(const hiopIterTrace&);
+  hiopIterTrace& operator=(const hiopIterTrace&);
+};
+
+} //end namespace
+#endif
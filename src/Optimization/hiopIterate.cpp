@@ -47,29 +47,61 @@
 // product endorsement purposes.
 
 #include "hiopIterate.hpp"
+#include "hiop_blasdefs.hpp"
 
 #include <cmath>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 namespace hiop
 {
 
+/* length of 'n' doubles rounded up to a multiple of 64 bytes */
+static inline long long aligned_length(long long n)
+{
+  return (n+7)/8*8;
+}
+
 hiopIterate::hiopIterate(const hiopNlpFormulation* nlp_)
 {
   nlp = nlp_;
-  x = dynamic_cast<hiopVectorPar*>(nlp->alloc_primal_vec());
-  d = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_ineq_vec());
-  sxl = x->alloc_clone();
-  sxu = x->alloc_clone();
-  sdl = d->alloc_clone();
-  sdu = d->alloc_clone();
+  const hiopVectorPar& xlay = known_cast<const hiopVectorPar&>(nlp->get_xl());
+  const hiopVectorPar& dlay = known_cast<const hiopVectorPar&>(nlp->get_dl());
+  const hiopVectorPar& yclay = known_cast<const hiopVectorPar&>(nlp->get_crhs());
+  const long long nx_raw = xlay.get_local_size();
+  const long long nd_raw = dlay.get_local_size();
+  const long long nx = aligned_length(nx_raw);
+  const long long nd = aligned_length(nd_raw);
+
+  off_duals_eq_  = 2*nx + 3*nd + nx_raw;
+  off_duals_bnd_ = aligned_length(off_duals_eq_ + yclay.get_local_size() + nd_raw);
+  buffer_size_   = off_duals_bnd_ + 2*nx + 2*nd;
+
+  buffer_ = hiopMemoryPool::allocate(buffer_size_, pool_);
+  //the padding between the components is part of the blocks updated by the BLAS-1 calls
+  memset(buffer_, 0, buffer_size_*sizeof(double));
+  mem_cat_ = hiopMemTracker::current_category();
+  mem_tracker_ = &hiopMemTracker::global();
+  mem_tracker_->add(mem_cat_, buffer_size_*sizeof(double));
+
+  double* p = buffer_;
+  //primals
+  sxl = new hiopVectorPar(xlay, p); p += nx;
+  sxu = new hiopVectorPar(xlay, p); p += nx;
+  d   = new hiopVectorPar(dlay, p); p += nd;
+  sdl = new hiopVectorPar(dlay, p); p += nd;
+  sdu = new hiopVectorPar(dlay, p); p += nd;
+  x   = new hiopVectorPar(xlay, p); p += nx_raw;
   //duals
-  yc = dynamic_cast<hiopVectorPar*>(nlp->alloc_dual_eq_vec());
-  yd = d->alloc_clone();
-  zl = x->alloc_clone();
-  zu = x->alloc_clone();
-  vl = d->alloc_clone();
-  vu = d->alloc_clone();
+  assert(p == buffer_+off_duals_eq_);
+  yc = new hiopVectorPar(yclay, p); p += yclay.get_local_size();
+  yd = new hiopVectorPar(dlay, p);
+  p = buffer_+off_duals_bnd_;
+  zl = new hiopVectorPar(xlay, p);  p += nx;
+  zu = new hiopVectorPar(xlay, p);  p += nx;
+  vl = new hiopVectorPar(dlay, p);  p += nd;
+  vu = new hiopVectorPar(dlay, p);  p += nd;
+  assert(p == buffer_+buffer_size_);
 }
 
 hiopIterate::~hiopIterate()
@@ -86,6 +118,8 @@ hiopIterate::~hiopIterate()
   if(zu) delete zu;
   if(vl) delete vl;
   if(vu) delete vu;
+  hiopMemoryPool::deallocate(buffer_, buffer_size_, pool_);
+  mem_tracker_->remove(mem_cat_, buffer_size_*sizeof(double));
 }
 
 /* cloning and copying */
@@ -104,20 +138,9 @@ hiopIterate* hiopIterate::new_copy() const
 
 void  hiopIterate::copyFrom(const hiopIterate& src)
 {
-  x->copyFrom(*src.x);
-  d->copyFrom(*src.d);
-
-  yc->copyFrom(*src.yc); 
-  yd->copyFrom(*src.yd);
-
-  sxl->copyFrom(*src.sxl); 
-  sxu->copyFrom(*src.sxu);
-  sdl->copyFrom(*src.sdl);
-  sdu->copyFrom(*src.sdu);
-  zl->copyFrom(*src.zl); 
-  zu->copyFrom(*src.zu);
-  vl->copyFrom(*src.vl);
-  vu->copyFrom(*src.vu);
+  assert(buffer_size_==src.buffer_size_);
+  int n = (int)buffer_size_, one = 1;
+  DCOPY(&n, src.buffer_, &one, buffer_, &one);
 }
 
 void hiopIterate::print(FILE* f, const char* msg/*=NULL*/) const
@@ -188,7 +211,7 @@ double hiopIterate::normOneOfBoundDuals() const
   double nrm1=zl->onenorm_local() + zu->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "iter_normOneOfBoundDuals"); assert(MPI_SUCCESS==ierr);
   nrm1=nrm1_global;
 #endif
   nrm1 += vl->onenorm_local() + vu->onenorm_local();
@@ -207,7 +230,7 @@ double hiopIterate::normOneOfEqualityDuals() const
   double nrm1=zl->onenorm_local() + zu->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(&nrm1, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "iter_normOneOfEqualityDuals"); assert(MPI_SUCCESS==ierr);
   nrm1=nrm1_global;
 #endif
   nrm1 += vl->onenorm_local() + vu->onenorm_local() + yc->onenorm_local() + yd->onenorm_local();
@@ -226,7 +249,7 @@ void hiopIterate::normOneOfDuals(double& nrm1Eq, double& nrm1Bnd) const
   nrm1Bnd = zl->onenorm_local() + zu->onenorm_local();
 #ifdef HIOP_USE_MPI
   double nrm1_global;
-  int ierr=MPI_Allreduce(&nrm1Bnd, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm());
+  int ierr=hiopAllreduce(&nrm1Bnd, &nrm1_global, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "iter_normOneOfDuals");
   assert(MPI_SUCCESS==ierr);
   nrm1Bnd=nrm1_global;
 #endif
@@ -305,7 +328,7 @@ fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal
   alphadual=fmin(alphadual,alpha); 
 #ifdef HIOP_USE_MPI
   double aux[2]={alphaprimal,alphadual}, aux_g[2];
-  int ierr=MPI_Allreduce(aux, aux_g, 2, MPI_DOUBLE, MPI_MIN, nlp->get_comm()); assert(MPI_SUCCESS==ierr);
+  int ierr=hiopAllreduce(aux, aux_g, 2, MPI_DOUBLE, MPI_MIN, nlp->get_comm(), "iter_fractionToTheBdry"); assert(MPI_SUCCESS==ierr);
   alphaprimal=aux_g[0]; alphadual=aux_g[1];
 #endif
 
@@ -313,14 +336,20 @@ fractionToTheBdry(const hiopIterate& dir, const double& tau, double& alphaprimal
 }
 
 
+/* this[begin:end) = iter[begin:end) + alpha*dir[begin:end) */
+static inline void take_step_block(double* dest, const double* iter, const double* dir,
+				   long long len, double alpha)
+{
+  int n = (int)len, one = 1;
+  DCOPY(&n, const_cast<double*>(iter), &one, dest, &one);
+  DAXPY(&n, &alpha, const_cast<double*>(dir), &one, dest, &one);
+}
+
 bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  x->copyFrom(*iter.x); x->axpy(alphaprimal, *dir.x);
-  d->copyFrom(*iter.d); d->axpy(alphaprimal, *dir.d);
-  sxl->copyFrom(*iter.sxl); sxl->axpy(alphaprimal,*dir.sxl);
-  sxu->copyFrom(*iter.sxu); sxu->axpy(alphaprimal,*dir.sxu);
-  sdl->copyFrom(*iter.sdl); sdl->axpy(alphaprimal,*dir.sdl);
-  sdu->copyFrom(*iter.sdu); sdu->axpy(alphaprimal,*dir.sdu);
+  assert(buffer_size_==iter.buffer_size_ && buffer_size_==dir.buffer_size_);
+  //sxl, sxu, d, sdl, sdu, and x
+  take_step_block(buffer_, iter.buffer_, dir.buffer_, off_duals_eq_, alphaprimal);
 #ifdef HIOP_DEEPCHECKS
   assert(sxl->matchesPattern(nlp->get_ixl()));
   assert(sxu->matchesPattern(nlp->get_ixu()));
@@ -331,12 +360,13 @@ bool hiopIterate::takeStep_primals(const hiopIterate& iter, const hiopIterate& d
 }
 bool hiopIterate::takeStep_duals(const hiopIterate& iter, const hiopIterate& dir, const double& alphaprimal, const double& alphadual)
 {
-  yd->copyFrom(*iter.yd); yd->axpy(alphaprimal, *dir.yd);
-  yc->copyFrom(*iter.yc); yc->axpy(alphaprimal, *dir.yc);
-  zl->copyFrom(*iter.zl); zl->axpy(alphadual, *dir.zl);
-  zu->copyFrom(*iter.zu); zu->axpy(alphadual, *dir.zu);
-  vl->copyFrom(*iter.vl); vl->axpy(alphadual, *dir.vl);
-  vu->copyFrom(*iter.vu); vu->axpy(alphadual, *dir.vu);
+  assert(buffer_size_==iter.buffer_size_ && buffer_size_==dir.buffer_size_);
+  //yc and yd
+  take_step_block(buffer_+off_duals_eq_, iter.buffer_+off_duals_eq_, dir.buffer_+off_duals_eq_,
+		  off_duals_bnd_-off_duals_eq_, alphaprimal);
+  //zl, zu, vl, and vu
+  take_step_block(buffer_+off_duals_bnd_, iter.buffer_+off_duals_bnd_, dir.buffer_+off_duals_bnd_,
+		  buffer_size_-off_duals_bnd_, alphadual);
 #ifdef HIOP_DEEPCHECKS
   assert(zl->matchesPattern(nlp->get_ixl()));
   assert(zu->matchesPattern(nlp->get_ixu()));
@@ -390,7 +420,7 @@ double hiopIterate::evalLogBarrier() const
   barrier+= sxu->logBarrier_local(nlp->get_ixu());
 #ifdef HIOP_USE_MPI
   double res;
-  int ierr = MPI_Allreduce(&barrier, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  int ierr = hiopAllreduce(&barrier, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "iter_evalLogBarrier"); assert(ierr==MPI_SUCCESS);
   barrier=res;
 #endif
   barrier+= sdl->logBarrier_local(nlp->get_idl());
@@ -420,7 +450,7 @@ double hiopIterate::linearDampingTerm(const double& mu, const double& kappa_d) c
   term += sxu->linearDampingTerm_local(nlp->get_ixu(), nlp->get_ixl(), mu, kappa_d);
 #ifdef HIOP_USE_MPI
   double res;
-  int ierr = MPI_Allreduce(&term, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm()); assert(ierr==MPI_SUCCESS);
+  int ierr = hiopAllreduce(&term, &res, 1, MPI_DOUBLE, MPI_SUM, nlp->get_comm(), "iter_linearDampingTerm"); assert(ierr==MPI_SUCCESS);
   term = res;
 #endif  
   term += sdl->linearDampingTerm_local(nlp->get_idl(), nlp->get_idu(), mu, kappa_d);
@@ -434,12 +464,12 @@ void hiopIterate::addLinearDampingTermToGrad_x(const double& mu, const double& k
   /*sxl->addLinearDampingTermToGrad(nlp->get_ixl(), nlp->get_ixu(), mu, kappa_d, grad_x);
     sxu->addLinearDampingTermToGrad(nlp->get_ixu(), nlp->get_ixl(), mu, kappa_d, grad_x); */
   //I'll do it in place, in one for loop, to be faster
-  const double* ixl=dynamic_cast<const hiopVectorPar&>(nlp->get_ixl()).local_data_const();
-  const double* ixu=dynamic_cast<const hiopVectorPar&>(nlp->get_ixu()).local_data_const();
+  const double* ixl=known_cast<const hiopVectorPar&>(nlp->get_ixl()).local_data_const();
+  const double* ixu=known_cast<const hiopVectorPar&>(nlp->get_ixu()).local_data_const();
   const double*  xv=x->local_data_const();   long long n_local = x->get_local_size();
-  double* gv = dynamic_cast<hiopVectorPar&>(grad_x).local_data();
+  double* gv = known_cast<hiopVectorPar&>(grad_x).local_data();
 #ifdef HIOP_DEEPCHECKS
-  assert(n_local==dynamic_cast<hiopVectorPar&>(grad_x).get_local_size());
+  assert(n_local==known_cast<hiopVectorPar&>(grad_x).get_local_size());
 #endif
   
   const double ct=kappa_d*mu;
@@ -488,12 +518,12 @@ void hiopIterate::addLinearDampingTermToGrad_d(const double& mu, const double& k
   /*sxl->addLinearDampingTermToGrad(nlp->get_ixl(), nlp->get_ixu(), mu, kappa_d, grad_x);
     sxu->addLinearDampingTermToGrad(nlp->get_ixu(), nlp->get_ixl(), mu, kappa_d, grad_x); */
   //I'll do it in place, in one for loop, to be faster
-  const double* idl=dynamic_cast<const hiopVectorPar&>(nlp->get_idl()).local_data_const();
-  const double* idu=dynamic_cast<const hiopVectorPar&>(nlp->get_idu()).local_data_const();
+  const double* idl=known_cast<const hiopVectorPar&>(nlp->get_idl()).local_data_const();
+  const double* idu=known_cast<const hiopVectorPar&>(nlp->get_idu()).local_data_const();
   const double*  dv=d->local_data_const();   long long n_local = d->get_local_size();
-  double* gv = dynamic_cast<hiopVectorPar&>(grad_d).local_data();
+  double* gv = known_cast<hiopVectorPar&>(grad_d).local_data();
 #ifdef HIOP_DEEPCHECKS
-  assert(n_local==dynamic_cast<hiopVectorPar&>(grad_d).get_local_size());
+  assert(n_local==known_cast<hiopVectorPar&>(grad_d).get_local_size());
 #endif
   
   const double ct=kappa_d*mu;
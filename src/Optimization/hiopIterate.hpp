@@ -51,10 +51,20 @@
 
 #include "hiopVector.hpp"
 #include "hiopNlpFormulation.hpp"
+#include "hiopMemTracker.hpp"
 
 namespace hiop
 {
 
+/**
+ * The primal and dual variables of the IPM. The local parts of the twelve component vectors are
+ * views in one contiguous, 64-byte aligned buffer (from the solver's hiopMemoryPool), laid out as
+ *   [sxl sxu d sdl sdu x | yc yd | zl zu vl vu]
+ * Copying an iterate and taking a primal or dual step are done with one BLAS-1 call per block
+ * instead of one call per component. The components start at aligned offsets, except yc and yd,
+ * which follow x without padding, so that the [x yc yd] part of a search direction can serve
+ * directly as the right-hand side and solution of the compressed KKT systems.
+ */
 class hiopIterate
 {
 public:
@@ -154,6 +164,15 @@ private:
   hiopVector*yd;       //for d(x)-d=0
   hiopVector*zl,*zu;   //for slacks eq. in x: x-sxl=xl, x+sxu=xu
   hiopVector*vl,*vu;   //for slack eq. in d, e.g., d-sdl=dl
+
+  /** Storage of the components (see the class description) */
+  double* buffer_;
+  //offsets of the [yc yd] and [zl zu vl vu] blocks and total size of the buffer, in doubles
+  long long off_duals_eq_, off_duals_bnd_, buffer_size_;
+  //category and tracker (of the creating thread) under which the buffer is recorded
+  hiopMemCategory mem_cat_;
+  hiopMemTracker* mem_tracker_;
+  hiopMemoryPool* pool_;
 private:
   //associated info from problem formulation
   const hiopNlpFormulation * nlp;
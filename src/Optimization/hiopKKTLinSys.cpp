@@ -299,7 +299,8 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
   //dir->d->print();
 
 #ifdef HIOP_DEEPCHECKS
-  errorCompressedLinsys(*rx_tilde_save,*ryc_save,*ryd_tilde_save, *dir->x, *dir->yc, *dir->yd);
+  if(nlp_->log->is_active(hovLinAlgScalars))
+    errorCompressedLinsys(*rx_tilde_save,*ryc_save,*ryd_tilde_save, *dir->x, *dir->yc, *dir->yd);
   delete rx_tilde_save;
   delete ryc_save;
   delete ryd_tilde_save;
@@ -377,8 +378,8 @@ bool hiopKKTLinSysCompressedXYcYd::computeDirections(const hiopResidual* resid,
   assert(dir->vl->matchesPattern(nlp_->get_idl()));
   assert(dir->vu->matchesPattern(nlp_->get_idu()));
 
-  //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  //CHECK THE SOLUTION (the errors are only logged)
+  if(nlp_->log->is_active(hovLinAlgScalars)) errorKKT(resid,dir);
 #endif
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
   nlp_->runStats.tmSolverInternal.stop();
@@ -622,8 +623,8 @@ bool hiopKKTLinSysCompressedXDYcYd::computeDirections(const hiopResidual* resid,
   assert(dir->vl->matchesPattern(nlp_->get_idl()));
   assert(dir->vu->matchesPattern(nlp_->get_idu()));
 
-  //CHECK THE SOLUTION
-  errorKKT(resid,dir);
+  //CHECK THE SOLUTION (the errors are only logged)
+  if(nlp_->log->is_active(hovLinAlgScalars)) errorKKT(resid,dir);
 #endif
   nlp_->runStats.kkt.tmSolveRhsManip.stop();
   nlp_->runStats.tmSolverInternal.stop();
@@ -727,6 +728,7 @@ update(const hiopIterate* iter,
        hiopHessianLowRank* Hess)
 {
   nlp_->runStats.tmSolverInternal.start();
+  nlp_->runStats.kkt.tmUpdateInit.start();
 
   iter_=iter;
   grad_f_ = dynamic_cast<const hiopVector*>(grad_f);
@@ -752,6 +754,7 @@ update(const hiopIterate* iter,
 #endif 
   Dd_inv_->invert();
 
+  nlp_->runStats.kkt.tmUpdateInit.stop();
   nlp_->runStats.tmSolverInternal.stop();
 
   nlp_->log->write("Dd_inv in KKT", *Dd_inv_, hovMatrices);
@@ -786,6 +789,7 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   assert(Dd_inv_->isfinite_local() && "Something bad happened: nan or inf value");
 #endif
 
+  nlp_->runStats.kkt.tmUpdateLinsys.start();
   hiopMatrixDense& J = *_kxn_mat;
   const hiopMatrixDense* Jac_c_de = dynamic_cast<const hiopMatrixDense*>(Jac_c_); assert(Jac_c_de);
   const hiopMatrixDense* Jac_d_de = dynamic_cast<const hiopMatrixDense*>(Jac_d_); assert(Jac_d_de);
@@ -798,6 +802,7 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 
   //subdiag of N += 1., Dd_inv
   N->addSubDiagonal(1., nlp_->m_eq(), *Dd_inv_);
+  nlp_->runStats.kkt.tmUpdateLinsys.stop();
 #ifdef HIOP_DEEPCHECKS
   assert(J.isfinite());
   nlp_->log->write("solveCompressed: N is", *N, hovMatrices);
@@ -816,9 +821,14 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   
   // 2 . then rhs =   [ Jc(H+Dx)^{-1}*rx - ryc ]
   //                  [ Jd(H+dx)^{-1}*rx - ryd ]
-  hiopVector& rhs=*_k_vec1;
-  rhs.copyFromStarting(0, ryc);
-  rhs.copyFromStarting(nlp_->m_eq(), ryd);
+  //when dyc and dyd are adjacent in memory, the system is formed and solved in place in [dyc dyd]
+  const bool in_place = are_adjacent(dyc, dyd);
+  hiopVectorPar dyc_dyd_view(dyc.local_data(), in_place ? dyc.get_size()+dyd.get_size() : 0);
+  hiopVector& rhs = in_place ? dyc_dyd_view : *_k_vec1;
+  hiopVectorPar rhs_yc(rhs.local_data(), nlp_->m_eq());
+  hiopVectorPar rhs_yd(rhs.local_data()+nlp_->m_eq(), nlp_->m_ineq());
+  rhs_yc.copyFrom(ryc);
+  rhs_yd.copyFrom(ryd);
   J.timesVec(-1.0, rhs, 1.0, dx);
 
 #ifdef HIOP_DEEPCHECKS
@@ -831,12 +841,18 @@ solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
   //
   //solve N * dyc_dyd = rhs
   //
+  //the (Cholesky) factorization of N is done by the solve
+  nlp_->runStats.kkt.tmUpdateInnerFact.start();
   int ierr = solveWithRefin(*N,rhs);
   //int ierr = solve(*N,rhs);
+  nlp_->runStats.kkt.tmUpdateInnerFact.stop();
+  nlp_->runStats.kkt.flopsUpdateInnerFact += N->m()*(double)N->m()*N->m()/3.;
 
   hiopVector& dyc_dyd= rhs;
-  dyc_dyd.copyToStarting(0,           dyc);
-  dyc_dyd.copyToStarting(nlp_->m_eq(), dyd);
+  if(!in_place) {
+    dyc.copyFrom(rhs_yc);
+    dyd.copyFrom(rhs_yd);
+  }
 
   //now solve for dx = - (H+Dx)^{-1}*(Jc^T*dyc+Jd^T*dyd - rx)
   //first rx = -(Jc^T*dyc+Jd^T*dyd - rx)
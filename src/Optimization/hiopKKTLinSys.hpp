@@ -67,6 +67,7 @@ public:
       perturb_calc_(NULL), safe_mode_(true)
   { 
     perf_report_ = "on"==hiop::tolower(nlp_->options->GetString("time_kkt"));
+    write_kkt_ = nlp_->options->GetStringHandle("write_kkt");
   }
   virtual ~hiopKKTLinSys() 
   { }
@@ -91,6 +92,10 @@ public:
   {
     safe_mode_ = val;
   }
+
+  /* dimension of the linear system factorized by the underlying linear solver or -1 if the 
+   * system was not formed yet or the dimension is not available */
+  virtual long long get_linsys_size() { return -1; }
 #ifdef HIOP_DEEPCHECKS
   //computes the solve error for the KKT Linear system; used only for correctness checking
   virtual double errorKKT(const hiopResidual* resid, const hiopIterate* sol);
@@ -110,6 +115,17 @@ protected:
 
 
 #endif
+protected:
+  /** 
+   * True when the local elements of 'v2' directly follow those of the non-distributed vector 'v1'
+   * in memory, as for the [x yc yd] components of hiopIterate, in which case the two vectors can be 
+   * viewed as one (see hiopVectorPar(double*, n)) and the compressed systems are solved in place.
+   */
+  static inline bool are_adjacent(const hiopVector& v1, const hiopVector& v2)
+  {
+    return v1.get_local_size()==v1.get_size() && 
+      v1.local_data_const()+v1.get_local_size()==v2.local_data_const();
+  }
 protected:
   hiopNlpFormulation* nlp_;
   const hiopIterate* iter_;
@@ -119,6 +135,8 @@ protected:
   hiopPDPerturbation* perturb_calc_;
   bool perf_report_;
   bool safe_mode_;
+  //option 'write_kkt', read at each update of the linear system
+  hiopOptions::Handle<std::string> write_kkt_;
 };
 
 class hiopKKTLinSysCompressed : public hiopKKTLinSys
@@ -277,6 +295,9 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
 
+  //the kxk reduced matrix N is factorized
+  virtual long long get_linsys_size() { return N ? N->m() : -1; }
+
   //LAPACK wrappers
   int solve(hiopMatrixDense& M, hiopVector& rhs);
   int solveWithRefin(hiopMatrixDense& M, hiopVector& rhs);
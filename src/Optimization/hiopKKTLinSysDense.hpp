@@ -58,6 +58,7 @@
 #endif
 
 #include "hiopCSR_IO.hpp"
+#include "hiopKKTCapture.hpp"
 
 namespace hiop
 {
@@ -75,7 +76,7 @@ class hiopKKTLinSysDenseXYcYd : public hiopKKTLinSysCompressedXYcYd
 public:
   hiopKKTLinSysDenseXYcYd(hiopNlpFormulation* nlp)
     : hiopKKTLinSysCompressedXYcYd(nlp), linSys(NULL), rhsXYcYd(NULL), 
-      write_linsys_counter(-1), csr_writer(nlp)
+      write_linsys_counter(-1), csr_writer(nlp), kkt_capture_(nlp)
   {
   }
   virtual ~hiopKKTLinSysDenseXYcYd()
@@ -84,6 +85,8 @@ public:
     delete rhsXYcYd;
   }
 
+  virtual long long get_linsys_size() { return linSys ? linSys->sysMatrix().m() : -1; }
+
   /* updates the parts in KKT system that are dependent on the iterate. 
    * Triggers a refactorization for the dense linear system */
 
@@ -106,6 +109,13 @@ public:
     
     if(NULL==linSys) {
       int n=Jac_c_->m() + Jac_d_->m() + Hess_->m();
+      //the allocation is not done if it would exceed the memory limit (option 'mem_limit')
+      //(the system matrix holds only the upper triangle with the option 'kkt_dense_storage packed')
+      const long long n_elems = nlp_->options->GetString("kkt_dense_storage")=="packed" ?
+	hiopMatrixSymDensePacked::packed_size(n) : (long long)n*n;
+      if(!hiopMemTracker::global().fits(n_elems*sizeof(double))) return false;
+      //NUMA placement of the system matrix (option 'mem_kkt_interleave')
+      hiopMemInterleaveScope interleave(nlp_->options->GetString("mem_kkt_interleave")=="yes");
 
       if(nlp_->options->GetString("compute_mode")=="hybrid") {
 #ifdef HIOP_USE_MAGMA
@@ -129,9 +139,11 @@ public:
 
     //compute and put the barrier diagonals in
     //Dx=(Sxl)^{-1}Zl + (Sxu)^{-1}Zu
+    nlp_->runStats.kkt.tmUpdateInit.start();
     Dx_->setToZero();
     Dx_->axdzpy_w_pattern(1.0, *iter_->zl, *iter_->sxl, nlp_->get_ixl());
     Dx_->axdzpy_w_pattern(1.0, *iter_->zu, *iter_->sxu, nlp_->get_ixu());
+    nlp_->runStats.kkt.tmUpdateInit.stop();
     nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
     
     // Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu is computed in the IC loop since we need to
@@ -163,6 +175,7 @@ public:
       //
       // update linSys system matrix, including IC perturbations
       //
+      nlp_->runStats.kkt.tmUpdateLinsys.start();
       Msys.setToZero();
       
       int alpha = 1.;
@@ -190,15 +203,23 @@ public:
       //Msys.addSubDiagonal(nx+nineq, neq, -delta_cc);
       //Msys.addSubDiagonal(nx+nineq+neq, nineq, -delta_cd);
       Msys.addSubDiagonal(nx, neq+nineq, -delta_cd);
+      nlp_->runStats.kkt.tmUpdateLinsys.stop();
 
       nlp_->log->write("KKT Linsys:", Msys, hovMatrices);
 
       //write matrix to file if requested
-      if(nlp_->options->GetString("write_kkt") == "yes") write_linsys_counter++;
+      if(*write_kkt_ == "yes") write_linsys_counter++;
       if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
+      if(kkt_capture_.is_on()) 
+	kkt_capture_.write_matrix(nlp_->runStats.nIter, Msys, delta_wx, delta_wd, delta_cc, delta_cd);
 
+      nlp_->runStats.kkt.tmUpdateInnerFact.start();
       int n_neg_eig = linSys->matrixChanged();
-      
+      nlp_->runStats.kkt.tmUpdateInnerFact.stop();
+      //LDL^T factorization
+      nlp_->runStats.kkt.flopsUpdateInnerFact += Msys.m()*(double)Msys.m()*Msys.m()/3.;
+      if(kkt_capture_.is_on()) kkt_capture_.write_inertia(n_neg_eig, Jac_c_->m()+Jac_d_->m());
+
       if(Jac_c_->m()+Jac_d_->m()>0) {
 	if(n_neg_eig < 0) {
 	  //matrix singular
@@ -239,6 +260,7 @@ public:
    
       //will do an inertia correction
       num_ic_cor++;
+      nlp_->runStats.kkt.nUpdateICCorr++;
     } // end of IC loop
 
     if(num_ic_cor>max_ic_cor) {
@@ -257,28 +279,39 @@ public:
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd)
   {
     int nx=rx.get_size(), nyc=ryc.get_size(), nyd=ryd.get_size();
-    if(rhsXYcYd == NULL) rhsXYcYd = LinearAlgebraFactory::createVector(nx+nyc+nyd);
+    //when [dx dyc dyd] are adjacent in memory, the system is solved in place in the directions
+    const bool in_place = are_adjacent(dx, dyc) && are_adjacent(dyc, dyd);
+    if(!in_place && rhsXYcYd == NULL) rhsXYcYd = LinearAlgebraFactory::createVector(nx+nyc+nyd);
+    hiopVectorPar dx_dyc_dyd(dx.local_data(), in_place ? nx+nyc+nyd : 0);
+    hiopVector& rhs = in_place ? dx_dyc_dyd : *rhsXYcYd;
 
     nlp_->log->write("RHS KKT XDycYd rx: ", rx,  hovIteration);
     nlp_->log->write("RHS KKT XDycYd ryc:", ryc, hovIteration);
     nlp_->log->write("RHS KKT XDycYd ryd:", ryd, hovIteration);
 
-    rx. copyToStarting(*rhsXYcYd, 0);
-    ryc.copyToStarting(*rhsXYcYd, nx);
-    ryd.copyToStarting(*rhsXYcYd, nx+nyc);
+    rx. copyToStarting(rhs, 0);
+    ryc.copyToStarting(rhs, nx);
+    ryd.copyToStarting(rhs, nx+nyc);
 
-    if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXYcYd, write_linsys_counter);
+    if(write_linsys_counter>=0) csr_writer.writeRhsToFile(rhs, write_linsys_counter);
+    if(kkt_capture_.is_on()) kkt_capture_.write_rhs(rhs);
 
     //! todo: iterative refinement
-    bool sol_ok = linSys->solve(*rhsXYcYd);
+    nlp_->runStats.kkt.tmSolveTriangular.start();
+    bool sol_ok = linSys->solve(rhs);
+    nlp_->runStats.kkt.tmSolveTriangular.stop();
+    nlp_->runStats.kkt.flopsSolveTriangular += 2.*rhs.get_size()*rhs.get_size();
 
-    if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhsXYcYd, write_linsys_counter);
+    if(write_linsys_counter>=0) csr_writer.writeSolToFile(rhs, write_linsys_counter);
+    if(kkt_capture_.is_on()) kkt_capture_.write_sol(rhs);
 
     if(false==sol_ok) return false;
 
-    rhsXYcYd->copyToStarting(0,      dx);
-    rhsXYcYd->copyToStarting(nx,     dyc);
-    rhsXYcYd->copyToStarting(nx+nyc, dyd);
+    if(!in_place) {
+      rhs.copyToStarting(0,      dx);
+      rhs.copyToStarting(nx,     dyc);
+      rhs.copyToStarting(nx+nyc, dyd);
+    }
 
     nlp_->log->write("SOL KKT XYcYd dx: ", dx,  hovMatrices);
     nlp_->log->write("SOL KKT XYcYd dyc:", dyc, hovMatrices);
@@ -295,10 +328,12 @@ protected:
    */
   int write_linsys_counter; 
   hiopCSR_IO csr_writer;
+  //binary capture of the systems, activated by write_kkt 'binary'
+  hiopKKTCapture kkt_capture_;
 private:
   hiopKKTLinSysDenseXYcYd() 
     :  hiopKKTLinSysCompressedXYcYd(NULL), linSys(NULL), 
-       write_linsys_counter(-1), csr_writer(NULL)
+       write_linsys_counter(-1), csr_writer(NULL), kkt_capture_(NULL)
   { 
     assert(false); 
   }
@@ -310,7 +345,7 @@ class hiopKKTLinSysDenseXDYcYd : public hiopKKTLinSysCompressedXDYcYd
 public:
   hiopKKTLinSysDenseXDYcYd(hiopNlpFormulation* nlp)
     : hiopKKTLinSysCompressedXDYcYd(nlp), linSys(NULL), rhsXDYcYd(NULL),
-      write_linsys_counter(-1), csr_writer(nlp)
+      write_linsys_counter(-1), csr_writer(nlp), kkt_capture_(nlp)
   {
   }
   virtual ~hiopKKTLinSysDenseXDYcYd()
@@ -319,6 +354,8 @@ public:
     delete rhsXDYcYd;
   }
 
+  virtual long long get_linsys_size() { return linSys ? linSys->sysMatrix().m() : -1; }
+
   /* Updates the parts in KKT system that are dependent on the iterate. 
    * Triggers a refactorization for the dense linear system 
    * Forms the linear system
@@ -345,6 +382,13 @@ public:
     
     if(NULL==linSys) {
       int n=nx+neq+2*nineq;
+      //the allocation is not done if it would exceed the memory limit (option 'mem_limit')
+      //(the system matrix holds only the upper triangle with the option 'kkt_dense_storage packed')
+      const long long n_elems = nlp_->options->GetString("kkt_dense_storage")=="packed" ?
+	hiopMatrixSymDensePacked::packed_size(n) : (long long)n*n;
+      if(!hiopMemTracker::global().fits(n_elems*sizeof(double))) return false;
+      //NUMA placement of the system matrix (option 'mem_kkt_interleave')
+      hiopMemInterleaveScope interleave(nlp_->options->GetString("mem_kkt_interleave")=="yes");
 
       if(nlp_->options->GetString("compute_mode")=="hybrid") {
 #ifdef HIOP_USE_MAGMA
@@ -364,15 +408,17 @@ public:
     //compute barrier diagonals (these change only between outer optimiz iterations) 
     //
     // Dx=(Sxl)^{-1}Zl + (Sxu)^{-1}Zu
+    nlp_->runStats.kkt.tmUpdateInit.start();
     Dx_->setToZero();
     Dx_->axdzpy_w_pattern(1.0, *iter_->zl, *iter_->sxl, nlp_->get_ixl());
     Dx_->axdzpy_w_pattern(1.0, *iter_->zu, *iter_->sxu, nlp_->get_ixu());
-    nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
 
     // Dd=(Sdl)^{-1}Vu + (Sdu)^{-1}Vu
     Dd_->setToZero();
     Dd_->axdzpy_w_pattern(1.0, *iter_->vl, *iter_->sdl, nlp_->get_idl());
     Dd_->axdzpy_w_pattern(1.0, *iter_->vu, *iter_->sdu, nlp_->get_idu());
+    nlp_->runStats.kkt.tmUpdateInit.stop();
+    nlp_->log->write("Dx in KKT", *Dx_, hovMatrices);
     nlp_->log->write("Dd in KKT", *Dd_, hovMatrices);
 #ifdef HIOP_DEEPCHECKS
     assert(true==Dd_->allPositive());
@@ -405,6 +451,7 @@ public:
       // update linSys system matrix, including IC perturbations
       //
       {
+	nlp_->runStats.kkt.tmUpdateLinsys.start();
 	Msys.setToZero();
       
 	const int alpha = 1.;
@@ -431,18 +478,25 @@ public:
 	//Msys.addSubDiagonal(nx+nineq, neq, -delta_cc);
 	//Msys.addSubDiagonal(nx+nineq+neq, nineq, -delta_cd);
 	Msys.addSubDiagonal(nx+nineq, neq+nineq, -delta_cd);
-
+	nlp_->runStats.kkt.tmUpdateLinsys.stop();
       } // end of update linSys system matrix
 
       //write matrix to file if requested
-      if(nlp_->options->GetString("write_kkt") == "yes") write_linsys_counter++;
+      if(*write_kkt_ == "yes") write_linsys_counter++;
       if(write_linsys_counter>=0) csr_writer.writeMatToFile(Msys, write_linsys_counter); 
+      if(kkt_capture_.is_on()) 
+	kkt_capture_.write_matrix(nlp_->runStats.nIter, Msys, delta_wx, delta_wd, delta_cc, delta_cd);
 
       nlp_->log->write("KKT XDYcYd Linsys (to be factorized):", Msys, hovMatrices);
       
       //factorize the matrix (note: 'matrixChanged' returns -1 if null eigenvalues are detected)
+      nlp_->runStats.kkt.tmUpdateInnerFact.start();
       int n_neg_eig = linSys->matrixChanged();
-      
+      nlp_->runStats.kkt.tmUpdateInnerFact.stop();
+      //LDL^T factorization
+      nlp_->runStats.kkt.flopsUpdateInnerFact += Msys.m()*(double)Msys.m()*Msys.m()/3.;
+      if(kkt_capture_.is_on()) kkt_capture_.write_inertia(n_neg_eig, Jac_c_->m()+Jac_d_->m());
+
       if(Jac_c_->m()+Jac_d_->m()>0) {
 	if(n_neg_eig < 0) {
 	  //matrix singular
@@ -484,6 +538,7 @@ public:
    
       //will do an inertia correction
       num_ic_cor++;
+      nlp_->runStats.kkt.nUpdateICCorr++;
     }
     
     if(num_ic_cor>max_ic_cor) {
@@ -515,10 +570,15 @@ public:
     ryd.copyToStarting(*rhsXDYcYd, nx+nyd+nyc);
 
     if(write_linsys_counter>=0) csr_writer.writeRhsToFile(*rhsXDYcYd, write_linsys_counter);
+    if(kkt_capture_.is_on()) kkt_capture_.write_rhs(*rhsXDYcYd);
 
+    nlp_->runStats.kkt.tmSolveTriangular.start();
     bool sol_ok = linSys->solve(*rhsXDYcYd);
+    nlp_->runStats.kkt.tmSolveTriangular.stop();
+    nlp_->runStats.kkt.flopsSolveTriangular += 2.*rhsXDYcYd->get_size()*rhsXDYcYd->get_size();
 
     if(write_linsys_counter>=0) csr_writer.writeSolToFile(*rhsXDYcYd, write_linsys_counter);
+    if(kkt_capture_.is_on()) kkt_capture_.write_sol(*rhsXDYcYd);
 
     if(false==sol_ok) return false;
 
@@ -541,10 +601,12 @@ protected:
   //depends on the 'write_kkt' option
   int write_linsys_counter; 
   hiopCSR_IO csr_writer;
+  //binary capture of the systems, activated by write_kkt 'binary'
+  hiopKKTCapture kkt_capture_;
 private:
   hiopKKTLinSysDenseXDYcYd() 
     : hiopKKTLinSysCompressedXDYcYd(NULL), linSys(NULL), 
-      write_linsys_counter(-1), csr_writer(NULL)
+      write_linsys_counter(-1), csr_writer(NULL), kkt_capture_(NULL)
   { 
     assert(false && "not intended to be used"); 
   }
@@ -59,7 +59,7 @@ namespace hiop
   hiopKKTLinSysCompressedMDSXYcYd::hiopKKTLinSysCompressedMDSXYcYd(hiopNlpFormulation* nlp)
     : hiopKKTLinSysCompressedXYcYd(nlp), linSys_(NULL), rhs_(NULL), _buff_xs_(NULL),
       Hxs_(NULL), HessMDS_(NULL), Jac_cMDS_(NULL), Jac_dMDS_(NULL),
-      write_linsys_counter_(-1), csr_writer_(nlp)
+      write_linsys_counter_(-1), csr_writer_(nlp), kkt_capture_(nlp)
   {
     nlpMDS_ = dynamic_cast<hiopNlpMDS*>(nlp_);
     assert(nlpMDS_);
@@ -107,7 +107,19 @@ namespace hiop
     //
     //based on safe_mode_, decide whether to go with the nopiv (fast) or Bunch-Kaufman (stable) linear solve 
     //
-    linSys_ = determineAndCreateLinsys(nxd, neq, nineq);
+    //the dense system is not allocated if it would exceed the memory limit (option 'mem_limit')
+    if(NULL==linSys_) {
+      const long long n_linsys = nxd+neq+nineq;
+      //(the system matrix holds only the upper triangle with the option 'kkt_dense_storage packed')
+      const long long n_elems = nlp_->options->GetString("kkt_dense_storage")=="packed" ?
+	hiopMatrixSymDensePacked::packed_size(n_linsys) : n_linsys*n_linsys;
+      if(!hiopMemTracker::global().fits(n_elems*(long long)sizeof(double))) return false;
+    }
+    {
+      //NUMA placement of the system matrix (option 'mem_kkt_interleave')
+      hiopMemInterleaveScope interleave(nlp_->options->GetString("mem_kkt_interleave")=="yes");
+      linSys_ = determineAndCreateLinsys(nxd, neq, nineq);
+    }
 
     //
     //update/compute KKT
@@ -255,14 +267,18 @@ namespace hiop
       nlp_->runStats.kkt.tmUpdateLinsys.stop();
       
       //write matrix to file if requested
-      if(nlp_->options->GetString("write_kkt") == "yes") write_linsys_counter_++;
+      if(*write_kkt_ == "yes") write_linsys_counter_++;
       if(write_linsys_counter_>=0) csr_writer_.writeMatToFile(Msys, write_linsys_counter_); 
+      if(kkt_capture_.is_on()) 
+	kkt_capture_.write_matrix(nlp_->runStats.nIter, Msys, delta_wx, delta_wd, delta_cc, delta_cd);
       
 
       nlp_->runStats.linsolv.start_linsolve();
       nlp_->runStats.kkt.tmUpdateInnerFact.start();
       //factorization
       int n_neg_eig = linSys_->matrixChanged();
+      //the inertia of the reduced system is captured, before accounting for the sparse block
+      if(kkt_capture_.is_on()) kkt_capture_.write_inertia(n_neg_eig, neq+nineq);
 
       int n_neg_eig_11 = 0;
       if(n_neg_eig>=0) {
@@ -282,6 +298,8 @@ namespace hiop
 	}
       }
       nlp_->runStats.kkt.tmUpdateInnerFact.stop();
+      //LDL^T factorization of the dense (reduced) system
+      nlp_->runStats.kkt.flopsUpdateInnerFact += Msys.m()*(double)Msys.m()*Msys.m()/3.;
 
       if(n_neg_eig_11 < 0) {
 	nlp_->log->printf(hovScalars, 
@@ -374,8 +392,19 @@ namespace hiop
     int nxsp=Hxs_->get_size(); assert(nxsp<=nx);
     int nxde = nlpMDS_->nx_de();
     assert(nxsp+nxde==nx);
-    if(rhs_ == NULL) rhs_ = LinearAlgebraFactory::createVector(nxde+nyc+nyd);
+    //when [dx dyc dyd] are adjacent in memory, the system is solved in place in [dx_dense dyc dyd]
+    const bool in_place = are_adjacent(dx, dyc) && are_adjacent(dyc, dyd);
+    if(!in_place && rhs_ == NULL) rhs_ = LinearAlgebraFactory::createVector(nxde+nyc+nyd);
     if(_buff_xs_==NULL) _buff_xs_ = LinearAlgebraFactory::createVector(nxsp);
+    hiopVectorPar dxde_dyc_dyd(dx.local_data()+nxsp, in_place ? nxde+nyc+nyd : 0);
+    hiopVector& rhs = in_place ? dxde_dyc_dyd : *rhs_;
+    //views of the [rxdense, ryc, ryd] blocks of rhs and of the sparse and dense blocks of rx and dx
+    hiopVectorPar rhs_xde(rhs.local_data(), nxde);
+    hiopVectorPar rhs_yc(rhs.local_data()+nxde, nyc);
+    hiopVectorPar rhs_yd(rhs.local_data()+nxde+nyc, nyd);
+    hiopVectorPar rx_sp(rx.local_data(), nxsp);
+    hiopVectorPar rx_de(rx.local_data()+nxsp, nxde);
+    hiopVectorPar dx_sp(dx.local_data(), nxsp);
 
     nlp_->log->write("RHS KKT_MDS_XYcYd rx: ", rx,  hovIteration);
     nlp_->log->write("RHS KKT_MDS_XYcYd ryc:", ryc, hovIteration);
@@ -383,30 +412,26 @@ namespace hiop
 
     hiopVector& rxs = *_buff_xs_;
     //rxs = Hxs^{-1} * rx_sparse 
-    rx.startingAtCopyToStartingAt(0, rxs, 0, nxsp);
+    rxs.copyFrom(rx_sp);
     rxs.componentDiv(*Hxs_);
 
-    //ryc = ryc - Jac_c_sp * Hxs^{-1} * rxs
-    //use dyc as working buffer to avoid altering ryc, which refers directly in the hiopResidual class
-    assert(dyc.get_size()==ryc.get_size());
-    dyc.copyFrom(ryc);
-    Jac_cMDS_->sp_mat()->timesVec(1.0, dyc, -1., rxs);
-
-    //ryd = ryd - Jac_d_sp * Hxs^{-1} * rxs
-    Jac_dMDS_->sp_mat()->timesVec(1.0, ryd, -1., rxs);
-
     //
-    // form the rhs for the MDS linSys
+    // form the rhs for the MDS linSys in place
     //
     //rhs[0:nxde-1] = rx[nxs:(nxsp+nxde-1)]
-    rx.startingAtCopyToStartingAt(nxsp, *rhs_, 0, nxde);
-    //rhs[nxde:nxde+nyc-1] = ryc
-    dyc.copyToStarting(*rhs_, nxde);
-    //ths[nxde+nyc:nxde+nyc+nyd-1] = ryd
-    ryd.copyToStarting(*rhs_, nxde+nyc);
+    rhs_xde.copyFrom(rx_de);
+
+    //rhs[nxde:nxde+nyc-1] = ryc - Jac_c_sp * Hxs^{-1} * rxs
+    rhs_yc.copyFrom(ryc);
+    Jac_cMDS_->sp_mat()->timesVec(1.0, rhs_yc, -1., rxs);
+
+    //rhs[nxde+nyc:nxde+nyc+nyd-1] = ryd - Jac_d_sp * Hxs^{-1} * rxs
+    rhs_yd.copyFrom(ryd);
+    Jac_dMDS_->sp_mat()->timesVec(1.0, rhs_yd, -1., rxs);
 
     if(write_linsys_counter_>=0) 
-      csr_writer_.writeRhsToFile(*rhs_, write_linsys_counter_);
+      csr_writer_.writeRhsToFile(rhs, write_linsys_counter_);
+    if(kkt_capture_.is_on()) kkt_capture_.write_rhs(rhs);
 
     nlp_->runStats.kkt.tmSolveRhsManip.stop();
 
@@ -414,8 +439,9 @@ namespace hiop
     //
     // solve
     //
-    bool linsol_ok = linSys_->solve(*rhs_);
+    bool linsol_ok = linSys_->solve(rhs);
     nlp_->runStats.kkt.tmSolveTriangular.stop();
+    nlp_->runStats.kkt.flopsSolveTriangular += 2.*rhs.get_size()*rhs.get_size();
     nlp_->runStats.linsolv.end_linsolve();
 
     if(perf_report_) {
@@ -424,7 +450,8 @@ namespace hiop
     }
     
     if(write_linsys_counter_>=0) 
-      csr_writer_.writeSolToFile(*rhs_, write_linsys_counter_);
+      csr_writer_.writeSolToFile(rhs, write_linsys_counter_);
+    if(kkt_capture_.is_on()) kkt_capture_.write_sol(rhs);
 
     if(false==linsol_ok) return false;
 
@@ -433,21 +460,20 @@ namespace hiop
     //
     // unpack 
     //
-    rhs_->startingAtCopyToStartingAt(0,        dx,  nxsp, nxde);
-    rhs_->startingAtCopyToStartingAt(nxde,     dyc, 0);   
-    rhs_->startingAtCopyToStartingAt(nxde+nyc, dyd, 0);
+    if(!in_place) {
+      rhs_xde.startingAtCopyToStartingAt(0, dx, nxsp);
+      dyc.copyFrom(rhs_yc);
+      dyd.copyFrom(rhs_yd);
+    }
 
     //
-    // compute dxs
+    // compute dxs in place in dx
     //
-    hiopVector& dxs = *_buff_xs_;
     // dxs = (Hxs)^{-1} ( rxs - Jac_c_sp^T dyc - Jac_d_sp^T dyd)
-    rx.startingAtCopyToStartingAt(0, dxs, 0, nxsp);
-    Jac_cMDS_->sp_mat()->transTimesVec(1., dxs, -1., dyc);
-    Jac_dMDS_->sp_mat()->transTimesVec(1., dxs, -1., dyd);
-    dxs.componentDiv(*Hxs_);
-    //copy to dx
-    dxs.startingAtCopyToStartingAt(0, dx, 0);
+    dx_sp.copyFrom(rx_sp);
+    Jac_cMDS_->sp_mat()->transTimesVec(1., dx_sp, -1., dyc);
+    Jac_dMDS_->sp_mat()->transTimesVec(1., dx_sp, -1., dyd);
+    dx_sp.componentDiv(*Hxs_);
 
     nlp_->log->write("SOL KKT_MDS_XYcYd dx: ", dx,  hovMatrices);
     nlp_->log->write("SOL KKT_MDS_XYcYd dyc:", dyc, hovMatrices);
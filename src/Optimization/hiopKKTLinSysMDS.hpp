@@ -53,6 +53,7 @@
 #include "hiopLinSolver.hpp"
 
 #include "hiopCSR_IO.hpp"
+#include "hiopKKTCapture.hpp"
 
 namespace hiop
 {
@@ -108,6 +109,9 @@ public:
   virtual bool solveCompressed(hiopVector& rx, hiopVector& ryc, hiopVector& ryd,
 			       hiopVector& dx, hiopVector& dyc, hiopVector& dyd);
 
+  //the reduced (dense) system in dxd, dyc, and dyd is factorized
+  virtual long long get_linsys_size() { return linSys_ ? linSys_->sysMatrix().m() : -1; }
+
 protected:
   hiopLinSolverIndefDense* linSys_;
   hiopVector *rhs_; //[rxdense, ryc, ryd]
@@ -136,6 +140,8 @@ protected:
   // 'solveCompressed' is called; activated by the 'write_kkt' option
   int write_linsys_counter_; 
   hiopCSR_IO csr_writer_;
+  //binary capture of the (reduced) dense systems, activated by write_kkt 'binary'
+  hiopKKTCapture kkt_capture_;
 
 private:
   //placeholder for the code that decides which linear solver to used based on safe_mode_
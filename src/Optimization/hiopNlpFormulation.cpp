@@ -61,10 +61,17 @@
 #include <stdlib.h>     /* exit, EXIT_FAILURE */
 
 #include <cassert>
+#include <cstring>
+#include <mutex>
 namespace hiop
 {
 
-hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
+#ifdef HIOP_USE_MPI
+//serializes the check-and-initialize of MPI by NLPs created concurrently on different threads
+static std::mutex mpi_init_mutex;
+#endif
+
+hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_, const char* options_file/*=NULL*/)
 #ifdef HIOP_USE_MPI
   : mpi_init_called(false), interface_base(interface_)
 #else 
@@ -78,14 +85,24 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   bret = interface_base.get_MPI_comm(comm); assert(bret);
 
   int nret;
-  //MPI may not be initialized: this occurs when a serial driver call HiOp built with MPI support on
-  int initialized;
-  nret = MPI_Initialized( &initialized );
-  if(!initialized) {
-    mpi_init_called=true;
-    nret = MPI_Init(NULL,NULL);
-    assert(MPI_SUCCESS==nret);
-  } 
+  //MPI may not be initialized: this occurs when a serial driver call HiOp built with MPI support on;
+  //MPI is then initialized with full thread support since the driver may run solves on threads
+  {
+    std::lock_guard<std::mutex> lock(mpi_init_mutex);
+    int initialized;
+    nret = MPI_Initialized( &initialized );
+    if(!initialized) {
+      mpi_init_called=true;
+      int provided;
+      nret = MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided);
+      assert(MPI_SUCCESS==nret);
+      if(provided < MPI_THREAD_MULTIPLE) {
+	hiopLogger::printf_error(hovWarning, "MPI does not support MPI_THREAD_MULTIPLE (provided "
+				 "thread level %d); solves should not run concurrently on different "
+				 "threads of this process.\n", provided);
+      }
+    }
+  }
   
   nret=MPI_Comm_rank(comm, &rank); assert(MPI_SUCCESS==nret);
   nret=MPI_Comm_size(comm, &num_ranks); assert(MPI_SUCCESS==nret);
@@ -94,7 +111,7 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   MPI_Comm comm = MPI_COMM_SELF;
 #endif
 
-  options = new hiopOptions(/*filename=NULL*/);
+  options = new hiopOptions(options_file);
 
   hiopOutVerbosity hov = (hiopOutVerbosity) options->GetInteger("verbosity_level");
   log = new hiopLogger(this, stdout);
@@ -118,6 +135,7 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   cons_ineq_type=NULL;
   cons_eq_mapping_=NULL;
   cons_ineq_mapping_=NULL;
+  cons_grouped_=true;
   idl=NULL;
   idu=NULL;
 #ifdef HIOP_USE_MPI
@@ -126,7 +144,15 @@ hiopNlpFormulation::hiopNlpFormulation(hiopInterfaceBase& interface_)
   cons_eval_type_ = -1;
   cons_body_ = NULL;
   cons_Jac_ = NULL;
+  f_grad_eval_type_ = -1;
+  cons_Jac_eval_type_ = -1;
   cons_lambdas_ = NULL;
+  jac_lin_cache_ = false;
+  n_cons_eq_nl_ = n_cons_ineq_nl_ = 0;
+  cons_eq_nl_idx_ = cons_ineq_nl_idx_ = NULL;
+  cons_eq_nl_mapping_ = cons_ineq_nl_mapping_ = NULL;
+  Jac_c_lin_cached_ = Jac_d_lin_cached_ = NULL;
+  Jac_c_nl_buf_ = Jac_d_nl_buf_ = NULL;
 }
 
 hiopNlpFormulation::~hiopNlpFormulation()
@@ -163,6 +189,13 @@ hiopNlpFormulation::~hiopNlpFormulation()
   delete[] cons_body_;
   delete cons_Jac_;
   delete[] cons_lambdas_;
+
+  delete[] cons_eq_nl_idx_;
+  delete[] cons_ineq_nl_idx_;
+  delete[] cons_eq_nl_mapping_;
+  delete[] cons_ineq_nl_mapping_;
+  delete Jac_c_nl_buf_;
+  delete Jac_d_nl_buf_;
 }
 
 bool hiopNlpFormulation::finalizeInitialization()
@@ -178,6 +211,8 @@ bool hiopNlpFormulation::finalizeInitialization()
   }
   //more tests here (for example change in the rescaling)
   if(!doinit) {
+    //the user may have changed the problem or the options since the last solve
+    setup_linear_jac_caching();
     return true;
   } else {
     
@@ -268,7 +303,7 @@ bool hiopNlpFormulation::finalizeInitialization()
   
   long long nfixed_vars=nfixed_vars_local;
 #ifdef HIOP_USE_MPI
-  int ierr = MPI_Allreduce(&nfixed_vars_local, &nfixed_vars, 1, MPI_LONG_LONG, MPI_SUM, comm); 
+  int ierr = hiopAllreduce(&nfixed_vars_local, &nfixed_vars, 1, MPI_LONG_LONG, MPI_SUM, comm, "nlp_fixed_vars"); 
   assert(MPI_SUCCESS==ierr);
 #endif
   hiopFixedVarsRemover* fixedVarsRemover = NULL;
@@ -405,6 +440,12 @@ bool hiopNlpFormulation::finalizeInitialization()
     }
   }
   assert(it_eq==n_cons_eq); assert(it_ineq==n_cons_ineq);
+  //the mappings are increasing, so they are the identity when the last equality is n_cons_eq-1
+  cons_grouped_ = (0==n_cons_eq || cons_eq_mapping_[n_cons_eq-1]==n_cons_eq-1);
+  if(n_cons_eq>0 && n_cons_ineq>0) {
+    log->printf(hovScalars, "constraints %s grouped as equalities followed by inequalities\n",
+		cons_grouped_ ? "are" : "are not");
+  }
   
   /* delete the temporary buffers */
   delete gl; delete gu; delete[] cons_type;
@@ -437,14 +478,16 @@ bool hiopNlpFormulation::finalizeInitialization()
   //compute the overall n_low and n_upp
 #ifdef HIOP_USE_MPI
   long long aux[3]={n_bnds_low_local, n_bnds_upp_local, n_bnds_lu}, aux_g[3];
-  ierr=MPI_Allreduce(aux, aux_g, 3, MPI_LONG_LONG, MPI_SUM, comm); assert(MPI_SUCCESS==ierr);
+  ierr=hiopAllreduce(aux, aux_g, 3, MPI_LONG_LONG, MPI_SUM, comm, "nlp_bounds_counts"); assert(MPI_SUCCESS==ierr);
   n_bnds_low=aux_g[0]; n_bnds_upp=aux_g[1]; n_bnds_lu=aux_g[2];
 #else
   n_bnds_low=n_bnds_low_local; n_bnds_upp=n_bnds_upp_local; //n_bnds_lu is ok
 #endif
 
-  //reset/release info and data related to one-call constraints evaluation
+  //reset/release info and data related to one-call and combined evaluations
   cons_eval_type_ = -1;
+  f_grad_eval_type_ = -1;
+  cons_Jac_eval_type_ = -1;
   
   delete[] cons_body_;
   cons_body_ = NULL;
@@ -454,9 +497,85 @@ bool hiopNlpFormulation::finalizeInitialization()
 
   delete[] cons_lambdas_;
   cons_lambdas_ = NULL;
+
+  setup_linear_jac_caching();
   return bret;
 }
 
+void hiopNlpFormulation::setup_linear_jac_caching()
+{
+  //Jacobians evaluated during previous solves are not to be trusted
+  Jac_c_lin_cached_ = Jac_d_lin_cached_ = NULL;
+  
+  delete[] cons_eq_nl_idx_;
+  delete[] cons_ineq_nl_idx_;
+  delete[] cons_eq_nl_mapping_;
+  delete[] cons_ineq_nl_mapping_;
+  cons_eq_nl_idx_ = cons_ineq_nl_idx_ = NULL;
+  cons_eq_nl_mapping_ = cons_ineq_nl_mapping_ = NULL;
+
+  delete Jac_c_nl_buf_;
+  delete Jac_d_nl_buf_;
+  Jac_c_nl_buf_ = Jac_d_nl_buf_ = NULL;
+  
+  n_cons_eq_nl_ = n_cons_eq;
+  n_cons_ineq_nl_ = n_cons_ineq;
+  jac_lin_cache_ = false;
+
+  if(options->GetString("cache_linear_jac") != "yes") {
+    return;
+  }
+  if(nlp_transformations.n_post() != n_vars) {
+    log->printf(hovWarning, "Option 'cache_linear_jac' is not supported when fixed variables are removed "
+		"and will be ignored.\n");
+    return;
+  }
+
+  n_cons_eq_nl_ = n_cons_ineq_nl_ = 0;
+  for(long long i=0; i<n_cons_eq; ++i) 
+    if(cons_eq_type[i] != hiopInterfaceBase::hiopLinear) n_cons_eq_nl_++;
+  for(long long i=0; i<n_cons_ineq; ++i) 
+    if(cons_ineq_type[i] != hiopInterfaceBase::hiopLinear) n_cons_ineq_nl_++;
+
+  cons_eq_nl_idx_       = new long long[n_cons_eq_nl_];
+  cons_eq_nl_mapping_   = new long long[n_cons_eq_nl_];
+  cons_ineq_nl_idx_     = new long long[n_cons_ineq_nl_];
+  cons_ineq_nl_mapping_ = new long long[n_cons_ineq_nl_];
+
+  long long it_nl=0;
+  for(long long i=0; i<n_cons_eq; ++i) {
+    if(cons_eq_type[i] != hiopInterfaceBase::hiopLinear) {
+      cons_eq_nl_idx_[it_nl] = i;
+      cons_eq_nl_mapping_[it_nl] = cons_eq_mapping_[i];
+      it_nl++;
+    }
+  }
+  assert(it_nl == n_cons_eq_nl_);
+  it_nl=0;
+  for(long long i=0; i<n_cons_ineq; ++i) {
+    if(cons_ineq_type[i] != hiopInterfaceBase::hiopLinear) {
+      cons_ineq_nl_idx_[it_nl] = i;
+      cons_ineq_nl_mapping_[it_nl] = cons_ineq_mapping_[i];
+      it_nl++;
+    }
+  }
+  assert(it_nl == n_cons_ineq_nl_);
+
+  jac_lin_cache_ = true;
+  log->printf(hovScalars, "Jacobian rows of %lld (out of %lld) equality and %lld (out of %lld) inequality "
+	      "linear constraints will be evaluated only once.\n", 
+	      n_cons_eq-n_cons_eq_nl_, n_cons_eq, n_cons_ineq-n_cons_ineq_nl_, n_cons_ineq);
+}
+
+void hiopNlpFormulation::disable_linear_jac_caching(const char* how)
+{
+  if(!jac_lin_cache_) return;
+  log->printf(hovWarning, "Option 'cache_linear_jac' is not supported when the constraints and "
+	      "Jacobian are evaluated %s and will be ignored.\n", how);
+  jac_lin_cache_ = false;
+  Jac_c_lin_cached_ = Jac_d_lin_cached_ = NULL;
+}
+
 
 hiopVector* hiopNlpFormulation::alloc_primal_vec() const
 {
@@ -471,6 +590,14 @@ hiopVector* hiopNlpFormulation::alloc_dual_ineq_vec() const
 {
   return dl->alloc_clone();
 }
+hiopVector* hiopNlpFormulation::alloc_cons_body_vecs(hiopVector*& c, hiopVector*& d) const
+{
+  //the constraints bodies are local (see alloc_dual_eq_vec and alloc_dual_ineq_vec)
+  hiopVectorPar* buf = new hiopVectorPar(n_cons_eq+n_cons_ineq);
+  c = new hiopVectorPar(buf->local_data(), n_cons_eq);
+  d = new hiopVectorPar(buf->local_data()+n_cons_eq, n_cons_ineq);
+  return buf;
+}
 hiopVector* hiopNlpFormulation::alloc_dual_vec() const
 {
   hiopVector* ret=LinearAlgebraFactory::createVector(n_cons);
@@ -484,9 +611,9 @@ bool hiopNlpFormulation::eval_f(double* x, bool new_x, double& f)
 {
   double* xx = nlp_transformations.applyTox(x, new_x);
 
-  runStats.tmEvalObj.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_f", runStats.tmEvalObj);
   bool bret = interface_base.eval_f(nlp_transformations.n_post(),xx,new_x,f);
-  runStats.tmEvalObj.stop(); runStats.nEvalObj++;
+  runStats.nEvalObj++;
 
   f = nlp_transformations.applyToObj(f);
   return bret;
@@ -496,25 +623,55 @@ bool hiopNlpFormulation::eval_grad_f(double* x, bool new_x, double* gradf)
   double* xx     = nlp_transformations.applyTox(x, new_x);
   double* gradff = nlp_transformations.applyToGradObj(gradf);
   bool bret; 
-  runStats.tmEvalGrad_f.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_grad_f", runStats.tmEvalGrad_f);
   bret = interface_base.eval_grad_f(nlp_transformations.n_post(),xx,new_x,gradff);
-  runStats.tmEvalGrad_f.stop(); runStats.nEvalGrad_f++;
+  runStats.nEvalGrad_f++;
 
   gradf = nlp_transformations.applyInvToGradObj(gradff);
   return bret;
 }
 
+bool hiopNlpFormulation::eval_f_grad_f(double* x, bool new_x, double& f, double* gradf)
+{
+  if(0 != f_grad_eval_type_) {
+    double* xx     = nlp_transformations.applyTox(x, new_x);
+    double* gradff = nlp_transformations.applyToGradObj(gradf);
+    bool bret;
+    {
+      hiopProfRegion prof_reg(runStats.prof, "eval_f_grad_f", runStats.tmEvalGrad_f);
+      bret = interface_base.eval_f_grad_f(nlp_transformations.n_post(), xx, new_x, f, gradff);
+    }
+    if(-1 == f_grad_eval_type_) {
+      //the first call decides whether the user provides the combined callback
+      f_grad_eval_type_ = bret ? 1 : 0;
+      log->printf(hovScalars, "objective and gradient evaluated %s\n", 
+		  bret ? "in one call" : "separately");
+    }
+    if(1 == f_grad_eval_type_) {
+      runStats.nEvalObj++;
+      runStats.nEvalGrad_f++;
+      f = nlp_transformations.applyToObj(f);
+      gradf = nlp_transformations.applyInvToGradObj(gradff);
+      return bret;
+    }
+  }
+  if(!eval_f(x, new_x, f)) {
+    return false;
+  }
+  return eval_grad_f(x, false, gradf);
+}
+
 bool hiopNlpFormulation::get_starting_point(hiopVector& x0,
 					    bool& duals_avail,
 					    hiopVector& zL0, hiopVector& zU0,
 					    hiopVector& yc0, hiopVector& yd0)
 {
   //aaa
-  hiopVectorPar &x0_for_hiop = dynamic_cast<hiopVectorPar&>(x0);
-  hiopVectorPar& zL0_for_hiop = dynamic_cast<hiopVectorPar&>(zL0);
-  hiopVectorPar& zU0_for_hiop = dynamic_cast<hiopVectorPar&>(zU0);
-  hiopVectorPar& yc0_for_hiop = dynamic_cast<hiopVectorPar&>(yc0);
-  hiopVectorPar& yd0_for_hiop = dynamic_cast<hiopVectorPar&>(yd0);
+  hiopVectorPar &x0_for_hiop = known_cast<hiopVectorPar&>(x0);
+  hiopVectorPar& zL0_for_hiop = known_cast<hiopVectorPar&>(zL0);
+  hiopVectorPar& zU0_for_hiop = known_cast<hiopVectorPar&>(zU0);
+  hiopVectorPar& yc0_for_hiop = known_cast<hiopVectorPar&>(yc0);
+  hiopVectorPar& yd0_for_hiop = known_cast<hiopVectorPar&>(yd0);
   
   bool bret; 
 
@@ -540,12 +697,7 @@ bool hiopNlpFormulation::get_starting_point(hiopVector& x0,
     assert(n_cons_eq+n_cons_ineq == n_cons);
     
     //copy back 
-    for(int i=0; i<n_cons_eq; ++i) {
-      yc0d[i] = lambda_for_user[cons_eq_mapping_[i]];
-    }
-    for(int i=0; i<n_cons_ineq; ++i) {
-      yd0d[i] = lambda_for_user[cons_ineq_mapping_[i]];
-    }
+    copy_cons_to_EqIneq(lambda_for_user, yc0d, yd0d);
   }
   
   if(!bret) {
@@ -564,13 +716,13 @@ bool hiopNlpFormulation::eval_c(double*x, bool new_x, double* c)
   double* xx = nlp_transformations.applyTox(x, new_x);
   double* cc = c;//nlp_transformations.applyToCons(c, n_cons_eq); //not needed for now
 
-  runStats.tmEvalCons.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_cons", runStats.tmEvalCons);
   bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 				       n_cons,n_cons_eq,
 				       cons_eq_mapping_,
 				       xx,new_x,
 				       cc);
-  runStats.tmEvalCons.stop(); runStats.nEvalCons_eq++;
+  runStats.nEvalCons_eq++;
 
   //c = nlp_transformations.applyInvToCons(c, n_cons_eq); //not needed for now
   return bret;
@@ -580,11 +732,11 @@ bool hiopNlpFormulation::eval_d(double*x, bool new_x, double* d)
   double* xx = nlp_transformations.applyTox(x, new_x);
   double* dd = d;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
 
-  runStats.tmEvalCons.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_cons", runStats.tmEvalCons);
   bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 				       n_cons, n_cons_ineq, cons_ineq_mapping_,
 				       xx, new_x, dd);
-  runStats.tmEvalCons.stop(); runStats.nEvalCons_ineq++;
+  runStats.nEvalCons_ineq++;
 
   //d = nlp_transformations.applyInvToCons(d, n_cons_ineq); //not needed for now
   return bret;
@@ -594,14 +746,13 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
 {
   bool do_eval_c = true;
   if(-1 == cons_eval_type_) {
-    assert(cons_body_ == NULL);
-    assert(NULL == cons_Jac_);
     if(!eval_c(x, new_x, c)) {
       //test if eval_d also fails; this means we should use one-call constraints/Jacobian evaluation
       if(!eval_d(x, new_x, d)) {
 	cons_eval_type_ = 1;
-	cons_body_ = new double[n_cons];
-	cons_Jac_ = alloc_Jac_cons();
+	if(NULL == cons_body_) cons_body_ = new double[n_cons];
+	if(NULL == cons_Jac_) cons_Jac_ = alloc_Jac_cons();
+	disable_linear_jac_caching("for all the constraints at once");
       } else {
 	cons_eval_type_ = 0;
 	return false;
@@ -626,20 +777,17 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
 
     double* xx = nlp_transformations.applyTox(x, new_x);
     double* body = cons_body_;//nlp_transformations.applyToCons(d, n_cons_ineq); //not needed for now
+    //'c' and 'd' are evaluated in place when they are the body in the user's order
+    const bool in_place = NULL!=cons_in_place(c, d);
+    if(in_place) body = c;
 
-    runStats.tmEvalCons.start();
+    hiopProfRegion prof_reg(runStats.prof, "eval_cons", runStats.tmEvalCons);
     bool bret = interface_base.eval_cons(nlp_transformations.n_post(),
 					 n_cons, 
 					 xx, new_x, body);
     //copy back to c and d
-    for(int i=0; i<n_cons_eq; ++i) {
-      c[i] = body[cons_eq_mapping_[i]];
-    }
-    for(int i=0; i<n_cons_ineq; ++i) {
-      d[i] = body[cons_ineq_mapping_[i]];
-    }
+    if(!in_place) copy_cons_to_EqIneq(body, c, d);
     
-    runStats.tmEvalCons.stop();
     runStats.nEvalCons_eq++;
     runStats.nEvalCons_ineq++;
     
@@ -648,18 +796,56 @@ bool hiopNlpFormulation::eval_c_d(double*x, bool new_x, double* c, double* d)
   }
 }
 
+bool hiopNlpFormulation::eval_funcs_concurrent_avail()
+{
+  //the transformations use internal buffers (not thread-safe) when they change x; the way 
+  //the constraints are evaluated should also be decided (by a previous call to eval_c_d)
+  return interface_base.eval_funcs_thread_safe() && 
+    nlp_transformations.n_post()==n_vars &&
+    -1 != cons_eval_type_;
+}
+
+bool hiopNlpFormulation::eval_f_c_d_concurrent(const double* x, double& f, 
+					       double* c, double* d, double* cons_buf)
+{
+  assert(eval_funcs_concurrent_avail());
+  if(!interface_base.eval_f(n_vars, x, true, f)) {
+    return false;
+  }
+  f = nlp_transformations.applyToObj(f);
+
+  //the first constraints evaluation at 'x' is also done with new_x=true since the objective
+  //and the constraints of other points may be evaluated in between by other threads
+  if(0 == cons_eval_type_) {
+    if(!interface_base.eval_cons(n_vars, n_cons, n_cons_eq, cons_eq_mapping_, x, true, c)) {
+      return false;
+    }
+    return interface_base.eval_cons(n_vars, n_cons, n_cons_ineq, cons_ineq_mapping_, x, false, d);
+  } else {
+    assert(1 == cons_eval_type_);
+    if(NULL!=cons_in_place(c, d)) {
+      return interface_base.eval_cons(n_vars, n_cons, x, true, c);
+    }
+    assert(cons_buf != NULL);
+    if(!interface_base.eval_cons(n_vars, n_cons, x, true, cons_buf)) {
+      return false;
+    }
+    copy_cons_to_EqIneq(cons_buf, c, d);
+    return true;
+  }
+}
+
 bool hiopNlpFormulation::eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d)
 {
   bool do_eval_Jac_c = true;
   if(-1 == cons_eval_type_) {
-    assert(cons_body_ == NULL);
-    assert(NULL == cons_Jac_);
     if(!eval_Jac_c(x, new_x, Jac_c)) {
       //test if eval_d also fails; this means we should use one-call constraints/Jacobian evaluation
       if(!eval_Jac_d(x, new_x, Jac_d)) {
 	cons_eval_type_ = 1;
-	cons_body_ = new double[n_cons];
-	cons_Jac_ = alloc_Jac_cons();
+	if(NULL == cons_body_) cons_body_ = new double[n_cons];
+	if(NULL == cons_Jac_) cons_Jac_ = alloc_Jac_cons();
+	disable_linear_jac_caching("for all the constraints at once");
       } else {
 	cons_eval_type_ = 0;
 	return false;
@@ -681,16 +867,58 @@ bool hiopNlpFormulation::eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c,
     assert(cons_body_);
     assert(cons_Jac_);
     
-    return eval_Jac_c_d_interface_impl(x, new_x, Jac_c, Jac_d);
+    return eval_Jac_c_d_interface_impl(x, new_x, NULL, Jac_c, Jac_d);
   }
   return true;
 }
 
+bool hiopNlpFormulation::eval_c_d_Jac_c_d(double* x, bool new_x, double* c, double* d,
+					  hiopMatrix& Jac_c, hiopMatrix& Jac_d)
+{
+  assert((NULL==c) == (NULL==d));
+  if(0 != cons_Jac_eval_type_) {
+    if(NULL == cons_body_) cons_body_ = new double[n_cons];
+    if(NULL == cons_Jac_) cons_Jac_ = alloc_Jac_cons();
+
+    //'c' and 'd' are evaluated in place when they are the body in the user's order
+    const bool in_place = NULL!=c && NULL!=cons_in_place(c, d);
+    double* body = in_place ? c : cons_body_;
+    bool bret = eval_Jac_c_d_interface_impl(x, new_x, body, Jac_c, Jac_d);
+    if(-1 == cons_Jac_eval_type_) {
+      //the first call decides whether the user provides the combined callback
+      cons_Jac_eval_type_ = bret ? 1 : 0;
+      log->printf(hovScalars, "constraints and Jacobian evaluated %s\n", 
+		  bret ? "in one call" : "separately");
+      if(bret) disable_linear_jac_caching("in one call");
+      //the buffers were needed only for the probe when neither one-call evaluation is used
+      if(!bret && 1 != cons_eval_type_) {
+	delete[] cons_body_;
+	cons_body_ = NULL;
+	delete cons_Jac_;
+	cons_Jac_ = NULL;
+      }
+    }
+    if(1 == cons_Jac_eval_type_) {
+      if(NULL!=c && !in_place) copy_cons_to_EqIneq(body, c, d);
+      runStats.nEvalCons_eq++;
+      runStats.nEvalCons_ineq++;
+      return bret;
+    }
+  }
+  if(NULL!=c) {
+    if(!eval_c_d(x, new_x, c, d)) {
+      return false;
+    }
+    new_x = false;
+  }
+  return eval_Jac_c_d(x, new_x, Jac_c, Jac_d);
+}
+
 void hiopNlpFormulation::
 get_dual_solutions(const hiopIterate& it, double* zl_a, double* zu_a, double* lambda_a)
 {
-  const hiopVectorPar& zl = dynamic_cast<hiopVectorPar&>(*it.get_zl());
-  const hiopVectorPar& zu = dynamic_cast<hiopVectorPar&>(*it.get_zu());
+  const hiopVectorPar& zl = known_cast<hiopVectorPar&>(*it.get_zl());
+  const hiopVectorPar& zu = known_cast<hiopVectorPar&>(*it.get_zu());
   zl.copyTo(zl_a);
   zu.copyTo(zu_a);
 
@@ -702,10 +930,15 @@ void hiopNlpFormulation::copy_EqIneq_to_cons(const hiopVector& yc_in,
 					     int num_cons, //size of 'cons'
 					     double* cons)
 {
-  const double* yc_arr = dynamic_cast<const hiopVectorPar&>(yc_in).local_data_const();
-  const double* yd_arr = dynamic_cast<const hiopVectorPar&>(yd_in).local_data_const();
+  const double* yc_arr = known_cast<const hiopVectorPar&>(yc_in).local_data_const();
+  const double* yd_arr = known_cast<const hiopVectorPar&>(yd_in).local_data_const();
   assert(num_cons == n_cons);
   assert(yc_in.get_size() + yd_in.get_size() == n_cons);
+  if(cons_grouped_) {
+    memcpy(cons,             yc_arr, n_cons_eq*sizeof(double));
+    memcpy(cons+n_cons_eq,   yd_arr, n_cons_ineq*sizeof(double));
+    return;
+  }
     //concatanate multipliers -> copy into whole lambda array 
   for(int i=0; i<n_cons_eq; ++i) {
     cons[cons_eq_mapping_[i]] = yc_arr[i];
@@ -715,6 +948,21 @@ void hiopNlpFormulation::copy_EqIneq_to_cons(const hiopVector& yc_in,
   }
 }
 
+void hiopNlpFormulation::copy_cons_to_EqIneq(const double* cons, double* c, double* d) const
+{
+  if(cons_grouped_) {
+    memcpy(c, cons,           n_cons_eq*sizeof(double));
+    memcpy(d, cons+n_cons_eq, n_cons_ineq*sizeof(double));
+    return;
+  }
+  for(int i=0; i<n_cons_eq; ++i) {
+    c[i] = cons[cons_eq_mapping_[i]];
+  }
+  for(int i=0; i<n_cons_ineq; ++i) {
+    d[i] = cons[cons_ineq_mapping_[i]];
+  }
+}
+
 void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
 						const hiopVector& x,
 						const hiopVector& z_L,
@@ -725,25 +973,33 @@ void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
 						const hiopVector& y_d,
 						double obj_value) 
 {
-  const hiopVectorPar& xp = dynamic_cast<const hiopVectorPar&>(x);
-  const hiopVectorPar& zl = dynamic_cast<const hiopVectorPar&>(z_L);
-  const hiopVectorPar& zu = dynamic_cast<const hiopVectorPar&>(z_U);
+  const hiopVectorPar& xp = known_cast<const hiopVectorPar&>(x);
+  const hiopVectorPar& zl = known_cast<const hiopVectorPar&>(z_L);
+  const hiopVectorPar& zu = known_cast<const hiopVectorPar&>(z_U);
 
   assert(xp.get_size()==n_vars);
   assert(y_c.get_size() == n_cons_eq);
   assert(y_d.get_size() == n_cons_ineq);
 
-  if(cons_lambdas_ == NULL) {
-    cons_lambdas_ = new double[n_cons];
+  //the multipliers and the body are passed with no copy when they are in the user's order
+  const double* lambdas = cons_in_place(y_c.local_data_const(), y_d.local_data_const());
+  if(NULL == lambdas) {
+    if(cons_lambdas_ == NULL) {
+      cons_lambdas_ = new double[n_cons];
+    }
+    copy_EqIneq_to_cons(y_c, y_d, n_cons, cons_lambdas_);
+    lambdas = cons_lambdas_;
   }
-  copy_EqIneq_to_cons(y_c, y_d, n_cons, cons_lambdas_);
-  
   
   //concatenate 'c' and 'd' into user's constrainty body
-  if(cons_body_ == NULL) {
-    cons_body_ = new double[n_cons];
+  const double* body = cons_in_place(c.local_data_const(), d.local_data_const());
+  if(NULL == body) {
+    if(cons_body_ == NULL) {
+      cons_body_ = new double[n_cons];
+    }
+    copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
+    body = cons_body_;
   }
-  copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
   
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
@@ -751,8 +1007,8 @@ void hiopNlpFormulation::user_callback_solution(hiopSolveStatus status,
   interface_base.solution_callback(status, 
 				   (int)n_vars, xp.local_data_const(),
 				   zl.local_data_const(), zu.local_data_const(),
-				   (int)n_cons, cons_body_,
-				   cons_lambdas_,
+				   (int)n_cons, body,
+				   lambdas,
 				   obj_value);
 }
 
@@ -772,26 +1028,34 @@ bool hiopNlpFormulation::user_callback_iterate(int iter,
 					       double alpha_pr,
 					       int ls_trials)
 {
-  const hiopVectorPar& xp = dynamic_cast<const hiopVectorPar&>(x);
-  const hiopVectorPar& zl = dynamic_cast<const hiopVectorPar&>(z_L);
-  const hiopVectorPar& zu = dynamic_cast<const hiopVectorPar&>(z_U);
+  const hiopVectorPar& xp = known_cast<const hiopVectorPar&>(x);
+  const hiopVectorPar& zl = known_cast<const hiopVectorPar&>(z_L);
+  const hiopVectorPar& zu = known_cast<const hiopVectorPar&>(z_U);
   assert(xp.get_size()==n_vars);
   assert(c.get_size()+d.get_size()==n_cons);
 
   assert(y_c.get_size() == n_cons_eq);
   assert(y_d.get_size() == n_cons_ineq);
 
-  if(cons_lambdas_ == NULL) {
-    cons_lambdas_ = new double[n_cons];
+  //the multipliers and the body are passed with no copy when they are in the user's order
+  const double* lambdas = cons_in_place(y_c.local_data_const(), y_d.local_data_const());
+  if(NULL == lambdas) {
+    if(cons_lambdas_ == NULL) {
+      cons_lambdas_ = new double[n_cons];
+    }
+    copy_EqIneq_to_cons(y_c, y_d, n_cons, cons_lambdas_);
+    lambdas = cons_lambdas_;
   }
-  copy_EqIneq_to_cons(y_c, y_d, n_cons, cons_lambdas_);
-  
   
   //concatenate 'c' and 'd' into user's constrainty body
-  if(cons_body_ == NULL) {
-    cons_body_ = new double[n_cons];
+  const double* body = cons_in_place(c.local_data_const(), d.local_data_const());
+  if(NULL == body) {
+    if(cons_body_ == NULL) {
+      cons_body_ = new double[n_cons];
+    }
+    copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
+    body = cons_body_;
   }
-  copy_EqIneq_to_cons(c, d, n_cons, cons_body_);
   
   //! todo -> test this when fixed variables are removed -> the internal
   //! zl and zu may have different sizes than what user expects since HiOp removes
@@ -800,8 +1064,8 @@ bool hiopNlpFormulation::user_callback_iterate(int iter,
   return interface_base.iterate_callback(iter, obj_value, 
 					 (int)n_vars, xp.local_data_const(),
 					 zl.local_data_const(), zu.local_data_const(),
-					 (int)n_cons, cons_body_, 
-					 cons_lambdas_,
+					 (int)n_cons, body, 
+					 lambdas,
 					 inf_pr, inf_du, mu, alpha_du, alpha_pr,  ls_trials);
 }
 
@@ -836,8 +1100,9 @@ void hiopNlpFormulation::print(FILE* f, const char* msg, int rank) const
  * ***********************************************************************************
 */
 
-hiopNlpDenseConstraints::hiopNlpDenseConstraints(hiopInterfaceDenseConstraints& interface_)
-  : hiopNlpFormulation(interface_), interface(interface_)
+hiopNlpDenseConstraints::hiopNlpDenseConstraints(hiopInterfaceDenseConstraints& interface_,
+						 const char* options_file/*=NULL*/)
+  : hiopNlpFormulation(interface_, options_file), interface(interface_)
 {
 }
 
@@ -855,10 +1120,10 @@ bool hiopNlpDenseConstraints::eval_Jac_c(double* x, bool new_x, double** Jac_c)
   double*  x_user      = nlp_transformations.applyTox(x, new_x);
   double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq);
 
-  runStats.tmEvalJac_con.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(),n_cons,n_cons_eq,cons_eq_mapping_,
 				      x_user,new_x,Jac_c_user);
-  runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_eq++;
+  runStats.nEvalJac_con_eq++;
 
   Jac_c = nlp_transformations.applyInvToJacobEq(Jac_c_user, n_cons_eq);
   return bret;
@@ -868,16 +1133,17 @@ bool hiopNlpDenseConstraints::eval_Jac_d(double* x, bool new_x, double** Jac_d)
   double* x_user      = nlp_transformations.applyTox(x, new_x);
   double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
  
-  runStats.tmEvalJac_con.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
   bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(),n_cons,n_cons_ineq,cons_ineq_mapping_,
 				      x_user,new_x,Jac_d_user);
-  runStats.tmEvalJac_con.stop(); runStats.nEvalJac_con_ineq++;
+  runStats.nEvalJac_con_ineq++;
 
   Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
   return bret;
 }
 
 bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(double* x, bool new_x,
+							  double* cons,
 							  hiopMatrix& Jac_c,
 							  hiopMatrix& Jac_d)
 {
@@ -897,19 +1163,29 @@ bool hiopNlpDenseConstraints::eval_Jac_c_d_interface_impl(double* x, bool new_x,
   double** Jac_consde = cons_Jac_de->local_data();
   double** Jac_user = nlp_transformations.applyToJacobCons(Jac_consde, n_cons);
 
-  runStats.tmEvalJac_con.start();
-  bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(), n_cons,
-				      x_user, new_x,
-				      Jac_user);
+  hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
+  bool bret;
+  if(NULL == cons) {
+    bret = interface.eval_Jac_cons(nlp_transformations.n_post(), n_cons,
+				   x_user, new_x,
+				   Jac_user);
+  } else {
+    bret = interface.eval_cons_Jac_cons(nlp_transformations.n_post(), n_cons,
+					x_user, new_x,
+					cons, Jac_user);
+  }
   
   Jac_consde = nlp_transformations.applyInvToJacobCons(Jac_user, n_cons);
   assert(cons_Jac_de->local_data() == Jac_consde &&
 	 "mismatch between Jacobian mem adress pre- and post-transformations should not happen");
+  //a combined callback that is not provided leaves the Jacobian unevaluated
+  if(NULL != cons && !bret) {
+    return false;
+  }
 
   Jac_cde->copyRowsFrom(*cons_Jac_, cons_eq_mapping_, n_cons_eq);
   Jac_dde->copyRowsFrom(*cons_Jac_, cons_ineq_mapping_, n_cons_ineq);
   
-  runStats.tmEvalJac_con.stop();
   runStats.nEvalJac_con_eq++;
   runStats.nEvalJac_con_ineq++;
 
@@ -923,7 +1199,17 @@ bool hiopNlpDenseConstraints::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_
     log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP works only with dense matrices\n");
     return false;
   } else {
-    return this->eval_Jac_c(x, new_x, Jac_cde->local_data());
+    if(jac_lin_cache_ && Jac_c_lin_cached_==&Jac_c) {
+      bool bret = eval_Jac_nonlinear_rows(x, new_x, n_cons_eq_nl_, cons_eq_nl_idx_, cons_eq_nl_mapping_, 
+					  *Jac_cde, Jac_c_nl_buf_);
+      runStats.nEvalJac_con_eq++;
+      return bret;
+    }
+    bool bret = this->eval_Jac_c(x, new_x, Jac_cde->local_data());
+    if(bret && jac_lin_cache_) {
+      Jac_c_lin_cached_ = &Jac_c;
+    }
+    return bret;
   }
 }
 
@@ -934,10 +1220,53 @@ bool hiopNlpDenseConstraints::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_
     log->printf(hovError, "[internal error] hiopNlpDenseConstraints NLP works only with dense matrices\n");
     return false;
   } else {
-    return this->eval_Jac_d(x, new_x, Jac_dde->local_data());
+    if(jac_lin_cache_ && Jac_d_lin_cached_==&Jac_d) {
+      bool bret = eval_Jac_nonlinear_rows(x, new_x, n_cons_ineq_nl_, cons_ineq_nl_idx_, cons_ineq_nl_mapping_,
+					  *Jac_dde, Jac_d_nl_buf_);
+      runStats.nEvalJac_con_ineq++;
+      return bret;
+    }
+    bool bret = this->eval_Jac_d(x, new_x, Jac_dde->local_data());
+    if(bret && jac_lin_cache_) {
+      Jac_d_lin_cached_ = &Jac_d;
+    }
+    return bret;
   }
 }
 
+bool hiopNlpDenseConstraints::eval_Jac_nonlinear_rows(double* x, bool new_x,
+						      long long num_rows,
+						      const long long* rows_idx,
+						      const long long* rows_mapping,
+						      hiopMatrixDense& Jac,
+						      hiopMatrix*& Jac_nl_buf)
+{
+  if(0==num_rows) {
+    //all rows are linear and already in 'Jac'
+    return true;
+  }
+  if(NULL==Jac_nl_buf) {
+    Jac_nl_buf = alloc_multivector_primal(num_rows);
+  }
+  hiopMatrixDense* buf = dynamic_cast<hiopMatrixDense*>(Jac_nl_buf);
+  assert(buf && buf->m()==num_rows);
+
+  double* x_user = nlp_transformations.applyTox(x, new_x);
+  double** buf_data = buf->local_data();
+  
+  hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
+  bool bret = interface.eval_Jac_cons(nlp_transformations.n_post(), n_cons, num_rows, rows_mapping,
+				      x_user, new_x, buf_data);
+  double** Jac_data = Jac.local_data();
+  const size_t row_bytes = Jac.get_local_size_n()*sizeof(double);
+  for(long long i=0; i<num_rows; ++i) {
+    assert(rows_idx[i]<Jac.m());
+    memcpy(Jac_data[rows_idx[i]], buf_data[i], row_bytes);
+  }
+
+  return bret;
+}
+
 hiopMatrixDense* hiopNlpDenseConstraints::alloc_Jac_c()
 {
   return alloc_multivector_primal(n_cons_eq);
@@ -992,12 +1321,18 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
 {
   hiopMatrixMDS* pJac_c = dynamic_cast<hiopMatrixMDS*>(&Jac_c);
   assert(pJac_c);
+  if(pJac_c && jac_lin_cache_ && Jac_c_lin_cached_==&Jac_c) {
+    bool bret = eval_Jac_nonlinear_rows(x, new_x, n_cons_eq_nl_, cons_eq_nl_idx_, cons_eq_nl_mapping_,
+					*pJac_c, Jac_c_nl_buf_);
+    runStats.nEvalJac_con_eq++;
+    return bret;
+  }
   if(pJac_c) {
     double* x_user = nlp_transformations.applyTox(x, new_x);
     //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
     //double** Jac_c_user = nlp_transformations.applyToJacobEq(Jac_c, n_cons_eq); //!
     
-    runStats.tmEvalJac_con.start();
+    hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
     
     int nnz = pJac_c->sp_nnz();
     bool bret = interface.eval_Jac_cons(n_vars, n_cons, 
@@ -1009,8 +1344,10 @@ bool hiopNlpMDS::eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)
 
     //! todo -> need hiopNlpTransformation::applyInvToJacobXXX to work with MDS Jacobian
     //Jac_c = nlp_transformations.applyInvToJacobEq(Jac_c_user, n_cons_eq); //!
-    runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
+    if(bret && jac_lin_cache_) {
+      Jac_c_lin_cached_ = &Jac_c;
+    }
     return bret;
   } else {
     return false;
@@ -1020,12 +1357,18 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
 {
   hiopMatrixMDS* pJac_d = dynamic_cast<hiopMatrixMDS*>(&Jac_d);
   assert(pJac_d);
+  if(pJac_d && jac_lin_cache_ && Jac_d_lin_cached_==&Jac_d) {
+    bool bret = eval_Jac_nonlinear_rows(x, new_x, n_cons_ineq_nl_, cons_ineq_nl_idx_, cons_ineq_nl_mapping_,
+					*pJac_d, Jac_d_nl_buf_);
+    runStats.nEvalJac_con_ineq++;
+    return bret;
+  }
   if(pJac_d) {
     double* x_user      = nlp_transformations.applyTox(x, new_x);
     //! todo -> need hiopNlpTransformation::applyToJacobXXX to work with MDS Jacobian
     //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
-    runStats.tmEvalJac_con.start();
+    hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
   
     int nnz = pJac_d->sp_nnz();
     bool bret =  interface.eval_Jac_cons(n_vars, n_cons, 
@@ -1037,15 +1380,95 @@ bool hiopNlpMDS::eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)
 
     //! todo -> need hiopNlpTransformation::applyInvToJacobXXX to work with MDS Jacobian
     //Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
-    runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_ineq++;
+    if(bret && jac_lin_cache_) {
+      Jac_d_lin_cached_ = &Jac_d;
+    }
     return bret;
   } else {
     return false;
   }
 }
+/* The sparse block of the buffer for the nonlinear rows is sized based on the nonzeros of the 
+ * corresponding rows of 'Jac', which was already evaluated. The implementer is expected to provide 
+ * the nonzeros of the nonlinear rows in the same order as when the whole Jacobian is requested.
+ */
+bool hiopNlpMDS::eval_Jac_nonlinear_rows(double* x, bool new_x,
+					 long long num_rows,
+					 const long long* rows_idx,
+					 const long long* rows_mapping,
+					 hiopMatrixMDS& Jac,
+					 hiopMatrix*& Jac_nl_buf)
+{
+  if(0==num_rows) {
+    //all rows are linear and already in 'Jac'
+    return true;
+  }
+
+  const int nnz = Jac.sp_nnz();
+  const int* iRow = Jac.sp_irow();
+  double* M = Jac.sp_M();
+
+  if(NULL==Jac_nl_buf) {
+    int nnz_nl=0, itnz=0;
+    for(long long i=0; i<num_rows; ++i) {
+      while(itnz<nnz && iRow[itnz]<rows_idx[i]) itnz++;
+      while(itnz<nnz && iRow[itnz]==rows_idx[i]) { itnz++; nnz_nl++; }
+    }
+    Jac_nl_buf = new hiopMatrixMDS(num_rows, nx_sparse, nx_dense, nnz_nl);
+  }
+  hiopMatrixMDS* buf = dynamic_cast<hiopMatrixMDS*>(Jac_nl_buf);
+  assert(buf && buf->m()==num_rows);
+
+  double* x_user = nlp_transformations.applyTox(x, new_x);
+
+  hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
+
+  int nnz_buf = buf->sp_nnz();
+  bool bret = interface.eval_Jac_cons(n_vars, n_cons, 
+				      num_rows, rows_mapping, 
+				      x_user, new_x,
+				      buf->n_sp(), buf->n_de(), 
+				      nnz_buf, buf->sp_irow(), buf->sp_jcol(), buf->sp_M(),
+				      buf->de_local_data());
+
+  //copy the values of the nonlinear rows into 'Jac'
+  const double* M_buf = buf->sp_M();
+#ifdef HIOP_DEEPCHECKS
+  const int* jCol = Jac.sp_jcol();
+  const int* jCol_buf = buf->sp_jcol();
+#endif
+  int itnz=0, itnz_buf=0;
+  for(long long i=0; i<num_rows; ++i) {
+    while(itnz<nnz && iRow[itnz]<rows_idx[i]) itnz++;
+    while(itnz<nnz && iRow[itnz]==rows_idx[i]) {
+      assert(itnz_buf<nnz_buf);
+#ifdef HIOP_DEEPCHECKS
+      if(jCol[itnz]!=jCol_buf[itnz_buf]) {
+	log->printf(hovError, "The nonzeros of the nonlinear Jacobian rows are not consistent with "
+		    "those of the full Jacobian (row %d)\n", iRow[itnz]);
+	return false;
+      }
+#endif
+      M[itnz++] = M_buf[itnz_buf++];
+    }
+  }
+  assert(itnz_buf==nnz_buf);
+
+  double** JacD = Jac.de_local_data();
+  double** JacD_buf = buf->de_local_data();
+  const size_t row_bytes = nx_dense*sizeof(double);
+  for(long long i=0; i<num_rows; ++i) {
+    assert(rows_idx[i]<Jac.m());
+    memcpy(JacD[rows_idx[i]], JacD_buf[i], row_bytes);
+  }
+
+  return bret;
+}
+
 bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
 					     bool new_x,
+					     double* cons,
 					     hiopMatrix& Jac_c,
 					     hiopMatrix& Jac_d)
 {
@@ -1065,14 +1488,28 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
     //! todo -> need hiopNlpTransformation::applyInvToJacobIneq to work with MDS Jacobian
     //double** Jac_d_user = nlp_transformations.applyToJacobIneq(Jac_d, n_cons_ineq);
     
-    runStats.tmEvalJac_con.start();
+    hiopProfRegion prof_reg(runStats.prof, "eval_Jac_cons", runStats.tmEvalJac_con);
   
     int nnz = cons_Jac->sp_nnz();
-    bool bret = interface.eval_Jac_cons(n_vars, n_cons, 
-					x_user, new_x,
-					pJac_d->n_sp(), pJac_d->n_de(), 
-					nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
-					cons_Jac->de_local_data());
+    bool bret;
+    if(NULL == cons) {
+      bret = interface.eval_Jac_cons(n_vars, n_cons, 
+				     x_user, new_x,
+				     pJac_d->n_sp(), pJac_d->n_de(), 
+				     nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
+				     cons_Jac->de_local_data());
+    } else {
+      bret = interface.eval_cons_Jac_cons(n_vars, n_cons, 
+					  x_user, new_x,
+					  cons,
+					  pJac_d->n_sp(), pJac_d->n_de(), 
+					  nnz, cons_Jac->sp_irow(), cons_Jac->sp_jcol(), cons_Jac->sp_M(),
+					  cons_Jac->de_local_data());
+      //a combined callback that is not provided leaves the Jacobian unevaluated
+      if(!bret) {
+	return false;
+      }
+    }
     //! todo -> need hiopNlpTransformation::applyInvToJacobIneq to work with MDS Jacobian
     //Jac_d = nlp_transformations.applyInvToJacobIneq(Jac_d_user, n_cons_ineq);
     
@@ -1080,7 +1517,6 @@ bool hiopNlpMDS::eval_Jac_c_d_interface_impl(double* x,
     pJac_c->copyRowsFrom(*cons_Jac, cons_eq_mapping_, n_cons_eq);
     pJac_d->copyRowsFrom(*cons_Jac, cons_ineq_mapping_, n_cons_ineq);
     
-    runStats.tmEvalJac_con.stop();
     runStats.nEvalJac_con_eq++;
     runStats.nEvalJac_con_ineq++;
     
@@ -1098,7 +1534,7 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
   hiopMatrixSymBlockDiagMDS* pHessL = dynamic_cast<hiopMatrixSymBlockDiagMDS*>(&Hess_L);
   assert(pHessL);
 
-  runStats.tmEvalHessL.start();
+  hiopProfRegion prof_reg(runStats.prof, "eval_Hess_Lagr", runStats.tmEvalHessL);
 
   bool bret = false;
   if(pHessL) {
@@ -1109,13 +1545,28 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
 	_buf_lambda = LinearAlgebraFactory::createVector(n_cons_eq + n_cons_ineq);
     }
     assert(_buf_lambda);
-    _buf_lambda->copyFromStarting(0,         lambda_eq,   n_cons_eq);
-    _buf_lambda->copyFromStarting(n_cons_eq, lambda_ineq, n_cons_ineq);
+    //the multipliers are passed with no copy when they are in the user's order, unless they
+    //need to be altered below
+    const double* lambda_user = jac_lin_cache_ ? NULL : cons_in_place(lambda_eq, lambda_ineq);
+    if(NULL == lambda_user) {
+      _buf_lambda->copyFromStarting(0,         lambda_eq,   n_cons_eq);
+      _buf_lambda->copyFromStarting(n_cons_eq, lambda_ineq, n_cons_ineq);
+
+      if(jac_lin_cache_) {
+	//linear constraints do not contribute to the Hessian of the Lagrangian
+	double* lambda = _buf_lambda->local_data();
+	for(long long i=0; i<n_cons_eq; ++i)
+	  if(cons_eq_type[i]==hiopInterfaceBase::hiopLinear) lambda[i] = 0.;
+	for(long long i=0; i<n_cons_ineq; ++i)
+	  if(cons_ineq_type[i]==hiopInterfaceBase::hiopLinear) lambda[n_cons_eq+i] = 0.;
+      }
+      lambda_user = _buf_lambda->local_data_const();
+    }
     
     int nnzHSS = pHessL->sp_nnz(), nnzHSD = 0;
     
     bret = interface.eval_Hess_Lagr(n_vars, n_cons, x, new_x, 
-				    obj_factor, _buf_lambda->local_data(), new_lambdas, 
+				    obj_factor, lambda_user, new_lambdas, 
 				    pHessL->n_sp(), pHessL->n_de(),
 				    nnzHSS, pHessL->sp_irow(), pHessL->sp_jcol(), pHessL->sp_M(),
 				    pHessL->de_local_data(),
@@ -1127,7 +1578,6 @@ bool hiopNlpMDS::eval_Hess_Lagr(const double* x, bool new_x, const double& obj_f
     bret = false;
   }
 
-  runStats.tmEvalHessL.stop();
   runStats.nEvalHessL++;
   
   return bret;
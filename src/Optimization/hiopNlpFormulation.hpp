@@ -85,7 +85,11 @@ namespace hiop
 class hiopNlpFormulation
 {
 public:
-  hiopNlpFormulation(hiopInterfaceBase& interface);
+  /* 'options_file' is the file the options are read from: NULL for the default 'hiop.options', 
+   * while an empty string reads no file, which is what solvers running concurrently in the same
+   * process should use (all the options are then set through 'options') 
+   */
+  hiopNlpFormulation(hiopInterfaceBase& interface, const char* options_file=NULL);
   virtual ~hiopNlpFormulation();
 
   virtual bool finalizeInitialization();
@@ -96,17 +100,42 @@ public:
    */
   virtual bool eval_f(double* x, bool new_x, double& f);
   virtual bool eval_grad_f(double* x, bool new_x, double* gradf);
+  /* Evaluates the objective and its gradient with the user's combined callback 'eval_f_grad_f'
+   * when provided, otherwise with 'eval_f' and 'eval_grad_f' */
+  virtual bool eval_f_grad_f(double* x, bool new_x, double& f, double* gradf);
+  /* whether the user provides the combined objective and gradient callback; known only after
+   * the first call to @eval_f_grad_f */
+  inline bool f_grad_combined() const { return 1 == f_grad_eval_type_; }
   
   virtual bool eval_c(double* x, bool new_x, double* c);
   virtual bool eval_d(double* x, bool new_x, double* d);
   virtual bool eval_c_d(double* x, bool new_x, double* c, double* d);
+  /* Thread-safe evaluation of the objective and of the constraints at 'x', used to evaluate 
+   * line-search trial points concurrently. Does not apply the NLP transformations, does not update
+   * 'runStats', and uses the caller's 'cons_buf' (of size m()) instead of the internal buffer for 
+   * one-call constraints evaluations. Can be used only if @eval_funcs_concurrent_avail is true.
+   */
+  bool eval_f_c_d_concurrent(const double* x, double& f, double* c, double* d, double* cons_buf);
+  /* whether the user's functions evaluations are thread-safe and @eval_f_c_d_concurrent can be used */
+  bool eval_funcs_concurrent_avail();
   /* the implementation of the next two methods depends both on the interface and on the formulation */
   virtual bool eval_Jac_c(double* x, bool new_x, hiopMatrix& Jac_c)=0;
   virtual bool eval_Jac_d(double* x, bool new_x, hiopMatrix& Jac_d)=0;
   virtual bool eval_Jac_c_d(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  /* Evaluates the constraints and their Jacobian with the user's combined callback 
+   * 'eval_cons_Jac_cons' when provided, otherwise with @eval_c_d and @eval_Jac_c_d. 'c' and 'd' 
+   * can be both NULL when only the Jacobian is needed. */
+  virtual bool eval_c_d_Jac_c_d(double* x, bool new_x, double* c, double* d,
+				hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  /* whether the user provides the combined constraints and Jacobian callback; known only after
+   * the first call to @eval_c_d_Jac_c_d */
+  inline bool cons_Jac_combined() const { return 1 == cons_Jac_eval_type_; }
 protected:
-  //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of hiopMatrix arguments
-  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d) = 0;
+  //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of hiopMatrix
+  //arguments; when 'cons' is not NULL, calls hiopInterfaceXXX::eval_cons_Jac_cons instead and 
+  //returns in 'cons' the constraints body in the user's order
+  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, double* cons,
+					   hiopMatrix& Jac_c, hiopMatrix& Jac_d) = 0;
 public:
   virtual bool eval_Hess_Lagr(const double* x, bool new_x, 
 			      const double& obj_factor,  
@@ -125,6 +154,13 @@ public:
   virtual hiopVector* alloc_dual_eq_vec() const;
   virtual hiopVector* alloc_dual_ineq_vec() const;
   virtual hiopVector* alloc_dual_vec() const;
+  /**
+   * Allocates the constraints bodies 'c' (as alloc_dual_eq_vec) and 'd' (as alloc_dual_ineq_vec)
+   * in one buffer, 'd' right after 'c'. When the user's constraints are grouped (see 
+   * cons_grouped), 'c' and 'd' are then the one-call constraints body in user's order and are 
+   * evaluated in place. The returned vector owns the buffer and should outlive 'c' and 'd'.
+   */
+  hiopVector* alloc_cons_body_vecs(hiopVector*& c, hiopVector*& d) const;
   /* the implementation of the next two methods depends both on the interface and on the formulation */
   virtual hiopMatrix* alloc_Jac_c() = 0;
   virtual hiopMatrix* alloc_Jac_d() = 0;
@@ -183,7 +219,7 @@ public:
   inline double user_obj(double hiop_f) { return nlp_transformations.applyToObj(hiop_f); }
   inline void   user_x(hiopVector& hiop_x, double* user_x) 
   { 
-    double *hiop_xa = dynamic_cast<hiopVectorPar&>( hiop_x ).local_data();
+    double *hiop_xa = known_cast<hiopVectorPar&>( hiop_x ).local_data();
     double *user_xa = nlp_transformations.applyTox(hiop_xa,/*new_x=*/true); 
     //memcpy(user_x, user_xa, hiop_x.get_local_size()*sizeof(double));
     memcpy(user_x, user_xa, nlp_transformations.n_post_local()*sizeof(double));
@@ -201,6 +237,12 @@ public:
 			   const hiopVector& yd,
 			   int num_cons, //size of 'cons'
 			   double* cons);
+  /* the inverse of the above: unpacks 'cons' (in the user's order) into 'c' and 'd' */
+  void copy_cons_to_EqIneq(const double* cons, double* c, double* d) const;
+
+  /* true when the user's constraints are the equalities followed by the inequalities, in which 
+   * case the internal mappings are the identity and no gather/scatter is needed */
+  inline bool cons_grouped() const { return cons_grouped_; }
   
   /* outputing and debug-related functionality*/
   hiopLogger* log;
@@ -236,6 +278,15 @@ protected:
   
   // keep track of the constraints indexes in the original, user's formulation
   long long *cons_eq_mapping_, *cons_ineq_mapping_; 
+  // the user's constraints are the equalities followed by the inequalities
+  bool cons_grouped_;
+
+  /* returns 'c' when 'c' and 'd' are, with no copy, the constraints (or multipliers) in the 
+   * user's order, i.e., the constraints are grouped and 'd' follows 'c' in memory; NULL otherwise */
+  inline const double* cons_in_place(const double* c, const double* d) const
+  {
+    return (cons_grouped_ && c+n_cons_eq==d) ? c : NULL;
+  }
 
   //options for which this class was setup
   std::string strFixedVars; //"none", "fixed", "relax"
@@ -262,22 +313,59 @@ protected:
   int cons_eval_type_;
   
   /** 
-   * Internal buffer for constraints. Used only when constraints and Jacobian are evaluated at 
-   * once (cons_eval_type_==1), otherwise NULL.
+   * Internal buffer for constraints. Used when constraints and Jacobian are evaluated at once 
+   * (cons_eval_type_==1) or together (cons_Jac_eval_type_==1), and to pass the constraints body to
+   * @user_callback_solution and @user_callback_iterate when it is not in the user's order. 
+   * Allocated on first use.
    */
   double* cons_body_;
   
   /** 
    * Internal buffer for the Jacobian. Used only when constraints and Jacobian are evaluated at 
-   * once (cons_eval_type_==1), otherwise NULL.
+   * once (cons_eval_type_==1) or together (cons_Jac_eval_type_==1), otherwise NULL. It is also 
+   * allocated for the first call to @eval_c_d_Jac_c_d, which probes for the combined callback, and
+   * freed (with 'cons_body_') when the user does not provide it.
    */
   hiopMatrix* cons_Jac_;
 
+  /**
+   * Flags to indicate whether the objective and gradient, respectively the constraints and 
+   * Jacobian, are evaluated with the user's combined callbacks. Same values as 'cons_eval_type_':
+   * -1 not decided, 0 separately, 1 combined. The combined constraints and Jacobian evaluation 
+   * uses the buffers 'cons_body_' and 'cons_Jac_' above.
+   */
+  int f_grad_eval_type_;
+  int cons_Jac_eval_type_;
+
   /** 
    * Internal buffer for the multipliers of the constraints use to copy the multipliers of eq. and
    * ineq. into and to return it to the user via @user_callback_solution and @user_callback_iterate
    */
   double* cons_lambdas_;
+
+  /**
+   * Caching of the Jacobian rows of the linear constraints (option 'cache_linear_jac'). When 
+   * 'jac_lin_cache_' is true, only the rows of the nonlinear constraints are re-evaluated once the 
+   * Jacobian in 'Jac_c_lin_cached_' (or 'Jac_d_lin_cached_') was fully evaluated.
+   *
+   * 'cons_eq_nl_idx_' and 'cons_ineq_nl_idx_' contain the indexes of the rows of Jac_c and Jac_d 
+   * corresponding to nonlinear constraints, while 'cons_eq_nl_mapping_' and 'cons_ineq_nl_mapping_'
+   * contain the indexes of these constraints in the user's formulation.
+   */
+  bool jac_lin_cache_;
+  long long n_cons_eq_nl_, n_cons_ineq_nl_;
+  long long *cons_eq_nl_idx_, *cons_ineq_nl_idx_;
+  long long *cons_eq_nl_mapping_, *cons_ineq_nl_mapping_;
+  const hiopMatrix *Jac_c_lin_cached_, *Jac_d_lin_cached_;
+  
+  /** Internal buffers for the Jacobian rows of the nonlinear constraints; allocated on demand. */
+  hiopMatrix *Jac_c_nl_buf_, *Jac_d_nl_buf_;
+
+  /* (re)builds the info above based on 'cons_eq_type', 'cons_ineq_type' and the user options */
+  void setup_linear_jac_caching();
+  /* turns off the caching above, with a warning, when the Jacobian is evaluated by the one-call 
+   * callbacks, which evaluate all its rows; 'how' completes "evaluated ..." in the warning */
+  void disable_linear_jac_caching(const char* how);
 private:
   hiopNlpFormulation(const hiopNlpFormulation& s) : interface_base(s.interface_base) {};
 };
@@ -290,7 +378,7 @@ private:
 class hiopNlpDenseConstraints : public hiopNlpFormulation
 {
 public:
-  hiopNlpDenseConstraints(hiopInterfaceDenseConstraints& interface);
+  hiopNlpDenseConstraints(hiopInterfaceDenseConstraints& interface, const char* options_file=NULL);
   virtual ~hiopNlpDenseConstraints();
 
   virtual bool finalizeInitialization();
@@ -303,7 +391,8 @@ public:
 protected:
   //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of
   //hiopMatrix arguments
-  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, double* cons,
+					   hiopMatrix& Jac_c, hiopMatrix& Jac_d);
 public:
   virtual bool eval_Hess_Lagr(const double* x,
 			      bool new_x,
@@ -329,6 +418,12 @@ public:
    */
   virtual hiopMatrixDense* alloc_multivector_primal(int nrows, int max_rows=-1) const;
 
+private:
+  /* evaluates only the 'num_rows' Jacobian rows of nonlinear constraints in 'Jac_nl_buf' and copies 
+   * them into the rows 'rows_idx' of 'Jac' */
+  bool eval_Jac_nonlinear_rows(double* x, bool new_x,
+			       long long num_rows, const long long* rows_idx, const long long* rows_mapping,
+			       hiopMatrixDense& Jac, hiopMatrix*& Jac_nl_buf);
 private:
   /* interface implemented and provided by the user */
   hiopInterfaceDenseConstraints& interface;
@@ -344,8 +439,8 @@ private:
 class hiopNlpMDS : public hiopNlpFormulation
 {
 public:
-  hiopNlpMDS(hiopInterfaceMDS& interface_)
-    : hiopNlpFormulation(interface_), interface(interface_)
+  hiopNlpMDS(hiopInterfaceMDS& interface_, const char* options_file=NULL)
+    : hiopNlpFormulation(interface_, options_file), interface(interface_)
   {
     _buf_lambda = LinearAlgebraFactory::createVector(0);
   }
@@ -362,7 +457,8 @@ public:
 
 protected:
   //calls specific hiopInterfaceXXX::eval_Jac_cons and deals with specializations of hiopMatrix arguments
-  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, hiopMatrix& Jac_c, hiopMatrix& Jac_d);
+  virtual bool eval_Jac_c_d_interface_impl(double* x, bool new_x, double* cons,
+					   hiopMatrix& Jac_c, hiopMatrix& Jac_d);
 public:
   virtual bool eval_Hess_Lagr(const double* x,
 			      bool new_x,
@@ -394,6 +490,12 @@ public:
   }
   virtual long long nx_sp() const { return nx_sparse; }
   virtual long long nx_de() const { return nx_dense; }
+private:
+  /* evaluates only the 'num_rows' Jacobian rows of nonlinear constraints in 'Jac_nl_buf' and copies 
+   * them into the rows 'rows_idx' of 'Jac' */
+  bool eval_Jac_nonlinear_rows(double* x, bool new_x,
+			       long long num_rows, const long long* rows_idx, const long long* rows_mapping,
+			       hiopMatrixMDS& Jac, hiopMatrix*& Jac_nl_buf);
 private:
   hiopInterfaceMDS& interface;
   int nx_sparse, nx_dense;
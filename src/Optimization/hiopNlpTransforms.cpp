@@ -48,6 +48,7 @@
 
 #include "hiopNlpTransforms.hpp"
 #include "hiopLinAlgFactory.hpp"
+#include "hiopCommProfiler.hpp"
 
 #include <cmath>
 namespace hiop
@@ -111,7 +112,7 @@ long long* hiopFixedVarsRemover::allocRSVectorDistrib()
   assert(nRanks==nlen-1);
 #endif
   //first gather on all ranks the number of variables fixed on each rank
-  ierr = MPI_Allgather(&n_fixed_vars_local, 1, MPI_LONG_LONG_INT, rsVecDistrib+1, 1, MPI_LONG_LONG_INT, comm);
+  ierr = hiopAllgather(&n_fixed_vars_local, 1, MPI_LONG_LONG_INT, rsVecDistrib+1, 1, MPI_LONG_LONG_INT, comm, "nlp_fixed_vars_distrib");
   assert(ierr==MPI_SUCCESS);
 #else
   assert(nlen==1);
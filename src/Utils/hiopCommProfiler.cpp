@@ -0,0 +1,204 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#include "hiopCommProfiler.hpp"
+
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+#include <algorithm>
+
+namespace hiop
+{
+
+hiopCommProfiler& hiopCommProfiler::global()
+{
+  //one profiler per thread so that solves running concurrently on different threads do not
+  //reset or record into each other's tables
+  static thread_local hiopCommProfiler prof;
+  return prof;
+}
+
+hiopCommProfiler::hiopCommProfiler()
+  : enabled_(false), per_rank_(false)
+{
+}
+
+void hiopCommProfiler::reset(bool enable, bool per_rank)
+{
+  entries_.clear();
+  enabled_ = enable;
+  per_rank_ = per_rank;
+  owner_ = std::this_thread::get_id();
+}
+
+void hiopCommProfiler::record(const char* tag, long long bytes, double tm)
+{
+  if(std::this_thread::get_id() != owner_) return;
+
+  //the tags are string literals, so the pointers are compared first
+  size_t i = 0;
+  for(; i<entries_.size(); i++) {
+    if(entries_[i].tag==tag) break;
+  }
+  if(i==entries_.size()) {
+    for(i=0; i<entries_.size(); i++) {
+      if(0==strcmp(entries_[i].tag, tag)) break;
+    }
+  }
+  if(i==entries_.size()) {
+    Entry e;
+    e.tag = tag;
+    e.calls = e.bytes = 0;
+    e.tm = 0.;
+    entries_.push_back(e);
+  }
+  entries_[i].calls++;
+  entries_[i].bytes += bytes;
+  entries_[i].tm += tm;
+}
+
+double hiopCommProfiler::get_total_time() const
+{
+  double tm = 0.;
+  for(const Entry& e : entries_) tm += e.tm;
+  return tm;
+}
+
+std::string hiopCommProfiler::get_report(MPI_Comm comm, double tm_total) const
+{
+  const size_t n = entries_.size();
+  std::vector<double> tm_min(n), tm_max(n), tm_avg(n);
+  for(size_t i=0; i<n; i++) tm_min[i] = tm_max[i] = tm_avg[i] = entries_[i].tm;
+
+  int nranks = 1;
+  bool consistent = true;
+#ifdef HIOP_USE_MPI
+  int ierr = MPI_Comm_size(comm, &nranks); assert(MPI_SUCCESS==ierr);
+
+  //the ranks issue the same collectives, so the tags should come in the same order on all ranks;
+  //this is checked via a hash of the tags
+  long long hash = (long long)n;
+  for(const Entry& e : entries_) {
+    for(const char* c=e.tag; *c; c++) hash = (hash*31 + *c) % 1000000007LL;
+  }
+  long long hash_min, hash_max;
+  ierr = MPI_Allreduce(&hash, &hash_min, 1, MPI_LONG_LONG, MPI_MIN, comm); assert(MPI_SUCCESS==ierr);
+  ierr = MPI_Allreduce(&hash, &hash_max, 1, MPI_LONG_LONG, MPI_MAX, comm); assert(MPI_SUCCESS==ierr);
+  consistent = hash_min==hash_max;
+
+  if(consistent && n>0) {
+    std::vector<double> loc(tm_min);
+    ierr = MPI_Allreduce(loc.data(), tm_min.data(), n, MPI_DOUBLE, MPI_MIN, comm); 
+    assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Allreduce(loc.data(), tm_max.data(), n, MPI_DOUBLE, MPI_MAX, comm); 
+    assert(MPI_SUCCESS==ierr);
+    ierr = MPI_Allreduce(loc.data(), tm_avg.data(), n, MPI_DOUBLE, MPI_SUM, comm); 
+    assert(MPI_SUCCESS==ierr);
+    for(size_t i=0; i<n; i++) tm_avg[i] /= nranks;
+  }
+  (void)ierr;
+#endif
+
+  std::vector<size_t> order(n);
+  for(size_t i=0; i<n; i++) order[i] = i;
+  std::sort(order.begin(), order.end(), 
+	    [&tm_max](size_t a, size_t b) { return tm_max[a] > tm_max[b]; });
+
+  std::string out;
+  char buf[256];
+  snprintf(buf, sizeof(buf), "Communication: %d rank(s)%s\n", nranks, 
+	   consistent ? "" : " [tags differ across ranks; times are of the local rank]");
+  out += buf;
+  snprintf(buf, sizeof(buf), "  %-28s %10s %12s %11s %11s %11s\n", "call site", "calls", "bytes", 
+	   "time_min", "time_avg", "time_max");
+  out += buf;
+  long long calls_total = 0, bytes_total = 0;
+  for(size_t k=0; k<n; k++) {
+    const Entry& e = entries_[order[k]];
+    snprintf(buf, sizeof(buf), "  %-28s %10lld %12lld %11.4e %11.4e %11.4e\n", e.tag, e.calls,
+	     e.bytes, tm_min[order[k]], tm_avg[order[k]], tm_max[order[k]]);
+    out += buf;
+    calls_total += e.calls;
+    bytes_total += e.bytes;
+  }
+  const double tm_comm = get_total_time();
+  snprintf(buf, sizeof(buf), "  %-28s %10lld %12lld   (local time %.4e sec)\n", "total", calls_total,
+	   bytes_total, tm_comm);
+  out += buf;
+
+  if(per_rank_) {
+    std::vector<double> ranks_tm(2*nranks);
+    ranks_tm[0] = tm_comm;
+    ranks_tm[1] = tm_total;
+#ifdef HIOP_USE_MPI
+    double loc[2] = {tm_comm, tm_total};
+    ierr = MPI_Allgather(loc, 2, MPI_DOUBLE, ranks_tm.data(), 2, MPI_DOUBLE, comm);
+    assert(MPI_SUCCESS==ierr);
+#endif
+    //the rank that waits the least in the collectives is the one the other ranks wait for
+    int straggler = 0;
+    for(int r=1; r<nranks; r++) if(ranks_tm[2*r] < ranks_tm[2*straggler]) straggler = r;
+
+    out += "Communication per rank (the rank waiting the least in the collectives is the slowest)\n";
+    snprintf(buf, sizeof(buf), "  %6s %11s %11s %11s\n", "rank", "time_comm", "time_other", 
+	     "comm_pct");
+    out += buf;
+    for(int r=0; r<nranks; r++) {
+      const double tm_c = ranks_tm[2*r], tm_t = ranks_tm[2*r+1];
+      snprintf(buf, sizeof(buf), "  %6d %11.4e %11.4e %10.1f%%%s\n", r, tm_c, tm_t-tm_c, 
+	       tm_t>0 ? 100.*tm_c/tm_t : 0., 
+	       (nranks>1 && r==straggler) ? "  <- least waiting" : "");
+      out += buf;
+    }
+  }
+  return out;
+}
+
+} //end namespace
@@ -0,0 +1,151 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#ifndef HIOP_COMM_PROFILER
+#define HIOP_COMM_PROFILER
+
+#include "hiopMPI.hpp"
+
+#include <vector>
+#include <string>
+#include <thread>
+
+namespace hiop
+{
+
+/* Profiler of the MPI collectives issued by HiOp.
+ *
+ * The collectives are issued via the hiopAllreduce/hiopAllgather wrappers below, each call site 
+ * passing a tag (a string literal) that identifies it. For each tag the profiler keeps the number
+ * of calls, the number of bytes contributed by this rank, and the time spent in the collective, 
+ * which, for the small reductions HiOp does, is mostly time spent waiting for the other ranks.
+ *
+ * The linear algebra objects do not have access to the NLP's run statistics, so global() returns
+ * a thread_local profiler: there is one per thread, not one per process, and solves running on
+ * different threads do not share it. It is enabled by the option 'time_comm' at the start of each
+ * solve and, like hiopProfiler, records only the calls made by the thread that enabled it.
+ * When disabled (default), the wrappers cost one branch over the plain MPI calls.
+ */
+class hiopCommProfiler
+{
+public:
+  //the profiler of the calling thread (thread_local, see the class comment)
+  static hiopCommProfiler& global();
+
+  //enables/disables the profiler and removes the calls recorded so far; 'per_rank' adds the
+  //communication time of each rank to the report
+  void reset(bool enable, bool per_rank=false);
+  inline bool is_enabled() const { return enabled_; }
+
+  //records one call of the collective tagged 'tag' (expected to be a string literal)
+  void record(const char* tag, long long bytes, double tm);
+
+  //total time spent in the recorded collectives by this rank
+  double get_total_time() const;
+
+  //returns the report of the recorded calls, with the times aggregated (min/avg/max) over the
+  //ranks of 'comm'; 'tm_total' is the time of the solve on this rank, used to report the time
+  //outside of the collectives in the per-rank report. Collective over 'comm'
+  std::string get_report(MPI_Comm comm, double tm_total) const;
+private:
+  struct Entry
+  {
+    const char* tag;
+    long long calls;
+    long long bytes;
+    double tm; //in seconds
+  };
+  std::vector<Entry> entries_;
+  bool enabled_;
+  bool per_rank_;
+  std::thread::id owner_;
+
+  hiopCommProfiler();
+  hiopCommProfiler(const hiopCommProfiler&);
+  hiopCommProfiler& operator=(const hiopCommProfiler&);
+};
+
+#ifdef HIOP_USE_MPI
+/* MPI_Allreduce recorded under 'tag' by the communication profiler */
+inline int hiopAllreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
+			 MPI_Op op, MPI_Comm comm, const char* tag)
+{
+  hiopCommProfiler& prof = hiopCommProfiler::global();
+  if(!prof.is_enabled()) return MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+
+  const double tm_start = MPI_Wtime();
+  int ierr = MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+  const double tm = MPI_Wtime() - tm_start;
+  int type_size;
+  MPI_Type_size(datatype, &type_size);
+  prof.record(tag, (long long)count*type_size, tm);
+  return ierr;
+}
+
+/* MPI_Allgather recorded under 'tag' by the communication profiler */
+inline int hiopAllgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+			 void* recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm, 
+			 const char* tag)
+{
+  hiopCommProfiler& prof = hiopCommProfiler::global();
+  if(!prof.is_enabled()) 
+    return MPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+
+  const double tm_start = MPI_Wtime();
+  int ierr = MPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  const double tm = MPI_Wtime() - tm_start;
+  int type_size;
+  MPI_Type_size(sendtype, &type_size);
+  prof.record(tag, (long long)sendcount*type_size, tm);
+  return ierr;
+}
+#endif
+
+} //end namespace
+#endif
@@ -12,6 +12,9 @@
 #include <numeric>
 #include <cassert>
 #include <math.h>
+#include <type_traits>
+
+#include "hiop_defs.hpp"
 
 namespace hiop {
   template<class T> inline void printvec(const std::vector<T>& v, const std::string& msg="") 
@@ -50,6 +53,19 @@ namespace hiop {
     std::vector<T>().swap(in); 
   }
 
+  /**
+   * Downcast of the reference 'b' to 'T' (a reference type) for objects that are known to be of
+   * the derived type, e.g., the vectors passed to the hiopVectorPar methods. It compiles to a 
+   * static_cast, with no RTTI lookup; the dynamic type is verified only in HIOP_DEEPCHECKS builds.
+   */
+  template<class T, class B> inline T known_cast(B& b)
+  {
+#ifdef HIOP_DEEPCHECKS
+    assert(NULL!=dynamic_cast<typename std::remove_reference<T>::type*>(&b) && "wrong dynamic type");
+#endif
+    return static_cast<T>(b);
+  }
+
   static inline std::string tolower(const std::string& str_in)
   {
     auto str_out = str_in;
@@ -0,0 +1,310 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopKKTCapture.hpp"
+
+#include "hiopNlpFormulation.hpp"
+#include "hiopMatrixDense.hpp"
+#include "hiopVector.hpp"
+
+#include <cstring>
+#include <cassert>
+
+namespace hiop
+{
+
+static const char kkt_capture_magic[8] = "HIOPKKT";
+static const int32_t kkt_capture_version = 1;
+
+hiopKKTCapture::hiopKKTCapture(hiopNlpFormulation* nlp)
+  : nlp_(nlp), f_(NULL), open_failed_(false)
+{
+  if(nlp_) write_kkt_ = nlp_->options->GetStringHandle("write_kkt");
+}
+
+hiopKKTCapture::~hiopKKTCapture()
+{
+  if(f_) fclose(f_);
+}
+
+bool hiopKKTCapture::open()
+{
+  if(f_) return true;
+  if(open_failed_) return false;
+#ifdef HIOP_USE_MPI
+  if(0 != nlp_->get_rank()) return false;
+#endif
+  const std::string fname = nlp_->options->GetString("write_kkt_file");
+  f_ = fopen(fname.c_str(), "wb");
+  if(NULL==f_) {
+    open_failed_ = true;
+    nlp_->log->printf(hovError, "Could not open '%s' for writing the KKT systems.\n", 
+		      fname.c_str());
+    return false;
+  }
+  fwrite(kkt_capture_magic, sizeof(char), 8, f_);
+  fwrite(&kkt_capture_version, sizeof(int32_t), 1, f_);
+  return true;
+}
+
+void hiopKKTCapture::write_matrix(int iter, const hiopMatrixDense& Msys, 
+				  double delta_wx, double delta_wd, double delta_cc, double delta_cd)
+{
+  if(!open()) return;
+  assert(Msys.m()==Msys.n());
+  const int64_t m = Msys.m();
+  double** M = Msys.local_data();
+  if(m>0 && NULL==M) return;
+
+  int64_t nnz = 0;
+  for(int64_t i=0; i<m; i++) for(int64_t j=i; j<m; j++) if(M[i][j]!=0.) nnz++;
+
+  const int32_t type = kktMat, iter32 = iter;
+  const double deltas[4] = {delta_wx, delta_wd, delta_cc, delta_cd};
+  //CSR needs 12 bytes per nonzero and 4 bytes per row, packed storage 8 bytes per entry
+  const double bytes_packed = 8.*m*(m+1)/2, bytes_csr = 12.*nnz + 4.*(m+1) + 8.;
+  const int32_t storage = (bytes_csr < bytes_packed && nnz < INT32_MAX) ? 1 : 0;
+
+  fwrite(&type, sizeof(int32_t), 1, f_);
+  fwrite(&iter32, sizeof(int32_t), 1, f_);
+  fwrite(&m, sizeof(int64_t), 1, f_);
+  fwrite(deltas, sizeof(double), 4, f_);
+  fwrite(&storage, sizeof(int32_t), 1, f_);
+  if(0==storage) {
+    for(int64_t i=0; i<m; i++) fwrite(M[i]+i, sizeof(double), m-i, f_);
+  } else {
+    fwrite(&nnz, sizeof(int64_t), 1, f_);
+    std::vector<int32_t> idx;
+    idx.reserve(m+1);
+    int32_t nnz_rows = 0;
+    idx.push_back(nnz_rows);
+    for(int64_t i=0; i<m; i++) {
+      for(int64_t j=i; j<m; j++) if(M[i][j]!=0.) nnz_rows++;
+      idx.push_back(nnz_rows);
+    }
+    fwrite(idx.data(), sizeof(int32_t), m+1, f_);
+    for(int64_t i=0; i<m; i++) {
+      idx.clear();
+      for(int64_t j=i; j<m; j++) if(M[i][j]!=0.) idx.push_back((int32_t)j);
+      fwrite(idx.data(), sizeof(int32_t), idx.size(), f_);
+    }
+    for(int64_t i=0; i<m; i++) 
+      for(int64_t j=i; j<m; j++) if(M[i][j]!=0.) fwrite(&M[i][j], sizeof(double), 1, f_);
+  }
+}
+
+void hiopKKTCapture::write_inertia(int n_neg_eig, int n_neg_eig_expected)
+{
+  if(NULL==f_) return;
+  const int32_t vals[3] = {kktInertia, n_neg_eig, n_neg_eig_expected};
+  fwrite(vals, sizeof(int32_t), 3, f_);
+}
+
+void hiopKKTCapture::write_vector(RecordType type, const hiopVector& v)
+{
+  if(NULL==f_) return;
+  const int32_t type32 = type;
+  const int64_t m = v.get_local_size();
+  fwrite(&type32, sizeof(int32_t), 1, f_);
+  fwrite(&m, sizeof(int64_t), 1, f_);
+  fwrite(v.local_data_const(), sizeof(double), m, f_);
+  if(kktSol==type) fflush(f_);
+}
+
+void hiopKKTCapturedSystem::copy_to(hiopMatrixDense& Mdest) const
+{
+  assert(Mdest.m()==m && Mdest.n()==m);
+  double** M = Mdest.local_data();
+  const double* u = upper.data();
+  //the strictly lower triangle is not referenced by the solvers and it is not stored by 
+  //hiopMatrixSymDensePacked, so it is not written
+  for(long long i=0; i<m; i++) {
+    memcpy(M[i]+i, u, (m-i)*sizeof(double));
+    u += m-i;
+  }
+}
+
+void hiopKKTCapturedSystem::times_vec(const double* x, double* y) const
+{
+  for(long long i=0; i<m; i++) y[i] = 0.;
+  const double* u = upper.data();
+  for(long long i=0; i<m; i++) {
+    //diagonal entry and then the strictly upper part of row i (= strictly lower part of column i)
+    double yi = u[0]*x[i];
+    for(long long j=i+1; j<m; j++) {
+      yi += u[j-i]*x[j];
+      y[j] += u[j-i]*x[i];
+    }
+    y[i] += yi;
+    u += m-i;
+  }
+}
+
+hiopKKTCaptureReader::hiopKKTCaptureReader()
+  : f_(NULL), next_type_(0), corrupted_(false)
+{
+}
+
+hiopKKTCaptureReader::~hiopKKTCaptureReader()
+{
+  if(f_) fclose(f_);
+}
+
+bool hiopKKTCaptureReader::open(const char* filename)
+{
+  if(f_) fclose(f_);
+  f_ = fopen(filename, "rb");
+  if(NULL==f_) return false;
+  char magic[8];
+  int32_t version;
+  if(8!=fread(magic, sizeof(char), 8, f_) || 0!=memcmp(magic, kkt_capture_magic, 8) ||
+     1!=fread(&version, sizeof(int32_t), 1, f_) || version!=kkt_capture_version) {
+    fclose(f_);
+    f_ = NULL;
+    return false;
+  }
+  corrupted_ = false;
+  read_type();
+  return true;
+}
+
+bool hiopKKTCaptureReader::read_type()
+{
+  if(1!=fread(&next_type_, sizeof(int32_t), 1, f_)) {
+    next_type_ = 0;
+    return false;
+  }
+  return true;
+}
+
+bool hiopKKTCaptureReader::read_next(hiopKKTCapturedSystem& sys)
+{
+  if(NULL==f_ || next_type_!=hiopKKTCapture::kktMat) {
+    corrupted_ = corrupted_ || (f_!=NULL && next_type_!=0);
+    return false;
+  }
+  int32_t iter32, storage;
+  int64_t m;
+  double deltas[4];
+  if(1!=fread(&iter32, sizeof(int32_t), 1, f_) || 1!=fread(&m, sizeof(int64_t), 1, f_) || 
+     4!=fread(deltas, sizeof(double), 4, f_) || 1!=fread(&storage, sizeof(int32_t), 1, f_) || 
+     m<0) {
+    corrupted_ = true;
+    return false;
+  }
+  sys.iter = iter32;
+  sys.m = m;
+  sys.delta_wx = deltas[0]; sys.delta_wd = deltas[1]; sys.delta_cc = deltas[2]; sys.delta_cd = deltas[3];
+  sys.n_neg_eig = sys.n_neg_eig_expected = -2;
+  sys.rhs.clear();
+  sys.sol.clear();
+  sys.upper.assign(m*(m+1)/2, 0.);
+
+  if(0==storage) {
+    if((size_t)(m*(m+1)/2) != fread(sys.upper.data(), sizeof(double), m*(m+1)/2, f_)) {
+      corrupted_ = true;
+      return false;
+    }
+  } else {
+    int64_t nnz;
+    if(1!=fread(&nnz, sizeof(int64_t), 1, f_) || nnz<0) {
+      corrupted_ = true;
+      return false;
+    }
+    std::vector<int32_t> rowptr(m+1), colidx(nnz);
+    std::vector<double> vals(nnz);
+    if((size_t)(m+1)!=fread(rowptr.data(), sizeof(int32_t), m+1, f_) ||
+       (size_t)nnz!=fread(colidx.data(), sizeof(int32_t), nnz, f_) ||
+       (size_t)nnz!=fread(vals.data(), sizeof(double), nnz, f_) || rowptr[m]!=nnz) {
+      corrupted_ = true;
+      return false;
+    }
+    //offset of row i in the packed storage is i*m - i*(i-1)/2, and of (i,j) is that plus j-i
+    for(int64_t i=0; i<m; i++) {
+      const int64_t row_offset = i*m - i*(i-1)/2;
+      for(int32_t k=rowptr[i]; k<rowptr[i+1]; k++) {
+	if(colidx[k]<i || colidx[k]>=m) {
+	  corrupted_ = true;
+	  return false;
+	}
+	sys.upper[row_offset + colidx[k]-i] = vals[k];
+      }
+    }
+  }
+
+  //inertia, rhs, and sol records until the next matrix or the end of the file
+  while(read_type() && next_type_!=hiopKKTCapture::kktMat) {
+    if(next_type_==hiopKKTCapture::kktInertia) {
+      int32_t vals[2];
+      if(2!=fread(vals, sizeof(int32_t), 2, f_)) {
+	corrupted_ = true;
+	return false;
+      }
+      sys.n_neg_eig = vals[0];
+      sys.n_neg_eig_expected = vals[1];
+    } else if(next_type_==hiopKKTCapture::kktRhs || next_type_==hiopKKTCapture::kktSol) {
+      int64_t n;
+      if(1!=fread(&n, sizeof(int64_t), 1, f_) || n!=m) {
+	corrupted_ = true;
+	return false;
+      }
+      std::vector<std::vector<double> >& dest = next_type_==hiopKKTCapture::kktRhs ? sys.rhs : sys.sol;
+      dest.push_back(std::vector<double>(n));
+      if((size_t)n!=fread(dest.back().data(), sizeof(double), n, f_)) {
+	corrupted_ = true;
+	return false;
+      }
+    } else {
+      corrupted_ = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end namespace
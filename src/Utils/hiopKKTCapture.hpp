@@ -0,0 +1,152 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_KKT_CAPTURE
+#define HIOP_KKT_CAPTURE
+
+#include "hiopOptions.hpp"
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hiop
+{
+class hiopNlpFormulation;
+class hiopMatrixDense;
+class hiopVector;
+
+/* Binary capture of the (dense) KKT linear systems solved during an optimization run.
+ *
+ * Active when the option 'write_kkt' is 'binary'. All the systems of a run are written in one 
+ * file, named by the option 'write_kkt_file' (default 'kkt_capture.hkkt'), as a sequence of
+ * records, in the native byte order:
+ *
+ *  file header: char[8] "HIOPKKT" (zero terminated), int32 version
+ *  record:      int32 type, followed by the payload of the type
+ *   - kktMat:     int32 iteration, int64 m, 4 x double perturbations (delta_wx, delta_wd, 
+ *                 delta_cc, delta_cd), int32 storage, and then
+ *                   storage 0: the upper triangle packed by rows, m(m+1)/2 doubles
+ *                   storage 1: the nonzeros of the upper triangle in CSR format: int64 nnz, 
+ *                              int32 row pointers[m+1], int32 column indexes[nnz], double[nnz]
+ *                 the storage with the smaller size is chosen for each matrix
+ *   - kktInertia: int32 number of negative eigenvalues returned by the factorization (-1 when
+ *                 the matrix was detected as singular), int32 expected number
+ *   - kktRhs, kktSol: int64 m, m x double
+ *
+ * Each kktMat record is written before the matrix is factorized and is followed by its 
+ * kktInertia record and by a kktRhs and kktSol pair for each solve with the factorization.
+ * Only the master rank writes.
+ */
+class hiopKKTCapture
+{
+public:
+  enum RecordType { kktMat=1, kktInertia=2, kktRhs=3, kktSol=4 };
+
+  hiopKKTCapture(hiopNlpFormulation* nlp);
+  virtual ~hiopKKTCapture();
+
+  //true when the option 'write_kkt' is 'binary'
+  inline bool is_on() const { return write_kkt_.is_valid() && *write_kkt_=="binary"; }
+
+  void write_matrix(int iter, const hiopMatrixDense& M, 
+		    double delta_wx, double delta_wd, double delta_cc, double delta_cd);
+  void write_inertia(int n_neg_eig, int n_neg_eig_expected);
+  void write_rhs(const hiopVector& rhs) { write_vector(kktRhs, rhs); }
+  void write_sol(const hiopVector& sol) { write_vector(kktSol, sol); }
+protected:
+  bool open();
+  void write_vector(RecordType type, const hiopVector& v);
+protected:
+  hiopNlpFormulation* nlp_;
+  hiopOptions::Handle<std::string> write_kkt_;
+  FILE* f_;
+  bool open_failed_;
+};
+
+/* One captured KKT system, as read back by hiopKKTCaptureReader */
+struct hiopKKTCapturedSystem
+{
+  int iter;
+  long long m;
+  double delta_wx, delta_wd, delta_cc, delta_cd;
+  //upper triangle of the matrix packed by rows
+  std::vector<double> upper;
+  int n_neg_eig, n_neg_eig_expected;
+  //right-hand sides and the corresponding solutions computed during the optimization run
+  std::vector<std::vector<double> > rhs, sol;
+
+  //sets the upper triangle of (the m x m) 'M'; the strictly lower triangle is not written
+  void copy_to(hiopMatrixDense& M) const;
+  //y = this * x, with the matrix being symmetric
+  void times_vec(const double* x, double* y) const;
+};
+
+/* Reads the systems of a file written by hiopKKTCapture, one at a time */
+class hiopKKTCaptureReader
+{
+public:
+  hiopKKTCaptureReader();
+  virtual ~hiopKKTCaptureReader();
+
+  //returns false if the file cannot be opened or does not have the expected header
+  bool open(const char* filename);
+  //reads the next system; returns false at the end of the file or if the file is corrupted
+  bool read_next(hiopKKTCapturedSystem& sys);
+  //true if read_next stopped because of a malformed record
+  inline bool corrupted() const { return corrupted_; }
+private:
+  FILE* f_;
+  int32_t next_type_;
+  bool corrupted_;
+  bool read_type();
+};
+
+} // end namespace
+#endif
@@ -54,6 +54,8 @@
 #include "hiopFilter.hpp"
 #include "hiopOptions.hpp"
 
+#include <cstring>
+
 namespace hiop
 {
 
@@ -63,8 +65,8 @@ void hiopLogger::write(const char* msg, const hiopVector& vec, hiopOutVerbosity
   //#ifdef HIOP_USE_MPI
   //if(_master_rank != _nlp->get_rank()) return;
   //#endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   vec.print(_f, msg);
 }
 
@@ -73,8 +75,8 @@ void hiopLogger::write(const char* msg, const hiopMatrix& M, hiopOutVerbosity v,
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   M.print(_f, msg);
 }
 
@@ -83,8 +85,8 @@ void hiopLogger::write(const char* msg, const hiopResidual& r, hiopOutVerbosity
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   r.print(_f,msg);
 }
 void hiopLogger::write(const char* msg, hiopOutVerbosity v, int loggerid/*=0*/) 
@@ -92,9 +94,9 @@ void hiopLogger::write(const char* msg, hiopOutVerbosity v, int loggerid/*=0*/)
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
-  fprintf(_f, "%s\n", msg); 
+  if(msg) emit(msg, strlen(msg));
+  emit("\n", 1);
 }
 
 void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity v, int loggerid/*=0*/)
@@ -102,8 +104,8 @@ void hiopLogger::write(const char* msg, const hiopIterate& it, hiopOutVerbosity
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   it.print(_f, msg);
 }
 
@@ -113,8 +115,8 @@ void hiopLogger::write(const char* msg, const hiopHessianLowRank& Hess, hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   Hess.print(_f, v, msg);
 }
 #endif
@@ -124,8 +126,8 @@ void hiopLogger::write(const char* msg, const hiopOptions& options,     hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   options.print(_f, msg);
 }
 
@@ -134,8 +136,8 @@ void hiopLogger::write(const char* msg, const hiopNlpFormulation& nlp,  hiopOutV
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   nlp.print(_f, msg);
 }
 
@@ -144,41 +146,158 @@ void hiopLogger::write(const char* msg, const hiopFilter& filt, hiopOutVerbosity
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
+  drain();
   filt.print(_f, msg);
 }
 
-  //only for loggerid=0 for now
+//only for loggerid=0 for now
 void hiopLogger::printf(hiopOutVerbosity v, const char* format, ...)
 {
 #ifdef HIOP_USE_MPI
   if(_master_rank != _nlp->get_rank()) return;
 #endif
-  hiopOutVerbosity _verb = (hiopOutVerbosity) _nlp->options->GetInteger("verbosity_level");
   if(v>_verb) return;
 
-  char label[16];label[0]='\0';
-  if(v==hovError) strcpy(label, "[Error] ");
-  else if(v==hovWarning) strcpy(label, "[Warning] ");
-  fprintf(_f, "%s", label);
+  if(v==hovError) emit("[Error] ", 8);
+  else if(v==hovWarning) emit("[Warning] ", 10);
 
-  va_list args;
-  va_start (args, format);
-  vsprintf (_buff,format, args);
-  fprintf(_f,"%s",_buff);
-  va_end (args);
+  va_list args, args2;
+  va_start(args, format);
+  va_copy(args2, args);
+  int len = vsnprintf(_buff, sizeof(_buff), format, args);
+  va_end(args);
+  if(len>=0 && (size_t)len<sizeof(_buff)) {
+    emit(_buff, len);
+  } else if(len>0) {
+    //message does not fit in _buff; format it in a heap buffer of the exact size
+    std::string str(len+1, '\0');
+    vsnprintf(&str[0], str.size(), format, args2);
+    emit(str.c_str(), len);
+  }
+  va_end(args2);
 
-};
+  //errors and warnings are not held back in the buffer
+  if(v<=hovWarning) drain();
+}
 
 void hiopLogger::printf_error(hiopOutVerbosity v, const char* format, ...)
 {
-  char buff[1024];
   va_list args;
   va_start (args, format);
-  vsprintf (buff,format, args);
-  fprintf(stderr,"%s",buff);
+  vfprintf(stderr, format, args);
   va_end (args);
-};
+}
+
+hiopLogger::hiopLogger(hiopNlpFormulation* nlp, FILE* f, int masterrank/*=0*/)
+  : _f(f), _nlp(nlp), _verb(hovSummary), _mode(omDirect), 
+    _worker_busy(false), _worker_stop(false), _master_rank(masterrank)
+{
+}
+
+hiopLogger::~hiopLogger()
+{
+  flush();
+  stop_worker();
+}
+
+void hiopLogger::set_output_mode(const std::string& mode)
+{
+  OutputMode new_mode = omDirect;
+  if(mode=="buffered") new_mode = omBuffered;
+  else if(mode=="async") new_mode = omAsync;
+  if(new_mode==_mode) return;
+
+  drain();
+  stop_worker();
+  _mode = new_mode;
+  if(_mode==omAsync) {
+    _worker_stop = false;
+    _worker = std::thread(&hiopLogger::async_worker, this);
+  }
+}
+
+//size of the pending text that triggers a write in the buffered and async modes
+#define HIOP_LOG_CHUNK (1<<16)
+
+void hiopLogger::emit(const char* msg, size_t len)
+{
+  if(omDirect==_mode) {
+    fwrite(msg, 1, len, _f);
+  } else if(omBuffered==_mode) {
+    _pending.append(msg, len);
+    if(_pending.size()>=HIOP_LOG_CHUNK) write_pending();
+  } else {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _pending.append(msg, len);
+    if(_pending.size()>=HIOP_LOG_CHUNK) _cv_work.notify_one();
+  }
+}
+
+void hiopLogger::write_pending()
+{
+  if(!_pending.empty()) {
+    fwrite(_pending.data(), 1, _pending.size(), _f);
+    _pending.clear();
+  }
+}
+
+void hiopLogger::drain()
+{
+  if(omAsync==_mode) {
+    std::unique_lock<std::mutex> lock(_mtx);
+    if(!_pending.empty()) _cv_work.notify_one();
+    _cv_done.wait(lock, [this]{ return _pending.empty() && !_worker_busy; });
+  } else {
+    write_pending();
+  }
+}
+
+void hiopLogger::flush()
+{
+  drain();
+  fflush(_f);
+}
+
+void hiopLogger::set_output_file(FILE* f)
+{
+  flush();
+  //the async writer is idle after the flush; the lock orders the update before its next write
+  std::lock_guard<std::mutex> lock(_mtx);
+  _f = f;
+}
+
+void hiopLogger::async_worker()
+{
+  std::string chunk;
+  std::unique_lock<std::mutex> lock(_mtx);
+  while(true) {
+    _cv_work.wait(lock, [this]{ return _worker_stop || !_pending.empty(); });
+    if(_pending.empty()) {
+      if(_worker_stop) break;
+      continue;
+    }
+    chunk.swap(_pending);
+    _worker_busy = true;
+    lock.unlock();
+    fwrite(chunk.data(), 1, chunk.size(), _f);
+    chunk.clear();
+    lock.lock();
+    _worker_busy = false;
+    _cv_done.notify_all();
+  }
+}
+
+void hiopLogger::stop_worker()
+{
+  if(!_worker.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _worker_stop = true;
+  }
+  _cv_work.notify_one();
+  _worker.join();
+  write_pending();
+}
 
 };
@@ -53,6 +53,10 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace hiop
 {
@@ -86,9 +90,14 @@ enum hiopOutVerbosity {
 class hiopLogger
 {
 public:
-  hiopLogger(hiopNlpFormulation* nlp, FILE* f, int masterrank=0) 
-    : _f(f), _nlp(nlp),  _master_rank(masterrank) {};
-  virtual ~hiopLogger() {};
+  /* Output modes of the logger: 'direct' writes each message to the FILE* right away, 'buffered' 
+   * accumulates messages in memory and writes them in large chunks, while 'async' hands the 
+   * accumulated chunks to a background thread that performs the actual writing.
+   */
+  enum OutputMode { omDirect=0, omBuffered, omAsync };
+
+  hiopLogger(hiopNlpFormulation* nlp, FILE* f, int masterrank=0);
+  virtual ~hiopLogger();
   /* outputs a vector. loggerid indicates which logger should be used, by default stdout*/
   void write(const char* msg, const hiopVector& vec,          hiopOutVerbosity v, int loggerid=0);
   void write(const char* msg, const hiopResidual& r,          hiopOutVerbosity v, int loggerid=0);
@@ -109,10 +118,46 @@ public:
    */
   static void printf_error(hiopOutVerbosity v, const char* format, ...); 
 
+  /* Returns true if messages of verbosity 'v' are to be output. Callers on hot paths can use it 
+   * to skip computing quantities that are only needed for logging.
+   */
+  inline bool is_active(hiopOutVerbosity v) const { return v<=_verb; }
+
+  /* Cached value of the 'verbosity_level' option; kept up-to-date by hiopOptions */
+  inline void set_verbosity(int v) { _verb = (hiopOutVerbosity) v; }
+  inline hiopOutVerbosity get_verbosity() const { return _verb; }
+
+  /* Sets the output mode from the value of the 'log_output' option (direct, buffered, or async) */
+  void set_output_mode(const std::string& mode);
+
+  /* Writes out all the buffered messages and flushes the underlying FILE* */
+  void flush();
+
+  /* Redirects the output to 'f' (stdout by default), after flushing the messages so far to the
+   * current FILE*. Solvers running concurrently in the same process should each have their own.
+   */
+  void set_output_file(FILE* f);
+protected:
+  /* appends 'len' characters of 'msg' to the output, according to the output mode */
+  void emit(const char* msg, size_t len);
+  void write_pending();
+  /* writes out the pending messages (and waits for the background writer in async mode) */
+  void drain();
+  void async_worker();
+  void stop_worker();
 protected:
   FILE* _f;
   char _buff[1024];
   hiopNlpFormulation* _nlp;
+  hiopOutVerbosity _verb;
+  OutputMode _mode;
+  //messages not yet written to _f (buffered and async modes)
+  std::string _pending;
+  //async mode: background writer thread and its synchronization
+  std::thread _worker;
+  std::mutex _mtx;
+  std::condition_variable _cv_work, _cv_done;
+  bool _worker_busy, _worker_stop;
 private:
   int _master_rank;
 };
@@ -0,0 +1,145 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#include "hiopMemTracker.hpp"
+
+#include <cstdio>
+
+namespace hiop
+{
+
+hiopMemTracker& hiopMemTracker::global()
+{
+  hiopMemTracker* tracker = thread_tracker();
+  if(NULL==tracker) {
+    //one tracker per thread so that solves running concurrently on different threads do not
+    //reset each other's peaks and limit
+    static thread_local hiopMemTracker thread_own;
+    tracker = thread_tracker() = &thread_own;
+  }
+  return *tracker;
+}
+
+hiopMemTracker*& hiopMemTracker::thread_tracker()
+{
+  static thread_local hiopMemTracker* tracker = NULL;
+  return tracker;
+}
+
+hiopMemCategory& hiopMemTracker::thread_category()
+{
+  static thread_local hiopMemCategory cat = hiopMemOther;
+  return cat;
+}
+
+hiopMemCategory hiopMemTracker::current_category()
+{
+  return thread_category();
+}
+
+const char* hiopMemTracker::category_name(hiopMemCategory c)
+{
+  switch(c) {
+  case hiopMemIterate:  return "iterate";
+  case hiopMemKKT:      return "kkt";
+  case hiopMemJacobian: return "jacobians";
+  case hiopMemHessian:  return "hessian";
+  case hiopMemLowRank:  return "lowrank";
+  default:              return "other";
+  }
+}
+
+hiopMemTracker::hiopMemTracker()
+  : total_curr_(0), total_peak_(0), limit_(0), failed_request_(0), limit_exceeded_(false)
+{
+  for(int c=0; c<hiopMemNumCategories; c++) {
+    cat_curr_[c] = 0;
+    cat_peak_[c] = 0;
+  }
+}
+
+void hiopMemTracker::reset(long long limit_bytes)
+{
+  limit_ = limit_bytes;
+  limit_exceeded_ = false;
+  failed_request_ = 0;
+  for(int c=0; c<hiopMemNumCategories; c++) cat_peak_[c] = cat_curr_[c].load();
+  total_peak_ = total_curr_.load();
+  if(limit_>0 && total_curr_>limit_) limit_exceeded_ = true;
+}
+
+bool hiopMemTracker::fits(long long bytes)
+{
+  if(limit_<=0 || total_curr_+bytes<=limit_) return true;
+  update_peak(failed_request_, bytes);
+  limit_exceeded_ = true;
+  return false;
+}
+
+std::string hiopMemTracker::get_report() const
+{
+  const double MB = 1024.*1024.;
+  char buf[256];
+  snprintf(buf, sizeof(buf), "Memory of the linear algebra objects: peak %.3f MB  current %.3f MB", 
+	   total_peak_/MB, total_curr_/MB);
+  std::string out(buf);
+  if(limit_>0) {
+    snprintf(buf, sizeof(buf), "  limit %.3f MB", limit_/MB);
+    out += buf;
+  }
+  out += "\n    peak by category:";
+  for(int c=0; c<hiopMemNumCategories; c++) {
+    snprintf(buf, sizeof(buf), " %s %.3f MB", category_name((hiopMemCategory)c), cat_peak_[c]/MB);
+    out += buf;
+  }
+  out += "\n";
+  return out;
+}
+
+} //end namespace
@@ -0,0 +1,196 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#ifndef HIOP_MEM_TRACKER
+#define HIOP_MEM_TRACKER
+
+#include <atomic>
+#include <string>
+
+namespace hiop
+{
+
+/* Categories of the memory allocated by the linear algebra objects */
+enum hiopMemCategory
+{
+  hiopMemOther=0,
+  hiopMemIterate,   //iterates, search directions, and residuals
+  hiopMemKKT,       //KKT linear systems, including the (dense) matrices of the linear solvers
+  hiopMemJacobian,  //Jacobians of the constraints
+  hiopMemHessian,   //Hessian of the Lagrangian
+  hiopMemLowRank,   //buffers of the quasi-Newton (low-rank) Hessian
+  hiopMemNumCategories
+};
+
+/* Accounting of the memory allocated by the linear algebra objects (vectors, dense and sparse 
+ * matrices).
+ *
+ * The objects record their storage, at construction, under the category that is current for
+ * the calling thread, as set by hiopMemScope, and remove it at destruction from the same tracker,
+ * which they keep, even when another thread destroys them. The tracker keeps the 
+ * current and the peak bytes of each category and in total. As the communication profiler, there
+ * is one tracker per thread, so solves running at the same time on different threads of a process
+ * are accounted separately and each has its own 'mem_limit'. Helper threads of a solve (e.g., the 
+ * asynchronous Hessian evaluation) record into the tracker of the solve via hiopMemTrackerScope.
+ *
+ * An optional limit (option 'mem_limit') is checked against the total: allocations that go over 
+ * the limit, and requests checked via 'fits' that would go over it, set a flag the solver checks
+ * to stop with a clear message instead of running out of memory later.
+ */
+class hiopMemTracker
+{
+public:
+  //the tracker of the calling thread, or the one set by the innermost hiopMemTrackerScope
+  static hiopMemTracker& global();
+
+  //category of the allocations of the calling thread
+  static hiopMemCategory current_category();
+  static const char* category_name(hiopMemCategory c);
+
+  inline void add(hiopMemCategory c, long long bytes)
+  {
+    update_peak(cat_peak_[c], cat_curr_[c] += bytes);
+    const long long total = total_curr_ += bytes;
+    update_peak(total_peak_, total);
+    if(limit_>0 && total>limit_) limit_exceeded_ = true;
+  }
+  inline void remove(hiopMemCategory c, long long bytes)
+  {
+    cat_curr_[c] -= bytes;
+    total_curr_ -= bytes;
+  }
+
+  //sets the limit on the total bytes (0 for no limit), clears the exceeded flag, and resets the
+  //peaks to the current values
+  void reset(long long limit_bytes);
+
+  //returns true if 'bytes' more can be allocated without exceeding the limit; otherwise sets 
+  //the exceeded flag and returns false
+  bool fits(long long bytes);
+  inline bool limit_exceeded() const { return limit_exceeded_; }
+  inline long long get_limit() const { return limit_; }
+
+  inline long long get_current() const { return total_curr_; }
+  inline long long get_peak() const { return total_peak_; }
+  inline long long get_current(hiopMemCategory c) const { return cat_curr_[c]; }
+  inline long long get_peak(hiopMemCategory c) const { return cat_peak_[c]; }
+  //largest request checked by 'fits' that did not fit; 0 if none
+  inline long long get_failed_request() const { return failed_request_; }
+
+  //peak and current totals and the peak of each category, in MB
+  std::string get_report() const;
+private:
+  std::atomic<long long> cat_curr_[hiopMemNumCategories], cat_peak_[hiopMemNumCategories];
+  std::atomic<long long> total_curr_, total_peak_;
+  std::atomic<long long> limit_;
+  std::atomic<long long> failed_request_;
+  std::atomic<bool> limit_exceeded_;
+
+  static inline void update_peak(std::atomic<long long>& peak, long long val)
+  {
+    long long prev = peak;
+    while(val>prev && !peak.compare_exchange_weak(prev, val)) {}
+  }
+
+  friend class hiopMemScope;
+  friend class hiopMemTrackerScope;
+  static hiopMemCategory& thread_category();
+  static hiopMemTracker*& thread_tracker();
+
+  hiopMemTracker();
+  hiopMemTracker(const hiopMemTracker&);
+  hiopMemTracker& operator=(const hiopMemTracker&);
+};
+
+/* Scoped category: the linear algebra objects created by the calling thread while the scope is
+ * alive are recorded under 'c'. Scopes can be nested; the innermost one wins.
+ */
+class hiopMemScope
+{
+public:
+  hiopMemScope(hiopMemCategory c)
+    : prev_(hiopMemTracker::thread_category())
+  {
+    hiopMemTracker::thread_category() = c;
+  }
+  ~hiopMemScope()
+  {
+    hiopMemTracker::thread_category() = prev_;
+  }
+private:
+  hiopMemCategory prev_;
+
+  hiopMemScope(const hiopMemScope&);
+  hiopMemScope& operator=(const hiopMemScope&);
+};
+
+/* Scoped tracker: the calling thread records into 'tracker' while the scope is alive. Used by the
+ * helper threads of a solve to record into the tracker of the thread running the solve.
+ */
+class hiopMemTrackerScope
+{
+public:
+  hiopMemTrackerScope(hiopMemTracker& tracker)
+    : prev_(hiopMemTracker::thread_tracker())
+  {
+    hiopMemTracker::thread_tracker() = &tracker;
+  }
+  ~hiopMemTrackerScope()
+  {
+    hiopMemTracker::thread_tracker() = prev_;
+  }
+private:
+  hiopMemTracker* prev_;
+
+  hiopMemTrackerScope(const hiopMemTrackerScope&);
+  hiopMemTrackerScope& operator=(const hiopMemTrackerScope&);
+};
+
+} //end namespace
+#endif
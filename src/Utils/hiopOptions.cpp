@@ -106,6 +106,15 @@ string hiopOptions::GetString (const char* name) const
   return option->val;
 }
 
+hiopOptions::Handle<std::string> hiopOptions::GetStringHandle(const char* name) const
+{
+  map<std::string, _O*>::const_iterator it = mOptions.find(name);
+  assert(it!=mOptions.end());
+  _OStr* option = dynamic_cast<_OStr*>(it->second);
+  assert(option!=NULL);
+  return Handle<std::string>(&option->val);
+}
+
 void hiopOptions::registerOptions()
 {
   // TODO: add option for mu_target
@@ -143,6 +152,15 @@ void hiopOptions::registerOptions()
     registerStrOption("dualsInitialization", "lsq", range, 
 		      "Type of update of the multipliers of the eq. cons. (default lsq)");
   }
+  {
+    vector<string> range(3); range[0]="fact"; range[1]="reuse_fact"; range[2]="cg";
+    registerStrOption("duals_lsq_solve", range[0], range,
+		      "Solution of the linear system of the lsq update of the multipliers: 'fact' forms and "
+		      "factorizes J*J^T at each update (default); 'reuse_fact' uses matrix-free PCG "
+		      "preconditioned with the last Cholesky factors of J*J^T, which are recomputed only when "
+		      "PCG does not converge quickly; 'cg' uses matrix-free unpreconditioned CG and falls back "
+		      "to 'fact' when CG does not converge");
+  }
 
   registerIntOption("max_iter", 3000, 1, 1e6, "Max number of iterations (default 3000)");
 
@@ -175,6 +193,14 @@ void hiopOptions::registerOptions()
 		    "Verbosity level: 0 no output (only errors), 1=0+warnings, 2=1 (reserved), "
 		    "3=2+optimization output, 4=3+scalars; larger values explained in hiopLogger.hpp"); 
 
+  {
+    vector<string> range(3); range[0]="direct"; range[1]="buffered"; range[2]="async";
+    registerStrOption("log_output", range[0], range,
+		      "How output is written: 'direct' writes each message as it is issued, 'buffered' "
+		      "accumulates messages in memory and writes them in large chunks, 'async' hands "
+		      "the chunks to a background writer thread (default 'direct')");
+  }
+
   {
     vector<string> range(3); range[0]="remove"; range[1]="relax"; range[2]="none";
     registerStrOption("fixed_var", "none", range, 
@@ -216,6 +242,20 @@ void hiopOptions::registerOptions()
 		      "'forcequick'=rely on faster solvers on all situations "
 		      "(experimental, avoid)");
   }
+  {
+    vector<string> range(2); range[0]="full"; range[1]="packed";
+    registerStrOption("kkt_dense_storage", range[0], range,
+		      "storage of the dense KKT matrices factorized with Lapack: 'full' n x n, or "
+		      "'packed' upper triangle only, which halves the memory and the zeroing cost "
+		      "but uses the unblocked dsptrf factorization (default 'full')");
+  }
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("kkt_dense_mds", range[0], range,
+		      "solve the KKT systems of mixed dense-sparse (MDS) problems with the dense "
+		      "XYcYd or XDYcYd linear systems (see 'KKTLinsys'), which hold the whole KKT "
+		      "matrix as dense; meant for testing the dense linear systems (default 'no')");
+  }
 
   //computations
   {
@@ -258,13 +298,91 @@ void hiopOptions::registerOptions()
     registerStrOption("time_kkt", "off", range,
 		      "turn on/off performance timers and reporting of the computational constituents of the "
 		      "KKT solve process");
+    registerStrOption("time_regions", "off", range,
+		      "turn on/off the hierarchical profiler of the solver's regions (iterations, KKT "
+		      "update and solve, line search, function evaluations, etc.) and its tree report "
+		      "(calls, inclusive and exclusive times) at the end of the solve");
+    registerStrOption("time_kkt_counters", "off", range,
+		      "turn on/off the hardware counters (cycles, instructions, cache misses) of the "
+		      "phases of the KKT solve reported at the end of the solve; only the calling "
+		      "thread is counted, not the threads of a multithreaded BLAS; turned off if the "
+		      "counters are not available (Linux perf_event_open)");
+  }
+  {
+    vector<string> range(3); range[0]="off"; range[1]="on"; range[2]="ranks";
+    registerStrOption("time_comm", range[0], range,
+		      "profiling of the MPI collectives: 'on' reports the calls, bytes, and time (min, "
+		      "avg, max over the ranks) of each call site at the end of the solve; 'ranks' "
+		      "also reports the communication time of each rank to expose load imbalance "
+		      "(default 'off')");
+  }
+  registerNumOption("mem_limit", 0., 0., 1e+12,
+		    "limit, in MB per rank, on the memory of the linear algebra objects (vectors, "
+		    "matrices, and the dense KKT systems); the solver stops with an error as soon as "
+		    "the limit is exceeded or an allocation of a KKT system would exceed it (default 0, "
+		    "i.e., no limit)");
+  {
+    vector<string> range(2); range[0]="yes"; range[1]="no";
+    registerStrOption("mem_pool", range[0], range,
+		      "take the storage of the solver's vectors and dense matrices from a pool of "
+		      "64-byte aligned blocks that caches and reuses freed blocks of the same size; the "
+		      "pool is released with the solver (default 'yes')");
+    range[0]="no"; range[1]="yes";
+    registerStrOption("mem_pool_huge_pages", range[0], range,
+		      "align the blocks of 2MB or more of the memory pool at 2MB and advise them as "
+		      "transparent huge pages (Linux only; default 'no')");
+    registerStrOption("mem_kkt_interleave", range[0], range,
+		      "interleave the pages of the dense KKT matrices over the NUMA nodes instead of "
+		      "placing them on the node of the thread that first touches them (Linux only; "
+		      "default 'no')");
   }
 
-  //other options
+  //evaluation of the derivatives
+  {
+    vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("cache_linear_jac", range[0], range,
+		      "evaluate the Jacobian rows of the constraints flagged as 'hiopLinear' only once "
+		      "and reuse them at subsequent iterations (default 'no'); requires the Jacobian to "
+		      "be provided by the 'eval_Jac_cons' that evaluates subsets of constraints");
+  }
   {
     vector<string> range(2); range[0]="no"; range[1]="yes";
+    registerStrOption("hess_eval_async", range[0], range,
+		      "evaluate the Hessian of the Lagrangian on a separate thread while HiOp updates the "
+		      "residuals and the errors at the new iterate (default 'no'); used only by the Newton "
+		      "filter IPM; on multiple MPI ranks, MPI needs to be initialized with "
+		      "MPI_THREAD_MULTIPLE");
+  }
+  registerIntOption("linesearch_batch", 1, 1, 16,
+		    "number of line-search trial points (step lengths alpha, alpha/2, alpha/4, ...) evaluated "
+		    "concurrently (default 1, i.e., sequential backtracking); used only when the interface "
+		    "declares thread-safe 'eval_f' and 'eval_cons' and HiOp runs on one MPI rank");
+
+  //other options
+  {
+    vector<string> range(3); range[0]="no"; range[1]="yes"; range[2]="binary";
     registerStrOption("write_kkt", range[0], range, 
-		      "write internal KKT linear system (matrix, rhs, sol) to file (default 'no')");
+		      "write internal KKT linear system (matrix, rhs, sol) to file: 'yes' writes one "
+		      "text file per system, 'binary' captures the systems, together with the "
+		      "perturbations and the inertia, in the file given by 'write_kkt_file'; only the "
+		      "Newton linear systems (XYcYd, XDYcYd, and the reduced system of MDS problems) "
+		      "are written, the quasi-Newton (low-rank) ones are not (default 'no')");
+    registerStrOption("write_kkt_file", "kkt_capture.hkkt",
+		      "name of the file of the KKT systems captured with 'write_kkt binary'; solves "
+		      "running concurrently in one process should use different names "
+		      "(default 'kkt_capture.hkkt')");
+  }
+  {
+    vector<string> range(3); range[0]="no"; range[1]="jsonl"; range[2]="csv";
+    registerStrOption("trace_iter", range[0], range,
+		      "write one record per iteration (mu, step sizes, line-search trials, inertia "
+		      "corrections, KKT and evaluation times, evaluation counts, and KKT size) in "
+		      "JSON Lines format or as CSV to the file given by 'trace_iter_file' followed by "
+		      "'.jsonl' or '.csv' (default 'no')");
+    registerStrOption("trace_iter_file", "hiop_trace",
+		      "name, without the extension, of the file of the iterations trace; solves "
+		      "running concurrently in one process should use different names "
+		      "(default 'hiop_trace')");
   }
 }
 
@@ -274,6 +392,12 @@ void hiopOptions::registerNumOption(const std::string& name, double defaultValue
   mOptions[name]=new _ONum(defaultValue, low, upp, description);
 }
 
+void hiopOptions::registerStrOption(const std::string& name, const std::string& defaultValue, 
+				    const char* description)
+{
+  registerStrOption(name, defaultValue, std::vector<std::string>(), description);
+}
+
 void hiopOptions::registerStrOption(const std::string& name, const std::string& defaultValue, 
 				    const std::vector<std::string>& range, const char* description)
 {
@@ -317,6 +441,12 @@ void hiopOptions::ensureConsistence()
     SetStringValue("compute_mode", "cpu");
   }
 #endif
+
+  //the logger caches the verbosity level so that it does not look it up for each message
+  if(log) {
+    log->set_verbosity(GetInteger("verbosity_level"));
+    log->set_output_mode(GetString("log_output"));
+  }
 }
 
 static inline std::string &ltrim(std::string &s) {
@@ -337,6 +467,8 @@ void hiopOptions::loadFromFile(const char* filename)
     log_printf(hovError, "Option file name not valid"); 
     return;
   }
+  //empty name: no options file is to be read
+  if('\0'==filename[0]) return;
 
   ifstream input( filename );
 
@@ -507,6 +639,13 @@ bool hiopOptions::SetStringValue (const char* name,  const char* value, const bo
       if(setFromFile)
 	option->specifiedInFile=true;
 
+      //options without a range take any value
+      if(option->range.empty()) {
+	option->val = value;
+	ensureConsistence();
+	return true;
+      }
+
       string strValue(value);
       transform(strValue.begin(), strValue.end(), strValue.begin(), ::tolower);
       //see if it is in the range (of supported values)
@@ -536,11 +675,11 @@ void hiopOptions::log_printf(hiopOutVerbosity v, const char* format, ...)
   char buff[1024];
   va_list args;
   va_start (args, format);
-  vsprintf (buff,format, args);
+  vsnprintf (buff, sizeof(buff), format, args);
   if(log)
-    log->printf(v,buff);
+    log->printf(v, "%s", buff);
   else
-    hiopLogger::printf_error(v,buff);
+    hiopLogger::printf_error(v, "%s", buff);
   //fprintf(stderr,buff);
   va_end (args);
 }
@@ -570,6 +709,10 @@ void hiopOptions::_OInt::print(FILE* f) const
 
 void hiopOptions::_OStr::print(FILE* f) const
 {
+  if(range.empty()) {
+    fprintf(f, "%s \t# (string) [%s]", val.c_str(), descr.c_str());
+    return;
+  }
   stringstream ssRange; ssRange << " ";
   for(int i=0; i<range.size(); i++) ssRange << range[i] << " ";
   fprintf(f, "%s \t# (string) one of [%s] [%s]", val.c_str(), ssRange.str().c_str(), descr.c_str());
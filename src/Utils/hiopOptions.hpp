@@ -54,6 +54,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cassert>
 
 namespace hiop
 {
@@ -62,6 +63,7 @@ class hiopLogger;
 class hiopOptions
 {
 public:
+  //reads the options from 'szOptionsFilename' ('hiop.options' if NULL, no file if empty)
   hiopOptions(const char* szOptionsFilename=NULL);
   virtual ~hiopOptions();
 
@@ -80,6 +82,27 @@ public:
   virtual int         GetInteger(const char* name) const;
   virtual std::string GetString (const char* name) const;
 
+  /* Typed handle to the value of a registered option. The handle is resolved by name once and
+   * then reading the option is a plain memory access, without the lookup in the options map;
+   * use it for options that are read in the optimization loop (the numeric and integer options 
+   * are read once, when the solver is set up). The handle reflects subsequent changes of the 
+   * option's value and is valid as long as the hiopOptions object is alive.
+   */
+  template<typename T> class Handle
+  {
+  public:
+    Handle() : val_(NULL) {}
+    inline const T& operator*() const { assert(val_!=NULL); return *val_; }
+    inline const T* operator->() const { assert(val_!=NULL); return val_; }
+    inline bool is_valid() const { return val_!=NULL; }
+  private:
+    friend class hiopOptions;
+    explicit Handle(const T* val) : val_(val) {}
+    const T* val_;
+  };
+
+  Handle<std::string> GetStringHandle(const char* name) const;
+
   void SetLog(hiopLogger* log_) { log=log_; ensureConsistence(); }
   virtual void print(FILE* file, const char* msg=NULL) const;
 protected:
@@ -89,6 +112,8 @@ protected:
   void registerIntOption(const std::string& name, int    defaultValue, int    rangeLo, int    rangeUp, const char* description);
   //void registerBooOption(const std::string& name, bool defaultValue);
   void registerStrOption(const std::string& name, const std::string& defaultValue, const std::vector<std::string>& range, const char* description);
+  //string option taking any value, e.g., a file name; the value is not converted to lower case
+  void registerStrOption(const std::string& name, const std::string& defaultValue, const char* description);
   void registerOptions();
 
   //sets the (name, value) pair accordingly to the type registered in mOptions, or prints an warning message and leaves
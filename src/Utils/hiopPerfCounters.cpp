@@ -0,0 +1,132 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#include "hiopPerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdint>
+#endif
+
+namespace hiop
+{
+
+hiopPerfCounters& hiopPerfCounters::thread_counters()
+{
+  static thread_local hiopPerfCounters counters;
+  return counters;
+}
+
+hiopPerfCounters::hiopPerfCounters()
+  : opened_(false), available_(false)
+{
+  for(int i=0; i<hiopPerfCounts::nCounters; i++) fd_[i] = -1;
+}
+
+hiopPerfCounters::~hiopPerfCounters()
+{
+#ifdef __linux__
+  for(int i=0; i<hiopPerfCounts::nCounters; i++) if(fd_[i]>=0) close(fd_[i]);
+#endif
+}
+
+bool hiopPerfCounters::open()
+{
+  if(opened_) return available_;
+  opened_ = true;
+#ifdef __linux__
+  const unsigned long long configs[hiopPerfCounts::nCounters] = 
+    { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, 
+      PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES };
+
+  available_ = true;
+  for(int i=0; i<hiopPerfCounts::nCounters && available_; i++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = configs[i];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    //no inheritance: counts of child threads would only be added when they exit, so the OpenMP
+    //threads of a BLAS library, which stay alive, would be missed anyway
+    attr.inherit = 0;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    //calling thread, any cpu, no group
+    fd_[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if(fd_[i]<0) available_ = false;
+  }
+  if(!available_) {
+    for(int i=0; i<hiopPerfCounts::nCounters; i++) {
+      if(fd_[i]>=0) close(fd_[i]);
+      fd_[i] = -1;
+    }
+  }
+#endif
+  return available_;
+}
+
+void hiopPerfCounters::read(hiopPerfCounts& c) const
+{
+  c.set_zero();
+  if(!available_) return;
+#ifdef __linux__
+  for(int i=0; i<hiopPerfCounts::nCounters; i++) {
+    //value, time enabled, time running
+    uint64_t vals[3];
+    if(sizeof(vals) != ::read(fd_[i], vals, sizeof(vals))) continue;
+    c.v[i] = vals[2]>0 ? (double)vals[0] * ((double)vals[1]/vals[2]) : 0.;
+  }
+#endif
+}
+
+} //end namespace
@@ -0,0 +1,148 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+
+#ifndef HIOP_PERF_COUNTERS
+#define HIOP_PERF_COUNTERS
+
+#include "hiopTimer.hpp"
+
+namespace hiop
+{
+
+/* Values of the hardware counters read by hiopPerfCounters */
+struct hiopPerfCounts
+{
+  enum { nCounters=4 };
+  //cycles, instructions, last level cache references, last level cache misses
+  double v[nCounters];
+
+  hiopPerfCounts() { set_zero(); }
+  inline void set_zero() { for(int i=0; i<nCounters; i++) v[i]=0.; }
+  inline double cycles() const { return v[0]; }
+  inline double instructions() const { return v[1]; }
+  inline double cache_refs() const { return v[2]; }
+  inline double cache_misses() const { return v[3]; }
+  //this += a - b
+  inline void add_diff(const hiopPerfCounts& a, const hiopPerfCounts& b) 
+  {
+    for(int i=0; i<nCounters; i++) v[i] += a.v[i] - b.v[i];
+  }
+  inline void add(const hiopPerfCounts& a) { for(int i=0; i<nCounters; i++) v[i] += a.v[i]; }
+};
+
+/* Hardware performance counters of the calling thread, read via Linux's perf_event_open.
+ *
+ * The counters measure the user-space cycles, instructions, and last level cache references and
+ * misses of the calling thread only; the work done by other threads (for example, the OpenMP 
+ * threads of a multithreaded BLAS library) is not counted. No library is needed; the counters are
+ * unavailable on systems other than Linux and when the kernel does not allow them (see 
+ * /proc/sys/kernel/perf_event_paranoid), in which case open() returns false and reads return zeros.
+ */
+class hiopPerfCounters
+{
+public:
+  //the counters of the calling thread
+  static hiopPerfCounters& thread_counters();
+
+  ~hiopPerfCounters();
+
+  //opens the counters, if not already open; returns false if the counters are not available
+  bool open();
+  inline bool is_available() const { return available_; }
+
+  //reads the current values of the counters (scaled to account for multiplexing)
+  void read(hiopPerfCounts& c) const;
+private:
+  int fd_[hiopPerfCounts::nCounters];
+  bool opened_;
+  bool available_;
+
+  hiopPerfCounters();
+  hiopPerfCounters(const hiopPerfCounters&);
+  hiopPerfCounters& operator=(const hiopPerfCounters&);
+};
+
+/* Timer that also accumulates the hardware counters of the calling thread between start() and
+ * stop() when counting is turned on. The counters are only read by the start/stop of this 
+ * class, not when the timer is used via a hiopTimer reference.
+ */
+class hiopPhaseTimer : public hiopTimer
+{
+public:
+  hiopPhaseTimer() : counting_(false) {}
+
+  inline void set_counting(bool on) { counting_ = on; }
+
+  inline void start()
+  {
+    if(counting_) hiopPerfCounters::thread_counters().read(counts_start_);
+    hiopTimer::start();
+  }
+  inline void stop()
+  {
+    hiopTimer::stop();
+    if(counting_) {
+      hiopPerfCounts now;
+      hiopPerfCounters::thread_counters().read(now);
+      counts_.add_diff(now, counts_start_);
+    }
+  }
+  inline void reset()
+  {
+    hiopTimer::reset();
+    counts_.set_zero();
+  }
+  inline const hiopPerfCounts& get_counts() const { return counts_; }
+private:
+  bool counting_;
+  hiopPerfCounts counts_, counts_start_;
+};
+
+} //end namespace
+#endif
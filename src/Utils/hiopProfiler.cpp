@@ -0,0 +1,189 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#include "hiopProfiler.hpp"
+
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+
+namespace hiop
+{
+
+hiopProfiler::hiopProfiler()
+  : curr_(0), enabled_(false), nesting_errors_(0)
+{
+  reset(false);
+}
+
+void hiopProfiler::reset(bool enable)
+{
+  nodes_.clear();
+  Node root;
+  root.name = "total";
+  root.parent = -1;
+  root.calls = 0;
+  root.tm_incl = 0.;
+  root.tm_start = clock::now();
+  root.active = true;
+  nodes_.push_back(root);
+
+  curr_ = 0;
+  nesting_errors_ = 0;
+  enabled_ = enable;
+  owner_ = std::this_thread::get_id();
+}
+
+int hiopProfiler::enter(const char* name)
+{
+  if(std::this_thread::get_id() != owner_) return -1;
+
+  //look up the region among the children of the current region; the names are usually string
+  //literals, so the pointers are compared first
+  int id = -1;
+  const std::vector<int>& children = nodes_[curr_].children;
+  for(size_t i=0; i<children.size(); ++i) {
+    const char* child_name = nodes_[children[i]].name;
+    if(child_name==name || 0==strcmp(child_name, name)) { 
+      id = children[i]; 
+      break; 
+    }
+  }
+  if(id<0) {
+    Node node;
+    node.name = name;
+    node.parent = curr_;
+    node.calls = 0;
+    node.tm_incl = 0.;
+    node.active = false;
+    id = (int) nodes_.size();
+    nodes_.push_back(node);
+    nodes_[curr_].children.push_back(id);
+  }
+  Node& node = nodes_[id];
+  node.calls++;
+  node.active = true;
+  curr_ = id;
+  node.tm_start = clock::now();
+  return id;
+}
+
+void hiopProfiler::leave(int id)
+{
+  if(id<0) return; //region was entered by a different thread or before a reset
+  const clock::time_point now = clock::now();
+  if(id>=(int)nodes_.size() || !nodes_[id].active) return;
+
+  if(id!=curr_) {
+    //should not happen with scoped regions; close the regions entered after 'id'
+    nesting_errors_++;
+    while(curr_!=id && curr_>0) {
+      nodes_[curr_].tm_incl += std::chrono::duration<double>(now-nodes_[curr_].tm_start).count();
+      nodes_[curr_].active = false;
+      curr_ = nodes_[curr_].parent;
+    }
+  }
+  Node& node = nodes_[id];
+  node.tm_incl += std::chrono::duration<double>(now-node.tm_start).count();
+  node.active = false;
+  curr_ = node.parent;
+}
+
+double hiopProfiler::node_incl_time(int id, const clock::time_point& now) const
+{
+  const Node& node = nodes_[id];
+  if(0==id) {
+    //the root is timed by its children
+    double tm=0.;
+    for(size_t i=0; i<node.children.size(); ++i) tm += node_incl_time(node.children[i], now);
+    return tm;
+  }
+  double tm = node.tm_incl;
+  if(node.active) tm += std::chrono::duration<double>(now-node.tm_start).count();
+  return tm;
+}
+
+void hiopProfiler::report_node(int id, int depth, double tm_total, std::string& out) const
+{
+  const clock::time_point now = clock::now();
+  const Node& node = nodes_[id];
+  double tm_incl = node_incl_time(id, now), tm_excl = tm_incl;
+  for(size_t i=0; i<node.children.size(); ++i) 
+    tm_excl -= node_incl_time(node.children[i], now);
+  if(tm_excl<0.) tm_excl=0.;
+
+  char buff[256];
+  std::string name(2*depth, ' ');
+  name += node.name;
+  snprintf(buff, 256, "%-40s %10lld %12.4f %12.4f %7.2f\n", 
+	   name.c_str(), node.calls, tm_incl, tm_excl, tm_total>0 ? 100.*tm_incl/tm_total : 0.);
+  out += buff;
+
+  for(size_t i=0; i<node.children.size(); ++i) 
+    report_node(node.children[i], depth+1, tm_total, out);
+}
+
+std::string hiopProfiler::get_report() const
+{
+  std::string out;
+  if(!enabled_) return out;
+  char buff[256];
+  snprintf(buff, 256, "%-40s %10s %12s %12s %7s\n", "Region", "calls", "incl (sec)", "excl (sec)", "incl %");
+  out += buff;
+
+  const double tm_total = node_incl_time(0, clock::now());
+  for(size_t i=0; i<nodes_[0].children.size(); ++i) 
+    report_node(nodes_[0].children[i], 0, tm_total, out);
+  if(nesting_errors_>0) {
+    snprintf(buff, 256, "warning: %d regions were not properly nested\n", nesting_errors_);
+    out += buff;
+  }
+  return out;
+}
+
+} //end namespace
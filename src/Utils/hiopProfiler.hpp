@@ -0,0 +1,147 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory (LLNL).
+// Written by Cosmin G. Petra, petra1@llnl.gov.
+// LLNL-CODE-742473. All rights reserved.
+//
+// This file is part of HiOp. For details, see https://github.com/LLNL/hiop. HiOp 
+// is released under the BSD 3-clause license (https://opensource.org/licenses/BSD-3-Clause). 
+// Please also read “Additional BSD Notice” below.
+//
+// Redistribution and use in source and binary forms, with or without modification, 
+// are permitted provided that the following conditions are met:
+// i. Redistributions of source code must retain the above copyright notice, this list 
+// of conditions and the disclaimer below.
+// ii. Redistributions in binary form must reproduce the above copyright notice, 
+// this list of conditions and the disclaimer (as noted below) in the documentation and/or 
+// other materials provided with the distribution.
+// iii. Neither the name of the LLNS/LLNL nor the names of its contributors may be used to 
+// endorse or promote products derived from this software without specific prior written 
+// permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY 
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES 
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT 
+// SHALL LAWRENCE LIVERMORE NATIONAL SECURITY, LLC, THE U.S. DEPARTMENT OF ENERGY OR 
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS 
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+// AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, 
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Additional BSD Notice
+// 1. This notice is required to be provided under our contract with the U.S. Department 
+// of Energy (DOE). This work was produced at Lawrence Livermore National Laboratory under 
+// Contract No. DE-AC52-07NA27344 with the DOE.
+// 2. Neither the United States Government nor Lawrence Livermore National Security, LLC 
+// nor any of their employees, makes any warranty, express or implied, or assumes any 
+// liability or responsibility for the accuracy, completeness, or usefulness of any 
+// information, apparatus, product, or process disclosed, or represents that its use would
+// not infringe privately-owned rights.
+// 3. Also, reference herein to any specific commercial products, process, or services by 
+// trade name, trademark, manufacturer or otherwise does not necessarily constitute or 
+// imply its endorsement, recommendation, or favoring by the United States Government or 
+// Lawrence Livermore National Security, LLC. The views and opinions of authors expressed 
+// herein do not necessarily state or reflect those of the United States Government or 
+// Lawrence Livermore National Security, LLC, and shall not be used for advertising or 
+// product endorsement purposes.
+
+#ifndef HIOP_PROFILER
+#define HIOP_PROFILER
+
+#include "hiopTimer.hpp"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+
+namespace hiop
+{
+
+/* Hierarchical profiler of (named) code regions.
+ *
+ * Regions are entered and left via the scoped (RAII) hiopProfRegion objects below, so nesting is
+ * enforced by the C++ scoping. Each region is a node in a call tree: the same name entered under 
+ * different parent regions gives different nodes. For each node the profiler keeps the number 
+ * of calls and the inclusive time; the exclusive time is the inclusive time minus the inclusive 
+ * times of the children. Times are measured with std::chrono::steady_clock (monotonic).
+ *
+ * When the profiler is disabled (default), entering a region costs one branch. Only the thread
+ * that enabled the profiler records regions; regions entered by other threads (for example, the
+ * asynchronous evaluations) are ignored by the profiler.
+ */
+class hiopProfiler
+{
+public:
+  hiopProfiler();
+
+  //enables/disables the profiler; also removes all the regions recorded so far
+  void reset(bool enable);
+  inline bool is_enabled() const { return enabled_; }
+
+  //enters region 'name' as a child of the current region; returns the id of the region. 'name'
+  //is expected to be a string literal (or to outlive the profiler)
+  int enter(const char* name);
+  //leaves region 'id', which should be the current region
+  void leave(int id);
+
+  //returns a tree report of the regions; the regions that are not left yet are timed up to now
+  std::string get_report() const;
+private:
+  typedef std::chrono::steady_clock clock;
+  struct Node
+  {
+    const char* name;
+    int parent;
+    std::vector<int> children;
+    long long calls;
+    double tm_incl; //in seconds
+    clock::time_point tm_start;
+    bool active;
+  };
+  std::vector<Node> nodes_;
+  //current region; node 0 is the (artificial) root of the tree
+  int curr_;
+  bool enabled_;
+  std::thread::id owner_;
+  //number of regions left in a different order than they were entered
+  int nesting_errors_;
+
+  void report_node(int id, int depth, double tm_total, std::string& out) const;
+  double node_incl_time(int id, const clock::time_point& now) const;
+};
+
+/* Scoped region: enters the region on construction and leaves it on destruction. The second 
+ * constructor also starts/stops a hiopTimer of hiopRunStats, replacing the start()/stop() pairs.
+ */
+class hiopProfRegion
+{
+public:
+  hiopProfRegion(hiopProfiler& prof, const char* name)
+    : prof_(prof.is_enabled() ? &prof : NULL), id_(-1), timer_(NULL)
+  {
+    if(prof_) id_ = prof_->enter(name);
+  }
+  hiopProfRegion(hiopProfiler& prof, const char* name, hiopTimer& timer)
+    : prof_(prof.is_enabled() ? &prof : NULL), id_(-1), timer_(&timer)
+  {
+    timer_->start();
+    if(prof_) id_ = prof_->enter(name);
+  }
+  ~hiopProfRegion()
+  {
+    if(prof_) prof_->leave(id_);
+    if(timer_) timer_->stop();
+  }
+private:
+  hiopProfiler* prof_;
+  int id_;
+  hiopTimer* timer_;
+
+  hiopProfRegion(const hiopProfRegion&);
+  hiopProfRegion& operator=(const hiopProfRegion&);
+};
+
+} //end namespace
+#endif
@@ -50,10 +50,15 @@
 #define HIOP_RUNSTATS
 
 #include "hiopTimer.hpp"
+#include "hiopProfiler.hpp"
+#include "hiopCommProfiler.hpp"
+#include "hiopPerfCounters.hpp"
+#include "hiopMemTracker.hpp"
 
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstdio>
 
 #ifdef HIOP_USE_MPI
 #include "mpi.h"  
@@ -66,6 +71,7 @@ class hiopRunKKTSolStats
 {
 public:
   hiopRunKKTSolStats()
+    : hw_counters_on_(false)
   { 
     initialize();
   };
@@ -80,20 +86,23 @@ public:
 
   hiopTimer tmTotalPerIter;
 
+  // The timers of the phases below also accumulate the hardware counters when these are enabled
+  // by 'enable_hw_counters' (option 'time_kkt_counters')
+
   // time of the initial boilerplate, before any expensive matrix update or factorization
-  hiopTimer tmUpdateInit;
+  hiopPhaseTimer tmUpdateInit;
   // time in the update of the linsys to be sent to lower level linear solver; multiple updates can happen
   // if the inertia correction kicks in
-  hiopTimer tmUpdateLinsys;
+  hiopPhaseTimer tmUpdateLinsys;
   // time spent in lower level factorizations; can time multiple factorizations if the inertia correction kicks in 
-  hiopTimer tmUpdateInnerFact;
+  hiopPhaseTimer tmUpdateInnerFact;
   // number of inertia corrections
   int nUpdateICCorr;
 
   // time spent in compressing or decompressing rhs (or in other words, pre- and post-triangular solve)
-  hiopTimer tmSolveRhsManip;
+  hiopPhaseTimer tmSolveRhsManip;
   // the actual triangular solve within the inner solver
-  hiopTimer tmSolveTriangular;
+  hiopPhaseTimer tmSolveTriangular;
 
   // total time 
   double tmTotal;
@@ -101,6 +110,15 @@ public:
   double tmTotalUpdateInit, tmTotalUpdateLinsys, tmTotalUpdateInnerFact;
   double tmTotalSolveRhsManip, tmTotalSolveTriangular; 
 
+  // floating point operations of the factorizations and of the triangular solves, as estimated 
+  // by the KKT linear systems (at each optimization iteration and total)
+  double flopsUpdateInnerFact, flopsSolveTriangular;
+  double flopsTotalUpdateInnerFact, flopsTotalSolveTriangular;
+
+  // hardware counters of the phases over all the optimization iterations
+  hiopPerfCounts cntTotalUpdateInit, cntTotalUpdateLinsys, cntTotalUpdateInnerFact;
+  hiopPerfCounts cntTotalSolveRhsManip, cntTotalSolveTriangular;
+
   inline void initialize() {
     tmTotalPerIter.reset();
     tmUpdateInit.reset();
@@ -116,6 +134,27 @@ public:
     tmTotalUpdateInnerFact = 0;
     tmTotalSolveRhsManip = 0; 
     tmTotalSolveTriangular = 0;
+
+    flopsUpdateInnerFact = flopsSolveTriangular = 0.;
+    flopsTotalUpdateInnerFact = flopsTotalSolveTriangular = 0.;
+    cntTotalUpdateInit.set_zero();
+    cntTotalUpdateLinsys.set_zero();
+    cntTotalUpdateInnerFact.set_zero();
+    cntTotalSolveRhsManip.set_zero();
+    cntTotalSolveTriangular.set_zero();
+  }
+
+  // turns on/off the hardware counters of the phases; returns false if these were requested but
+  // are not available, in which case they stay off
+  inline bool enable_hw_counters(bool on)
+  {
+    hw_counters_on_ = on && hiopPerfCounters::thread_counters().open();
+    tmUpdateInit.set_counting(hw_counters_on_);
+    tmUpdateLinsys.set_counting(hw_counters_on_);
+    tmUpdateInnerFact.set_counting(hw_counters_on_);
+    tmSolveRhsManip.set_counting(hw_counters_on_);
+    tmSolveTriangular.set_counting(hw_counters_on_);
+    return hw_counters_on_ == on;
   }
 
   inline void start_optimiz_iteration()
@@ -129,6 +168,7 @@ public:
     nUpdateICCorr = 0;
     tmSolveRhsManip.reset();
     tmSolveTriangular.reset();
+    flopsUpdateInnerFact = flopsSolveTriangular = 0.;
   } 
   inline void end_optimiz_iteration()
   {
@@ -140,7 +180,16 @@ public:
     tmTotalUpdateInnerFact += tmUpdateInnerFact.getElapsedTime();
     tmTotalSolveRhsManip += tmSolveRhsManip.getElapsedTime(); 
     tmTotalSolveTriangular += tmSolveTriangular.getElapsedTime();
-    
+
+    flopsTotalUpdateInnerFact += flopsUpdateInnerFact;
+    flopsTotalSolveTriangular += flopsSolveTriangular;
+    if(hw_counters_on_) {
+      cntTotalUpdateInit.add(tmUpdateInit.get_counts());
+      cntTotalUpdateLinsys.add(tmUpdateLinsys.get_counts());
+      cntTotalUpdateInnerFact.add(tmUpdateInnerFact.get_counts());
+      cntTotalSolveRhsManip.add(tmSolveRhsManip.get_counts());
+      cntTotalSolveTriangular.add(tmSolveTriangular.get_counts());
+    }
   }
   inline std::string get_summary_last_iter() {
     std::stringstream ss;
@@ -171,8 +220,39 @@ public:
     ss << "\tsolve rhs-manip " <<tmTotalSolveRhsManip << " sec "
        << "    triangular solve " << tmTotalSolveTriangular << " sec " << std::endl; 
 
+    if(hw_counters_on_) {
+      ss << "\thardware counters of the calling thread only (GB/s estimated from the last level "
+	 << "cache misses)" << std::endl;
+      ss << get_counters_line("update init", cntTotalUpdateInit, tmTotalUpdateInit, 0.);
+      ss << get_counters_line("update linsys", cntTotalUpdateLinsys, tmTotalUpdateLinsys, 0.);
+      ss << get_counters_line("fact", cntTotalUpdateInnerFact, tmTotalUpdateInnerFact, 
+			      flopsTotalUpdateInnerFact);
+      ss << get_counters_line("rhs-manip", cntTotalSolveRhsManip, tmTotalSolveRhsManip, 0.);
+      ss << get_counters_line("triangular solve", cntTotalSolveTriangular, tmTotalSolveTriangular,
+			      flopsTotalSolveTriangular);
+    }
     return ss.str();
   }
+private:
+  bool hw_counters_on_;
+
+  static inline std::string get_counters_line(const char* phase, const hiopPerfCounts& c, 
+					      double tm, double flops)
+  {
+    char buf[256];
+    const double cache_line_bytes = 64.;
+    snprintf(buf, sizeof(buf), "\t  %-16s cycles %10.3e  instr %10.3e  IPC %5.2f  LLC refs %10.3e"
+	     "  misses %10.3e (%5.1f%%)  %7.2f GB/s", phase, c.cycles(), c.instructions(),
+	     c.cycles()>0 ? c.instructions()/c.cycles() : 0., c.cache_refs(), c.cache_misses(),
+	     c.cache_refs()>0 ? 100.*c.cache_misses()/c.cache_refs() : 0.,
+	     tm>0 ? c.cache_misses()*cache_line_bytes/tm/1e9 : 0.);
+    std::string line(buf);
+    if(flops>0 && tm>0) {
+      snprintf(buf, sizeof(buf), "  %8.2f GFLOP/s", flops/tm/1e9);
+      line += buf;
+    }
+    return line + "\n";
+  }
 };
 
 
@@ -245,17 +325,27 @@ public:
   hiopTimer tmEvalObj, tmEvalGrad_f, tmEvalCons, tmEvalJac_con, tmEvalHessL;
   int nEvalObj, nEvalGrad_f, nEvalCons_eq, nEvalCons_ineq, nEvalJac_con_eq, nEvalJac_con_ineq;
   int nEvalHessL;
+
+  //lsq updates of the duals (timed by tmMultUpdate): number of updates, of factorizations of 
+  //J*J^T, and of (P)CG iterations (see option 'duals_lsq_solve')
+  int nDualsLsq, nDualsLsqFact, nDualsLsqCGIter;
   
   int nIter;
 
   hiopRunKKTSolStats kkt;
   hiopLinSolStats linsolv;
+
+  //hierarchical profiler of scoped regions (see hiopProfRegion); enabled by option 'time_regions'
+  hiopProfiler prof;
+
   inline virtual void initialize() {
     tmOptimizTotal = tmSolverInternal = tmSearchDir = tmStartingPoint = tmMultUpdate = tmComm = tmInit = 0.;
     tmEvalObj = tmEvalGrad_f = tmEvalCons = tmEvalJac_con = tmEvalHessL = 0.;    
     nEvalObj = nEvalGrad_f = nEvalCons_eq = nEvalCons_ineq =  nEvalJac_con_eq = nEvalJac_con_ineq = 0;
     nEvalHessL = 0;
+    nDualsLsq = nDualsLsqFact = nDualsLsqCGIter = 0;
     nIter = 0; 
+    prof.reset(prof.is_enabled());
   }
 
   inline std::string get_summary(int masterRank=0) {
@@ -317,6 +407,26 @@ public:
        << " eq cons " << nEvalCons_eq << " ineq cons " << nEvalCons_ineq 
        << " eq Jac " << nEvalJac_con_eq << " ineq Jac " << nEvalJac_con_ineq << std::endl;
 
+    if(nDualsLsq>0) {
+      ss << "Duals lsq update: " << nDualsLsq << " updates  " << nDualsLsqFact << " factorizations  "
+	 << nDualsLsqCGIter << " CG iterations  time " << std::setprecision(3)
+	 << tmMultUpdate.getElapsedTime() << " sec" << std::endl;
+    }
+
+    const hiopMemTracker& mem = hiopMemTracker::global();
+    ss << mem.get_report();
+#ifdef HIOP_USE_MPI
+    long long peak_loc = mem.get_peak(), peak_max;
+    ierr = MPI_Allreduce(&peak_loc, &peak_max, 1, MPI_LONG_LONG, MPI_MAX, comm); 
+    assert(MPI_SUCCESS==ierr);
+    ss << "    peak max across ranks " << std::setprecision(3) << peak_max/1024./1024. << " MB" 
+       << std::endl;
+#endif
+
+    //the communication profiler is thread_local (see hiopCommProfiler) and enabled by option 'time_comm'
+    const hiopCommProfiler& comm_prof = hiopCommProfiler::global();
+    if(comm_prof.is_enabled()) ss << comm_prof.get_report(comm, tmOptimizTotal.getElapsedTime());
+
     return ss.str();
   }
 private:
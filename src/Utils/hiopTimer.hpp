@@ -52,7 +52,7 @@
 #ifdef HIOP_USE_MPI
 #include "mpi.h"
 #else
-#include <sys/time.h>
+#include <chrono>
 #endif
 
 #include <cassert>
@@ -75,8 +75,8 @@ public:
 #ifdef HIOP_USE_MPI 
     tmStart = MPI_Wtime();
 #else
-    gettimeofday(&tv, NULL);
-    tmStart = ( static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec)/1000000.0 );
+    //monotonic clock; gettimeofday may jump when the system time is adjusted
+    tmStart = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
 #endif
   }
 
@@ -85,8 +85,8 @@ public:
 #ifdef HIOP_USE_MPI
     tmElapsed += ( MPI_Wtime()-tmStart );
 #else
-    gettimeofday(&tv, NULL);
-    tmElapsed += ( static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec)/1000000.0  - tmStart );
+    tmElapsed += ( std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count() 
+		   - tmStart );
 #endif
   }
 
@@ -102,11 +102,6 @@ public:
 private:
   double tmElapsed; //in seconds
   double tmStart;
-
-#ifdef HIOP_USE_MPI
-#else
-  struct timeval tv;
-#endif
 };
 }
 #endif
@@ -0,0 +1,33 @@
+# Runs a driver in the directories DIR_A and DIR_B (each holding a 'hiop.options' file) and fails
+# if the two solves do not take the same number of iterations or if their objectives, as printed
+# in the iteration lines of the log, differ.
+#
+# Usage: cmake -DDIR_A=<dir> -DDIR_B=<dir> -DCMD="<driver> <arg1> ..." -P compare_iterates.cmake
+
+separate_arguments(cmd UNIX_COMMAND "${CMD}")
+
+function(get_objectives dir out_var)
+  execute_process(COMMAND ${cmd} WORKING_DIRECTORY ${dir}
+    RESULT_VARIABLE ret OUTPUT_VARIABLE out ERROR_VARIABLE out)
+  if(NOT ret EQUAL 0)
+    message(FATAL_ERROR "run in ${dir} failed (${ret}):\n${out}")
+  endif()
+  # the iteration lines start with the iteration number followed by the objective
+  string(REGEX MATCHALL "\n *[0-9]+ +[-+0-9.e]+ " lines "${out}")
+  set(${out_var} "${lines}" PARENT_SCOPE)
+endfunction()
+
+get_objectives(${DIR_A} obj_a)
+get_objectives(${DIR_B} obj_b)
+list(LENGTH obj_a n_a)
+list(LENGTH obj_b n_b)
+if(n_a EQUAL 0)
+  message(FATAL_ERROR "no iteration lines found in the output of the run in ${DIR_A}")
+endif()
+if(NOT n_a EQUAL n_b)
+  message(FATAL_ERROR "${n_a} iteration lines in ${DIR_A}, ${n_b} in ${DIR_B}")
+endif()
+if(NOT "${obj_a}" STREQUAL "${obj_b}")
+  message(FATAL_ERROR "the objectives differ:\n${DIR_A}:${obj_a}\n${DIR_B}:${obj_b}")
+endif()
+message(STATUS "${n_a} iteration lines with the same objectives")